@@ -26,20 +26,257 @@
 
 #include "Adafruit_BQ25798.h"
 
+#if defined(ESP32) || defined(ESP8266)
+#define BQ25798_ISR_ATTR IRAM_ATTR ///< ISRs must live in IRAM on ESP chips
+#else
+#define BQ25798_ISR_ATTR ///< No special placement needed for ISRs
+#endif
+
+Adafruit_BQ25798* Adafruit_BQ25798::irq_instance = NULL;
+
+/*!
+ * @brief Location and scaling of one register field
+ */
+typedef struct {
+  uint8_t reg;     ///< Register address (MSB for 16-bit registers)
+  uint8_t layout;  ///< Register width, field size and shift, packed
+  uint8_t lsb;     ///< Units per code
+  uint16_t offset; ///< Units at code 0
+  uint16_t min;    ///< Smallest value accepted by setField()
+  uint16_t max;    ///< Largest value accepted by setField()
+} bq25798_field_desc_t;
+
+/*!
+ * @brief Pack register width (bytes), field size (bits) and shift into a byte
+ */
+#define BQ25798_LAYOUT(width, bits, shift) \
+  ((((width)-1) << 7) | (((bits)-1) << 3) | (shift))
+
+/*!
+ * @brief Build a descriptor: register, width in bytes, field size in bits,
+ * shift, units per code, units at code 0, and the setField() limits
+ */
+#define BQ25798_FIELD(reg, width, bits, shift, lsb, offset, min, max) \
+  {reg, BQ25798_LAYOUT(width, bits, shift), lsb, offset, min, max}
+
+/*!
+ * @brief Field descriptors, indexed by bq25798_field_t. Enumerated fields
+ * accept every code the field can hold, so their limits are the full range.
+ */
+static const bq25798_field_desc_t field_table[] PROGMEM = {
+    BQ25798_FIELD(0x00, 1, 6, 0, 250, 2500, 2500, 16000), // VSYSMIN
+    BQ25798_FIELD(0x01, 2, 11, 0, 10, 0, 3000, 18800),    // VREG
+    BQ25798_FIELD(0x03, 2, 9, 0, 10, 0, 50, 5000),        // ICHG
+    BQ25798_FIELD(0x05, 1, 8, 0, 100, 0, 3600, 22000),    // VINDPM
+    BQ25798_FIELD(0x06, 2, 9, 0, 10, 0, 100, 3300),       // IINDPM
+    BQ25798_FIELD(0x08, 1, 2, 6, 1, 0, 0, 3),             // VBAT_LOWV
+    BQ25798_FIELD(0x08, 1, 6, 0, 40, 0, 40, 2000),        // IPRECHG
+    BQ25798_FIELD(0x09, 1, 1, 6, 1, 0, 0, 1),             // REG_RST
+    BQ25798_FIELD(0x09, 1, 1, 5, 1, 0, 0, 1),             // STOP_WD_CHG
+    BQ25798_FIELD(0x09, 1, 5, 0, 40, 0, 40, 1000),        // ITERM
+    BQ25798_FIELD(0x0A, 1, 2, 6, 1, 0, 0, 3),             // CELL
+    BQ25798_FIELD(0x0A, 1, 2, 4, 1, 0, 0, 3),             // TRECHG
+    BQ25798_FIELD(0x0A, 1, 4, 0, 50, 50, 50, 800),        // VRECHG
+    BQ25798_FIELD(0x0B, 2, 11, 0, 10, 2800, 2800, 22000), // VOTG
+    BQ25798_FIELD(0x0D, 1, 1, 7, 1, 0, 0, 1),             // PRECHG_TMR
+    BQ25798_FIELD(0x0D, 1, 7, 0, 40, 0, 160, 3360),       // IOTG
+    BQ25798_FIELD(0x0E, 1, 2, 6, 1, 0, 0, 3),             // TOPOFF_TMR
+    BQ25798_FIELD(0x0E, 1, 1, 5, 1, 0, 0, 1),             // EN_TRICHG_TMR
+    BQ25798_FIELD(0x0E, 1, 1, 4, 1, 0, 0, 1),             // EN_PRECHG_TMR
+    BQ25798_FIELD(0x0E, 1, 1, 3, 1, 0, 0, 1),             // EN_CHG_TMR
+    BQ25798_FIELD(0x0E, 1, 2, 1, 1, 0, 0, 3),             // CHG_TMR
+    BQ25798_FIELD(0x0E, 1, 1, 0, 1, 0, 0, 1),             // TMR2X_EN
+    BQ25798_FIELD(0x0F, 1, 1, 7, 1, 0, 0, 1),             // EN_AUTO_IBATDIS
+    BQ25798_FIELD(0x0F, 1, 1, 6, 1, 0, 0, 1),             // FORCE_IBATDIS
+    BQ25798_FIELD(0x0F, 1, 1, 5, 1, 0, 0, 1),             // EN_CHG
+    BQ25798_FIELD(0x0F, 1, 1, 4, 1, 0, 0, 1),             // EN_ICO
+    BQ25798_FIELD(0x0F, 1, 1, 3, 1, 0, 0, 1),             // FORCE_ICO
+    BQ25798_FIELD(0x0F, 1, 1, 2, 1, 0, 0, 1),             // EN_HIZ
+    BQ25798_FIELD(0x0F, 1, 1, 1, 1, 0, 0, 1),             // EN_TERM
+    BQ25798_FIELD(0x0F, 1, 1, 0, 1, 0, 0, 1),             // EN_BACKUP
+    BQ25798_FIELD(0x10, 1, 2, 6, 1, 0, 0, 3),             // VBUS_BACKUP
+    BQ25798_FIELD(0x10, 1, 2, 4, 1, 0, 0, 3),             // VAC_OVP
+    BQ25798_FIELD(0x10, 1, 1, 3, 1, 0, 0, 1),             // WD_RST
+    BQ25798_FIELD(0x10, 1, 3, 0, 1, 0, 0, 7),             // WATCHDOG
+    BQ25798_FIELD(0x11, 1, 1, 7, 1, 0, 0, 1),             // FORCE_INDET
+    BQ25798_FIELD(0x11, 1, 1, 6, 1, 0, 0, 1),             // AUTO_INDET_EN
+    BQ25798_FIELD(0x11, 1, 1, 5, 1, 0, 0, 1),             // EN_12V
+    BQ25798_FIELD(0x11, 1, 1, 4, 1, 0, 0, 1),             // EN_9V
+    BQ25798_FIELD(0x11, 1, 1, 3, 1, 0, 0, 1),             // HVDCP_EN
+    BQ25798_FIELD(0x11, 1, 2, 1, 1, 0, 0, 3),             // SDRV_CTRL
+    BQ25798_FIELD(0x11, 1, 1, 0, 1, 0, 0, 1),             // SDRV_DLY
+    BQ25798_FIELD(0x12, 1, 1, 7, 1, 0, 0, 1),             // DIS_ACDRV
+    BQ25798_FIELD(0x12, 1, 1, 6, 1, 0, 0, 1),             // EN_OTG
+    BQ25798_FIELD(0x12, 1, 1, 5, 1, 0, 0, 1),             // PFM_OTG_DIS
+    BQ25798_FIELD(0x12, 1, 1, 4, 1, 0, 0, 1),             // PFM_FWD_DIS
+    BQ25798_FIELD(0x12, 1, 1, 3, 1, 0, 0, 1),             // WKUP_DLY
+    BQ25798_FIELD(0x12, 1, 1, 2, 1, 0, 0, 1),             // DIS_LDO
+    BQ25798_FIELD(0x12, 1, 1, 1, 1, 0, 0, 1),             // DIS_OTG_OOA
+    BQ25798_FIELD(0x12, 1, 1, 0, 1, 0, 0, 1),             // DIS_FWD_OOA
+    BQ25798_FIELD(0x13, 1, 1, 7, 1, 0, 0, 1),             // EN_ACDRV2
+    BQ25798_FIELD(0x13, 1, 1, 6, 1, 0, 0, 1),             // EN_ACDRV1
+    BQ25798_FIELD(0x13, 1, 1, 5, 1, 0, 0, 1),             // PWM_FREQ
+    BQ25798_FIELD(0x13, 1, 1, 4, 1, 0, 0, 1),             // DIS_STAT
+    BQ25798_FIELD(0x13, 1, 1, 3, 1, 0, 0, 1),             // DIS_VSYS_SHORT
+    BQ25798_FIELD(0x13, 1, 1, 2, 1, 0, 0, 1),             // DIS_VOTG_UVP
+    BQ25798_FIELD(0x13, 1, 1, 1, 1, 0, 0, 1),             // FORCE_VINDPM_DET
+    BQ25798_FIELD(0x13, 1, 1, 0, 1, 0, 0, 1),             // EN_IBUS_OCP
+    BQ25798_FIELD(0x14, 1, 1, 7, 1, 0, 0, 1),             // SFET_PRESENT
+    BQ25798_FIELD(0x14, 1, 1, 5, 1, 0, 0, 1),             // EN_IBAT
+    BQ25798_FIELD(0x14, 1, 2, 3, 1, 0, 0, 3),             // IBAT_REG
+    BQ25798_FIELD(0x14, 1, 1, 2, 1, 0, 0, 1),             // EN_IINDPM
+    BQ25798_FIELD(0x14, 1, 1, 1, 1, 0, 0, 1),             // EN_EXTILIM
+    BQ25798_FIELD(0x14, 1, 1, 0, 1, 0, 0, 1),             // EN_BATOC
+    BQ25798_FIELD(0x15, 1, 3, 5, 1, 0, 0, 7),             // VOC_PCT
+    BQ25798_FIELD(0x15, 1, 2, 3, 1, 0, 0, 3),             // VOC_DLY
+    BQ25798_FIELD(0x15, 1, 2, 1, 1, 0, 0, 3),             // VOC_RATE
+    BQ25798_FIELD(0x15, 1, 1, 0, 1, 0, 0, 1),             // EN_MPPT
+    BQ25798_FIELD(0x16, 1, 2, 6, 1, 0, 0, 3),             // TREG
+    BQ25798_FIELD(0x16, 1, 2, 4, 1, 0, 0, 3),             // TSHUT
+    BQ25798_FIELD(0x16, 1, 1, 3, 1, 0, 0, 1),             // VBUS_PD_EN
+    BQ25798_FIELD(0x16, 1, 1, 2, 1, 0, 0, 1),             // VAC1_PD_EN
+    BQ25798_FIELD(0x16, 1, 1, 1, 1, 0, 0, 1),             // VAC2_PD_EN
+    BQ25798_FIELD(0x16, 1, 1, 0, 1, 0, 0, 1),             // BKUP_ACFET1_ON
+    BQ25798_FIELD(0x17, 1, 3, 5, 1, 0, 0, 7),             // JEITA_VSET
+    BQ25798_FIELD(0x17, 1, 2, 3, 1, 0, 0, 3),             // JEITA_ISETH
+    BQ25798_FIELD(0x17, 1, 2, 1, 1, 0, 0, 3),             // JEITA_ISETC
+    BQ25798_FIELD(0x18, 1, 2, 6, 1, 0, 0, 3),             // TS_COOL
+    BQ25798_FIELD(0x18, 1, 2, 4, 1, 0, 0, 3),             // TS_WARM
+    BQ25798_FIELD(0x18, 1, 2, 2, 1, 0, 0, 3),             // BHOT
+    BQ25798_FIELD(0x18, 1, 1, 1, 1, 0, 0, 1),             // BCOLD
+    BQ25798_FIELD(0x18, 1, 1, 0, 1, 0, 0, 1),             // TS_IGNORE
+    BQ25798_FIELD(0x1C, 1, 3, 5, 1, 0, 0, 7),             // CHG_STAT
+    BQ25798_FIELD(0x1E, 1, 1, 5, 1, 0, 0, 1),             // ADC_DONE_STAT
+    BQ25798_FIELD(0x2E, 1, 1, 7, 1, 0, 0, 1),             // ADC_EN
+    BQ25798_FIELD(0x2E, 1, 1, 6, 1, 0, 0, 1),             // ADC_RATE
+    BQ25798_FIELD(0x2E, 1, 2, 4, 1, 0, 0, 3),             // ADC_SAMPLE
+    BQ25798_FIELD(0x2E, 1, 1, 3, 1, 0, 0, 1),             // ADC_AVG
+    BQ25798_FIELD(0x2E, 1, 1, 2, 1, 0, 0, 1),             // ADC_AVG_INIT
+    BQ25798_FIELD(0x48, 1, 8, 0, 1, 0, 0, 255),           // PART_INFO
+};
+
+static_assert(sizeof(field_table) / sizeof(field_table[0]) ==
+                  BQ25798_FIELD_COUNT,
+              "field_table must match bq25798_field_t");
+
+/*!
+ * @brief Fetch a field descriptor from the table
+ * @param field Field to look up
+ * @param desc Destination for the descriptor
+ * @return True if the field exists
+ */
+static bool fieldDesc(bq25798_field_t field, bq25798_field_desc_t& desc) {
+  if ((uint8_t)field >= BQ25798_FIELD_COUNT) {
+    return false;
+  }
+
+  memcpy_P(&desc, &field_table[field], sizeof(desc));
+  return true;
+}
+
+/*!
+ * @brief Get the register width of a field
+ * @param desc Field descriptor
+ * @return Register width in bytes (1 or 2)
+ */
+static uint8_t fieldWidth(const bq25798_field_desc_t& desc) {
+  return (desc.layout >> 7) + 1;
+}
+
+/*!
+ * @brief Get the number of bits in a field
+ * @param desc Field descriptor
+ * @return Field size in bits
+ */
+static uint8_t fieldBits(const bq25798_field_desc_t& desc) {
+  return ((desc.layout >> 3) & 0x0F) + 1;
+}
+
+/*!
+ * @brief Get the bit position of a field LSB
+ * @param desc Field descriptor
+ * @return Shift within the (big-endian) register value
+ */
+static uint8_t fieldShift(const bq25798_field_desc_t& desc) {
+  return desc.layout & 0x07;
+}
+
+/*!
+ * @brief Get the mask of a field within its register
+ * @param desc Field descriptor
+ * @return Mask within the (big-endian) register value
+ */
+static uint16_t fieldMask(const bq25798_field_desc_t& desc) {
+  return (uint16_t)(((1UL << fieldBits(desc)) - 1) << fieldShift(desc));
+}
+
+/*!
+ * @brief  Instantiates a BusIO register transport
+ * @param  i2c_addr
+ *         The I2C address to be used.
+ * @param  wire
+ *         The Wire object to be used for I2C connections.
+ */
+Adafruit_BQ25798_I2CBus::Adafruit_BQ25798_I2CBus(uint8_t i2c_addr,
+                                                 TwoWire* wire)
+    : i2c_dev(i2c_addr, wire) {}
+
+/*!
+ * @brief  Initializes I2C and checks that something answers at the address
+ * @return True if the device acknowledged
+ */
+bool Adafruit_BQ25798_I2CBus::begin() {
+  return i2c_dev.begin();
+}
+
+/*!
+ * @brief Burst read consecutive registers with a repeated-start read
+ * @param reg First register address
+ * @param buffer Destination buffer
+ * @param len Number of bytes to read
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_I2CBus::readRegisters(uint8_t reg, uint8_t* buffer,
+                                            uint8_t len) {
+  return i2c_dev.write_then_read(&reg, 1, buffer, len);
+}
+
+/*!
+ * @brief Burst write consecutive registers in one transaction
+ * @param reg First register address
+ * @param buffer Source buffer
+ * @param len Number of bytes to write
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_I2CBus::writeRegisters(uint8_t reg,
+                                             const uint8_t* buffer,
+                                             uint8_t len) {
+  return i2c_dev.write(buffer, len, true, &reg, 1);
+}
+
 /*!
  * @brief  Instantiates a new BQ25798 class
  */
 Adafruit_BQ25798::Adafruit_BQ25798() {
-  i2c_dev = NULL;
+  bus = NULL;
+  bus_owned = false;
+  cache_enabled = false;
+  cache_valid = false;
+  updating = false;
+  int_pin = -1;
+  int_pending = false;
+  pending_events = 0;
+  wdt_code = 0xFF;
+  wdt_synced = false;
+  wdt_kicked_at = 0;
 }
 
 /*!
  * @brief  Destroys the BQ25798 object
  */
 Adafruit_BQ25798::~Adafruit_BQ25798() {
-  if (i2c_dev) {
-    delete i2c_dev;
-  }
+  detachInterruptPin();
+  setBus(NULL, false);
 }
 
 /*!
@@ -48,49 +285,371 @@ Adafruit_BQ25798::~Adafruit_BQ25798() {
  *         The I2C address to be used.
  * @param  wire
  *         The Wire object to be used for I2C connections.
+ * @param  reset_registers
+ *         True to return every register to its default. False for a warm
+ *         start that keeps the charger's current settings and only reads
+ *         them into the register cache, if enabled, with one burst.
  * @return True if initialization was successful, otherwise false.
  */
-bool Adafruit_BQ25798::begin(uint8_t i2c_addr, TwoWire* wire) {
-  if (i2c_dev) {
-    delete i2c_dev;
+bool Adafruit_BQ25798::begin(uint8_t i2c_addr, TwoWire* wire,
+                             bool reset_registers) {
+  Adafruit_BQ25798_I2CBus* i2c_bus =
+      new Adafruit_BQ25798_I2CBus(i2c_addr, wire);
+  setBus(i2c_bus, true);
+
+  if (!i2c_bus->begin()) {
+    return false;
   }
 
-  i2c_dev = new Adafruit_I2CDevice(i2c_addr, wire);
+  return init(reset_registers);
+}
+
+/*!
+ * @brief  Sets up the charger on a caller-provided register transport, such
+ *         as Adafruit_BQ25798_LinuxI2C. The transport must already be open
+ *         and must outlive this object.
+ * @param  bus
+ *         The transport to be used.
+ * @param  reset_registers
+ *         True to return every register to its default, false to keep the
+ *         charger's current settings as for begin(uint8_t, TwoWire*, bool).
+ * @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_BQ25798::begin(Adafruit_BQ25798_Bus* bus,
+                             bool reset_registers) {
+  setBus(bus, false);
 
-  if (!i2c_dev->begin()) {
+  if (!bus) {
     return false;
   }
 
-  // Check part information register to verify chip
-  Adafruit_BusIO_Register part_info_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_PART_INFORMATION);
-  uint8_t part_info = part_info_reg.read();
+  return init(reset_registers);
+}
 
-  // Verify part number (bits 5-3 should be 011b = 3h for BQ25798)
-  if ((part_info & 0x38) != 0x18) {
+/*!
+ * @brief Get whether control registers are served from the RAM shadow copy
+ * @return True if the register cache is enabled
+ */
+bool Adafruit_BQ25798::getCacheEnable() {
+  return cache_enabled;
+}
+
+/*!
+ * @brief Enable or disable the RAM shadow copy of the control registers
+ *
+ * When enabled, registers 0x00-0x19 are fetched with one burst read and
+ * getters are answered from RAM, while setters issue a single write instead
+ * of a read-modify-write. Fields the charger changes on its own (VINDPM,
+ * IINDPM, ICO result, ACDRV enables, HIZ/OTG, ship FET control and the
+ * REG_RST, FORCE_ICO, WD_RST, FORCE_INDET and FORCE_VINDPM_DET commands)
+ * are always fetched from the chip. Call refreshCache() after a watchdog
+ * expiry, since that returns the charger to its defaults.
+ *
+ * @param enable True to enable the register cache
+ * @return True if successful, false if the initial burst read failed
+ */
+bool Adafruit_BQ25798::setCacheEnable(bool enable) {
+  cache_enabled = enable;
+  cache_valid = false;
+
+  if (!enable || !bus) {
+    // begin() will fill the cache once the device is attached
+    return true;
+  }
+
+  return refreshCache();
+}
+
+/*!
+ * @brief Re-read the control registers into the shadow copy in one burst
+ * @return True if successful, false if the cache is disabled or the read
+ * failed
+ */
+bool Adafruit_BQ25798::refreshCache() {
+  cache_valid = false;
+
+  if (!cache_enabled) {
+    return false;
+  }
+
+  if (!readRegisters(0x00, shadow, BQ25798_SHADOW_SIZE)) {
+    return false;
+  }
+
+  cache_valid = true;
+  return true;
+}
+
+/*!
+ * @brief Read the raw code of a register field
+ * @param field Field to read
+ * @return Field code as stored in the register, or 0 if the read failed
+ */
+uint16_t Adafruit_BQ25798::readField(bq25798_field_t field) {
+  bq25798_field_desc_t desc;
+  if (!fieldDesc(field, desc)) {
+    return 0;
+  }
+
+  return readBits(desc.reg, fieldWidth(desc), fieldBits(desc),
+                  fieldShift(desc));
+}
+
+/*!
+ * @brief Write the raw code of a register field, preserving the other bits
+ * @param field Field to write
+ * @param code Field code as stored in the register
+ * @return True if successful, false if the code does not fit the field
+ */
+bool Adafruit_BQ25798::writeField(bq25798_field_t field, uint16_t code) {
+  bq25798_field_desc_t desc;
+  if (!fieldDesc(field, desc) || code > (fieldMask(desc) >> fieldShift(desc))) {
+    return false;
+  }
+
+  return writeBits(desc.reg, fieldWidth(desc), fieldBits(desc),
+                   fieldShift(desc), code);
+}
+
+/*!
+ * @brief Read a register field scaled to its natural units
+ *
+ * Voltages are in mV and currents in mA; enumerated and boolean fields come
+ * back as their raw code.
+ *
+ * @param field Field to read
+ * @return Field value, or the value of code 0 if the read failed
+ */
+uint16_t Adafruit_BQ25798::getField(bq25798_field_t field) {
+  bq25798_field_desc_t desc;
+  if (!fieldDesc(field, desc)) {
+    return 0;
+  }
+
+  uint16_t code = readBits(desc.reg, fieldWidth(desc), fieldBits(desc),
+                           fieldShift(desc));
+
+  return code * desc.lsb + desc.offset;
+}
+
+/*!
+ * @brief Write a register field given in its natural units
+ * @param field Field to write
+ * @param value Field value in mV, mA or as a raw code, see getField()
+ * @return True if successful, false if the value is out of range
+ */
+bool Adafruit_BQ25798::setField(bq25798_field_t field, uint16_t value) {
+  bq25798_field_desc_t desc;
+  if (!fieldDesc(field, desc) || value < desc.min || value > desc.max) {
+    return false;
+  }
+
+  return writeBits(desc.reg, fieldWidth(desc), fieldBits(desc),
+                   fieldShift(desc), (value - desc.offset) / desc.lsb);
+}
+
+/*!
+ * @brief Read several register fields with one burst
+ *
+ * The registers spanning all of the fields are read in a single transaction
+ * (or served from the register cache), then each field is decoded as by
+ * getField().
+ *
+ * @param fields Fields to read, in any order
+ * @param values Destination for the values, one per field
+ * @param count Number of fields
+ * @return True if successful, false on a bus error or if the fields span
+ * more than BQ25798_FIELD_SPAN_MAX registers
+ */
+bool Adafruit_BQ25798::getFields(const bq25798_field_t* fields,
+                                 uint16_t* values, uint8_t count) {
+  bq25798_field_desc_t desc;
+  uint8_t first = 0xFF;
+  uint8_t last = 0;
+  bool cached = true;
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (!fieldDesc(fields[i], desc)) {
+      return false;
+    }
+    if (desc.reg < first) {
+      first = desc.reg;
+    }
+    if (desc.reg + fieldWidth(desc) - 1 > last) {
+      last = desc.reg + fieldWidth(desc) - 1;
+    }
+    cached = cached &&
+             shadowHolds(desc.reg, fieldWidth(desc), fieldMask(desc), false);
+  }
+
+  if (count == 0) {
+    return true;
+  }
+  if (last - first + 1 > BQ25798_FIELD_SPAN_MAX) {
+    return false;
+  }
+
+  uint8_t buffer[BQ25798_FIELD_SPAN_MAX];
+  uint8_t len = last - first + 1;
+
+  if (cached) {
+    memcpy(buffer, shadow + first, len);
+  } else if (!readRegisters(first, buffer, len)) {
+    return false;
+  }
+  overlayStaged(first, buffer, len);
+
+  for (uint8_t i = 0; i < count; i++) {
+    fieldDesc(fields[i], desc);
+    const uint8_t* data = buffer + (desc.reg - first);
+    uint16_t reg_value = (fieldWidth(desc) == 2)
+                             ? ((uint16_t)data[0] << 8) | data[1]
+                             : data[0];
+    uint16_t code = (reg_value & fieldMask(desc)) >> fieldShift(desc);
+    values[i] = code * desc.lsb + desc.offset;
+  }
+
+  return true;
+}
+
+/*!
+ * @brief Write several register fields with as few transactions as possible
+ *
+ * Every value is range checked before anything is written. The registers
+ * spanning the fields are read once (or taken from the register cache), all
+ * fields are merged in, and each contiguous run of modified registers goes
+ * back in one burst. Fields sharing a register cost a single write.
+ *
+ * @param fields Fields to write, in any order
+ * @param values Field values as for setField(), one per field
+ * @param count Number of fields
+ * @return True if successful, false on a bus error, an out-of-range value,
+ * or if the fields span more than BQ25798_FIELD_SPAN_MAX registers
+ */
+bool Adafruit_BQ25798::setFields(const bq25798_field_t* fields,
+                                 const uint16_t* values, uint8_t count) {
+  bq25798_field_plan_t plan;
+
+  if (!planFields(fields, values, count, plan)) {
+    return false;
+  }
+  if (plan.len == 0) {
+    return true;
+  }
+  if (updating && plan.first + plan.len <= BQ25798_SHADOW_SIZE) {
+    // Already range checked, so each field only lands in the staging copy
+    for (uint8_t i = 0; i < count; i++) {
+      setField(fields[i], values[i]);
+    }
+    return true;
+  }
+  if (!plan.cached && !readRegisters(plan.first, plan.buffer, plan.len)) {
+    return false;
+  }
+
+  mergeFields(fields, values, count, plan);
+
+  uint8_t pos = 0;
+  uint8_t run;
+  uint8_t len;
+  while (nextRun(plan, pos, run, len)) {
+    if (!writeRegisters(plan.first + run, plan.buffer + run, len)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*!
+ * @brief Start collecting setter calls instead of writing them
+ *
+ * Until commit() or cancelUpdate(), setters for the control registers
+ * (0x00-0x19) only change a staging copy in RAM, and getters see the staged
+ * values. Setters for other registers, such as the ADC and event mask
+ * controls, still write straight away. Several setters that share a
+ * register then cost a single write.
+ */
+void Adafruit_BQ25798::beginUpdate() {
+  memset(staged_bits, 0, sizeof(staged_bits));
+  updating = true;
+}
+
+/*!
+ * @brief Write everything staged since beginUpdate() and end the update
+ *
+ * The registers between the first and last staged one are read in one
+ * burst (or taken from the register cache where it can be trusted), the
+ * staged bits are merged in, and each contiguous run of staged registers is
+ * written in one burst, so every register is written once.
+ *
+ * @return True if successful or nothing was staged, false on a bus error
+ */
+bool Adafruit_BQ25798::commit() {
+  bq25798_field_plan_t plan;
+  uint8_t first = 0;
+  uint8_t last = BQ25798_SHADOW_SIZE;
+
+  if (!updating) {
+    return true;
+  }
+  updating = false;
+
+  while (first < BQ25798_SHADOW_SIZE && !staged_bits[first]) {
+    first++;
+  }
+  if (first == BQ25798_SHADOW_SIZE) {
+    return true;
+  }
+  while (!staged_bits[last - 1]) {
+    last--;
+  }
+
+  plan.first = first;
+  plan.len = last - first;
+  plan.cached = true;
+  memcpy(plan.touched, staged_bits + first, plan.len);
+  for (uint8_t i = 0; i < plan.len && plan.cached; i++) {
+    plan.cached = !plan.touched[i] ||
+                  shadowHolds(first + i, 1, plan.touched[i], true);
+  }
+
+  if (plan.cached) {
+    memcpy(plan.buffer, shadow + first, plan.len);
+  } else if (!readRegisters(plan.first, plan.buffer, plan.len)) {
     return false;
   }
 
-  // Reset all registers to default values
-  reset();
+  for (uint8_t i = 0; i < plan.len; i++) {
+    plan.buffer[i] = (plan.buffer[i] & ~plan.touched[i]) |
+                     (staged[first + i] & plan.touched[i]);
+  }
+
+  uint8_t pos = 0;
+  uint8_t run;
+  uint8_t len;
+  while (nextRun(plan, pos, run, len)) {
+    if (!writeRegisters(plan.first + run, plan.buffer + run, len)) {
+      return false;
+    }
+  }
 
   return true;
 }
 
+/*!
+ * @brief Drop everything staged since beginUpdate() and end the update
+ */
+void Adafruit_BQ25798::cancelUpdate() {
+  updating = false;
+}
+
 /*!
  * @brief Get the minimal system voltage setting
  * @return Minimal system voltage in volts
  */
 float Adafruit_BQ25798::getMinSystemV() {
-  Adafruit_BusIO_Register vsys_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MINIMAL_SYSTEM_VOLTAGE);
-  Adafruit_BusIO_RegisterBits vsys_bits =
-      Adafruit_BusIO_RegisterBits(&vsys_reg, 6, 0);
-
-  uint8_t reg_value = vsys_bits.read();
-
-  // Convert to voltage: (register_value × 250mV) + 2500mV
-  return (reg_value * 0.25f) + 2.5f;
+  return getMinSystem_mV() / 1000.0f;
 }
 
 /*!
@@ -103,22 +662,25 @@ bool Adafruit_BQ25798::setMinSystemV(float voltage) {
     return false;
   }
 
-  // Convert voltage to register value: (voltage - 2.5V) / 0.25V
-  uint8_t reg_value = (uint8_t)((voltage - 2.5f) / 0.25f);
-
-  // Clamp to 6-bit range (0-63)
-  if (reg_value > 63) {
-    reg_value = 63;
-  }
-
-  Adafruit_BusIO_Register vsys_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MINIMAL_SYSTEM_VOLTAGE);
-  Adafruit_BusIO_RegisterBits vsys_bits =
-      Adafruit_BusIO_RegisterBits(&vsys_reg, 6, 0);
+  // Round to the nearest millivolt, then use the integer path
+  return setMinSystem_mV((uint16_t)(voltage * 1000.0f + 0.5f));
+}
 
-  vsys_bits.write(reg_value);
+/*!
+ * @brief Get the minimal system voltage setting
+ * @return Minimal system voltage in millivolts
+ */
+uint16_t Adafruit_BQ25798::getMinSystem_mV() {
+  return getField(BQ25798_FIELD_VSYSMIN);
+}
 
-  return true;
+/*!
+ * @brief Set the minimal system voltage
+ * @param voltage Minimal system voltage in millivolts (2500mV to 16000mV)
+ * @return True if successful, false if voltage out of range
+ */
+bool Adafruit_BQ25798::setMinSystem_mV(uint16_t voltage) {
+  return setField(BQ25798_FIELD_VSYSMIN, voltage);
 }
 
 /*!
@@ -126,15 +688,7 @@ bool Adafruit_BQ25798::setMinSystemV(float voltage) {
  * @return Charge voltage limit in volts
  */
 float Adafruit_BQ25798::getChargeLimitV() {
-  Adafruit_BusIO_Register vreg_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_CHARGE_VOLTAGE_LIMIT, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits vreg_bits =
-      Adafruit_BusIO_RegisterBits(&vreg_reg, 11, 0);
-
-  uint16_t reg_value = vreg_bits.read();
-
-  // Convert to voltage: register_value × 10mV
-  return reg_value * 0.01f;
+  return getChargeLimit_mV() / 1000.0f;
 }
 
 /*!
@@ -147,22 +701,25 @@ bool Adafruit_BQ25798::setChargeLimitV(float voltage) {
     return false;
   }
 
-  // Convert voltage to register value: voltage / 0.01V
-  uint16_t reg_value = (uint16_t)(voltage / 0.01f);
-
-  // Clamp to 11-bit range (0-2047)
-  if (reg_value > 2047) {
-    reg_value = 2047;
-  }
-
-  Adafruit_BusIO_Register vreg_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_CHARGE_VOLTAGE_LIMIT, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits vreg_bits =
-      Adafruit_BusIO_RegisterBits(&vreg_reg, 11, 0);
+  // Round to the nearest millivolt, then use the integer path
+  return setChargeLimit_mV((uint16_t)(voltage * 1000.0f + 0.5f));
+}
 
-  vreg_bits.write(reg_value);
+/*!
+ * @brief Get the charge voltage limit setting
+ * @return Charge voltage limit in millivolts
+ */
+uint16_t Adafruit_BQ25798::getChargeLimit_mV() {
+  return getField(BQ25798_FIELD_VREG);
+}
 
-  return true;
+/*!
+ * @brief Set the charge voltage limit
+ * @param voltage Charge voltage limit in millivolts (3000mV to 18800mV)
+ * @return True if successful, false if voltage out of range
+ */
+bool Adafruit_BQ25798::setChargeLimit_mV(uint16_t voltage) {
+  return setField(BQ25798_FIELD_VREG, voltage);
 }
 
 /*!
@@ -170,15 +727,7 @@ bool Adafruit_BQ25798::setChargeLimitV(float voltage) {
  * @return Charge current limit in amps
  */
 float Adafruit_BQ25798::getChargeLimitA() {
-  Adafruit_BusIO_Register ichg_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_CHARGE_CURRENT_LIMIT, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits ichg_bits =
-      Adafruit_BusIO_RegisterBits(&ichg_reg, 9, 0);
-
-  uint16_t reg_value = ichg_bits.read();
-
-  // Convert to current: register_value × 10mA
-  return reg_value * 0.01f;
+  return getChargeLimit_mA() / 1000.0f;
 }
 
 /*!
@@ -191,22 +740,25 @@ bool Adafruit_BQ25798::setChargeLimitA(float current) {
     return false;
   }
 
-  // Convert current to register value: current / 0.01A
-  uint16_t reg_value = (uint16_t)(current / 0.01f);
-
-  // Clamp to 9-bit range (0-511)
-  if (reg_value > 511) {
-    reg_value = 511;
-  }
-
-  Adafruit_BusIO_Register ichg_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_CHARGE_CURRENT_LIMIT, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits ichg_bits =
-      Adafruit_BusIO_RegisterBits(&ichg_reg, 9, 0);
+  // Round to the nearest milliamp, then use the integer path
+  return setChargeLimit_mA((uint16_t)(current * 1000.0f + 0.5f));
+}
 
-  ichg_bits.write(reg_value);
+/*!
+ * @brief Get the charge current limit setting
+ * @return Charge current limit in milliamps
+ */
+uint16_t Adafruit_BQ25798::getChargeLimit_mA() {
+  return getField(BQ25798_FIELD_ICHG);
+}
 
-  return true;
+/*!
+ * @brief Set the charge current limit
+ * @param current Charge current limit in milliamps (50mA to 5000mA)
+ * @return True if successful, false if current out of range
+ */
+bool Adafruit_BQ25798::setChargeLimit_mA(uint16_t current) {
+  return setField(BQ25798_FIELD_ICHG, current);
 }
 
 /*!
@@ -214,13 +766,7 @@ bool Adafruit_BQ25798::setChargeLimitA(float current) {
  * @return Input voltage limit in volts
  */
 float Adafruit_BQ25798::getInputLimitV() {
-  Adafruit_BusIO_Register vindpm_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_INPUT_VOLTAGE_LIMIT);
-
-  uint8_t reg_value = vindpm_reg.read();
-
-  // Convert to voltage: register_value × 100mV
-  return reg_value * 0.1f;
+  return getInputLimit_mV() / 1000.0f;
 }
 
 /*!
@@ -233,20 +779,25 @@ bool Adafruit_BQ25798::setInputLimitV(float voltage) {
     return false;
   }
 
-  // Convert voltage to register value: voltage / 0.1V
-  uint8_t reg_value = (uint8_t)(voltage / 0.1f);
-
-  // Clamp to 8-bit range (0-255)
-  if (reg_value > 255) {
-    reg_value = 255;
-  }
-
-  Adafruit_BusIO_Register vindpm_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_INPUT_VOLTAGE_LIMIT);
+  // Round to the nearest millivolt, then use the integer path
+  return setInputLimit_mV((uint16_t)(voltage * 1000.0f + 0.5f));
+}
 
-  vindpm_reg.write(reg_value);
+/*!
+ * @brief Get the input voltage limit setting
+ * @return Input voltage limit in millivolts
+ */
+uint16_t Adafruit_BQ25798::getInputLimit_mV() {
+  return getField(BQ25798_FIELD_VINDPM);
+}
 
-  return true;
+/*!
+ * @brief Set the input voltage limit
+ * @param voltage Input voltage limit in millivolts (3600mV to 22000mV)
+ * @return True if successful, false if voltage out of range
+ */
+bool Adafruit_BQ25798::setInputLimit_mV(uint16_t voltage) {
+  return setField(BQ25798_FIELD_VINDPM, voltage);
 }
 
 /*!
@@ -254,15 +805,7 @@ bool Adafruit_BQ25798::setInputLimitV(float voltage) {
  * @return Input current limit in amps
  */
 float Adafruit_BQ25798::getInputLimitA() {
-  Adafruit_BusIO_Register iindpm_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_INPUT_CURRENT_LIMIT, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits iindpm_bits =
-      Adafruit_BusIO_RegisterBits(&iindpm_reg, 9, 0);
-
-  uint16_t reg_value = iindpm_bits.read();
-
-  // Convert to current: register_value × 10mA
-  return reg_value * 0.01f;
+  return getInputLimit_mA() / 1000.0f;
 }
 
 /*!
@@ -275,22 +818,25 @@ bool Adafruit_BQ25798::setInputLimitA(float current) {
     return false;
   }
 
-  // Convert current to register value: current / 0.01A
-  uint16_t reg_value = (uint16_t)(current / 0.01f);
-
-  // Clamp to 9-bit range (0-511)
-  if (reg_value > 511) {
-    reg_value = 511;
-  }
-
-  Adafruit_BusIO_Register iindpm_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_INPUT_CURRENT_LIMIT, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits iindpm_bits =
-      Adafruit_BusIO_RegisterBits(&iindpm_reg, 9, 0);
+  // Round to the nearest milliamp, then use the integer path
+  return setInputLimit_mA((uint16_t)(current * 1000.0f + 0.5f));
+}
 
-  iindpm_bits.write(reg_value);
+/*!
+ * @brief Get the input current limit setting
+ * @return Input current limit in milliamps
+ */
+uint16_t Adafruit_BQ25798::getInputLimit_mA() {
+  return getField(BQ25798_FIELD_IINDPM);
+}
 
-  return true;
+/*!
+ * @brief Set the input current limit
+ * @param current Input current limit in milliamps (100mA to 3300mA)
+ * @return True if successful, false if current out of range
+ */
+bool Adafruit_BQ25798::setInputLimit_mA(uint16_t current) {
+  return setField(BQ25798_FIELD_IINDPM, current);
 }
 
 /*!
@@ -299,14 +845,7 @@ bool Adafruit_BQ25798::setInputLimitA(float current) {
  * @return Battery voltage threshold as percentage of VREG
  */
 bq25798_vbat_lowv_t Adafruit_BQ25798::getVBatLowV() {
-  Adafruit_BusIO_Register precharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_PRECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits vbat_lowv_bits =
-      Adafruit_BusIO_RegisterBits(&precharge_reg, 2, 6);
-
-  uint8_t reg_value = vbat_lowv_bits.read();
-
-  return (bq25798_vbat_lowv_t)reg_value;
+  return (bq25798_vbat_lowv_t)readField(BQ25798_FIELD_VBAT_LOWV);
 }
 
 /*!
@@ -316,18 +855,7 @@ bq25798_vbat_lowv_t Adafruit_BQ25798::getVBatLowV() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setVBatLowV(bq25798_vbat_lowv_t threshold) {
-  if (threshold > BQ25798_VBAT_LOWV_71_4_PERCENT) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register precharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_PRECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits vbat_lowv_bits =
-      Adafruit_BusIO_RegisterBits(&precharge_reg, 2, 6);
-
-  vbat_lowv_bits.write((uint8_t)threshold);
-
-  return true;
+  return setField(BQ25798_FIELD_VBAT_LOWV, threshold);
 }
 
 /*!
@@ -335,15 +863,7 @@ bool Adafruit_BQ25798::setVBatLowV(bq25798_vbat_lowv_t threshold) {
  * @return Precharge current limit in amps
  */
 float Adafruit_BQ25798::getPrechargeLimitA() {
-  Adafruit_BusIO_Register precharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_PRECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits iprechg_bits =
-      Adafruit_BusIO_RegisterBits(&precharge_reg, 6, 0);
-
-  uint8_t reg_value = iprechg_bits.read();
-
-  // Convert to current: register_value × 40mA
-  return reg_value * 0.04f;
+  return getPrechargeLimit_mA() / 1000.0f;
 }
 
 /*!
@@ -356,22 +876,25 @@ bool Adafruit_BQ25798::setPrechargeLimitA(float current) {
     return false;
   }
 
-  // Convert current to register value: current / 0.04A
-  uint8_t reg_value = (uint8_t)(current / 0.04f);
+  // Round to the nearest milliamp, then use the integer path
+  return setPrechargeLimit_mA((uint16_t)(current * 1000.0f + 0.5f));
+}
 
-  // Clamp to 6-bit range (0-63)
-  if (reg_value > 63) {
-    reg_value = 63;
-  }
-
-  Adafruit_BusIO_Register precharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_PRECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits iprechg_bits =
-      Adafruit_BusIO_RegisterBits(&precharge_reg, 6, 0);
-
-  iprechg_bits.write(reg_value);
+/*!
+ * @brief Get the precharge current limit setting
+ * @return Precharge current limit in milliamps
+ */
+uint16_t Adafruit_BQ25798::getPrechargeLimit_mA() {
+  return getField(BQ25798_FIELD_IPRECHG);
+}
 
-  return true;
+/*!
+ * @brief Set the precharge current limit
+ * @param current Precharge current limit in milliamps (40mA to 2000mA)
+ * @return True if successful, false if current out of range
+ */
+bool Adafruit_BQ25798::setPrechargeLimit_mA(uint16_t current) {
+  return setField(BQ25798_FIELD_IPRECHG, current);
 }
 
 /*!
@@ -380,12 +903,7 @@ bool Adafruit_BQ25798::setPrechargeLimitA(float current) {
  * will reset them
  */
 bool Adafruit_BQ25798::getStopOnWDT() {
-  Adafruit_BusIO_Register term_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TERMINATION_CONTROL);
-  Adafruit_BusIO_RegisterBits stop_wd_bit =
-      Adafruit_BusIO_RegisterBits(&term_reg, 1, 5);
-
-  return stop_wd_bit.read() == 1;
+  return readField(BQ25798_FIELD_STOP_WD_CHG) == 1;
 }
 
 /*!
@@ -395,14 +913,7 @@ bool Adafruit_BQ25798::getStopOnWDT() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setStopOnWDT(bool stopOnWDT) {
-  Adafruit_BusIO_Register term_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TERMINATION_CONTROL);
-  Adafruit_BusIO_RegisterBits stop_wd_bit =
-      Adafruit_BusIO_RegisterBits(&term_reg, 1, 5);
-
-  stop_wd_bit.write(stopOnWDT ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_STOP_WD_CHG, stopOnWDT ? 1 : 0);
 }
 
 /*!
@@ -410,15 +921,7 @@ bool Adafruit_BQ25798::setStopOnWDT(bool stopOnWDT) {
  * @return Termination current limit in amps
  */
 float Adafruit_BQ25798::getTerminationA() {
-  Adafruit_BusIO_Register term_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TERMINATION_CONTROL);
-  Adafruit_BusIO_RegisterBits iterm_bits =
-      Adafruit_BusIO_RegisterBits(&term_reg, 5, 0);
-
-  uint8_t reg_value = iterm_bits.read();
-
-  // Convert to current: register_value × 40mA
-  return reg_value * 0.04f;
+  return getTermination_mA() / 1000.0f;
 }
 
 /*!
@@ -431,22 +934,25 @@ bool Adafruit_BQ25798::setTerminationA(float current) {
     return false;
   }
 
-  // Convert current to register value: current / 0.04A
-  uint8_t reg_value = (uint8_t)(current / 0.04f);
-
-  // Clamp to 5-bit range (0-31)
-  if (reg_value > 31) {
-    reg_value = 31;
-  }
-
-  Adafruit_BusIO_Register term_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TERMINATION_CONTROL);
-  Adafruit_BusIO_RegisterBits iterm_bits =
-      Adafruit_BusIO_RegisterBits(&term_reg, 5, 0);
+  // Round to the nearest milliamp, then use the integer path
+  return setTermination_mA((uint16_t)(current * 1000.0f + 0.5f));
+}
 
-  iterm_bits.write(reg_value);
+/*!
+ * @brief Get the termination current limit setting
+ * @return Termination current limit in milliamps
+ */
+uint16_t Adafruit_BQ25798::getTermination_mA() {
+  return getField(BQ25798_FIELD_ITERM);
+}
 
-  return true;
+/*!
+ * @brief Set the termination current limit
+ * @param current Termination current limit in milliamps (40mA to 1000mA)
+ * @return True if successful, false if current out of range
+ */
+bool Adafruit_BQ25798::setTermination_mA(uint16_t current) {
+  return setField(BQ25798_FIELD_ITERM, current);
 }
 
 /*!
@@ -454,14 +960,7 @@ bool Adafruit_BQ25798::setTerminationA(float current) {
  * @return Battery cell count
  */
 bq25798_cell_count_t Adafruit_BQ25798::getCellCount() {
-  Adafruit_BusIO_Register recharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_RECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits cell_bits =
-      Adafruit_BusIO_RegisterBits(&recharge_reg, 2, 6);
-
-  uint8_t reg_value = cell_bits.read();
-
-  return (bq25798_cell_count_t)reg_value;
+  return (bq25798_cell_count_t)readField(BQ25798_FIELD_CELL);
 }
 
 /*!
@@ -470,18 +969,7 @@ bq25798_cell_count_t Adafruit_BQ25798::getCellCount() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setCellCount(bq25798_cell_count_t cellCount) {
-  if (cellCount > BQ25798_CELL_COUNT_4S) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register recharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_RECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits cell_bits =
-      Adafruit_BusIO_RegisterBits(&recharge_reg, 2, 6);
-
-  cell_bits.write((uint8_t)cellCount);
-
-  return true;
+  return setField(BQ25798_FIELD_CELL, cellCount);
 }
 
 /*!
@@ -489,14 +977,7 @@ bool Adafruit_BQ25798::setCellCount(bq25798_cell_count_t cellCount) {
  * @return Battery recharge deglitch time
  */
 bq25798_trechg_time_t Adafruit_BQ25798::getRechargeDeglitchTime() {
-  Adafruit_BusIO_Register recharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_RECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits trechg_bits =
-      Adafruit_BusIO_RegisterBits(&recharge_reg, 2, 4);
-
-  uint8_t reg_value = trechg_bits.read();
-
-  return (bq25798_trechg_time_t)reg_value;
+  return (bq25798_trechg_time_t)readField(BQ25798_FIELD_TRECHG);
 }
 
 /*!
@@ -506,18 +987,7 @@ bq25798_trechg_time_t Adafruit_BQ25798::getRechargeDeglitchTime() {
  */
 bool Adafruit_BQ25798::setRechargeDeglitchTime(
     bq25798_trechg_time_t deglitchTime) {
-  if (deglitchTime > BQ25798_TRECHG_2048MS) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register recharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_RECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits trechg_bits =
-      Adafruit_BusIO_RegisterBits(&recharge_reg, 2, 4);
-
-  trechg_bits.write((uint8_t)deglitchTime);
-
-  return true;
+  return setField(BQ25798_FIELD_TRECHG, deglitchTime);
 }
 
 /*!
@@ -525,15 +995,7 @@ bool Adafruit_BQ25798::setRechargeDeglitchTime(
  * @return Recharge threshold offset voltage in volts (below VREG)
  */
 float Adafruit_BQ25798::getRechargeThreshOffsetV() {
-  Adafruit_BusIO_Register recharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_RECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits vrechg_bits =
-      Adafruit_BusIO_RegisterBits(&recharge_reg, 4, 0);
-
-  uint8_t reg_value = vrechg_bits.read();
-
-  // Convert to voltage: (register_value × 50mV) + 50mV
-  return (reg_value * 0.05f) + 0.05f;
+  return getRechargeThreshOffset_mV() / 1000.0f;
 }
 
 /*!
@@ -546,22 +1008,26 @@ bool Adafruit_BQ25798::setRechargeThreshOffsetV(float voltage) {
     return false;
   }
 
-  // Convert voltage to register value: (voltage - 0.05V) / 0.05V
-  uint8_t reg_value = (uint8_t)((voltage - 0.05f) / 0.05f);
-
-  // Clamp to 4-bit range (0-15)
-  if (reg_value > 15) {
-    reg_value = 15;
-  }
-
-  Adafruit_BusIO_Register recharge_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_RECHARGE_CONTROL);
-  Adafruit_BusIO_RegisterBits vrechg_bits =
-      Adafruit_BusIO_RegisterBits(&recharge_reg, 4, 0);
+  // Round to the nearest millivolt, then use the integer path
+  return setRechargeThreshOffset_mV((uint16_t)(voltage * 1000.0f + 0.5f));
+}
 
-  vrechg_bits.write(reg_value);
+/*!
+ * @brief Get the battery recharge threshold offset voltage
+ * @return Recharge threshold offset voltage in millivolts (below VREG)
+ */
+uint16_t Adafruit_BQ25798::getRechargeThreshOffset_mV() {
+  return getField(BQ25798_FIELD_VRECHG);
+}
 
-  return true;
+/*!
+ * @brief Set the battery recharge threshold offset voltage
+ * @param voltage Recharge threshold offset voltage in millivolts (50mV to
+ * 800mV)
+ * @return True if successful, false if voltage out of range
+ */
+bool Adafruit_BQ25798::setRechargeThreshOffset_mV(uint16_t voltage) {
+  return setField(BQ25798_FIELD_VRECHG, voltage);
 }
 
 /*!
@@ -569,15 +1035,7 @@ bool Adafruit_BQ25798::setRechargeThreshOffsetV(float voltage) {
  * @return OTG voltage in volts
  */
 float Adafruit_BQ25798::getOTGV() {
-  Adafruit_BusIO_Register votg_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_VOTG_REGULATION, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits votg_bits =
-      Adafruit_BusIO_RegisterBits(&votg_reg, 11, 0);
-
-  uint16_t reg_value = votg_bits.read();
-
-  // Convert to voltage: (register_value × 10mV) + 2800mV
-  return (reg_value * 0.01f) + 2.8f;
+  return getOTG_mV() / 1000.0f;
 }
 
 /*!
@@ -590,22 +1048,25 @@ bool Adafruit_BQ25798::setOTGV(float voltage) {
     return false;
   }
 
-  // Convert voltage to register value: (voltage - 2.8V) / 0.01V
-  uint16_t reg_value = (uint16_t)((voltage - 2.8f) / 0.01f);
-
-  // Clamp to 11-bit range (0-2047)
-  if (reg_value > 2047) {
-    reg_value = 2047;
-  }
-
-  Adafruit_BusIO_Register votg_reg = Adafruit_BusIO_Register(
-      i2c_dev, BQ25798_REG_VOTG_REGULATION, 2, MSBFIRST);
-  Adafruit_BusIO_RegisterBits votg_bits =
-      Adafruit_BusIO_RegisterBits(&votg_reg, 11, 0);
+  // Round to the nearest millivolt, then use the integer path
+  return setOTG_mV((uint16_t)(voltage * 1000.0f + 0.5f));
+}
 
-  votg_bits.write(reg_value);
+/*!
+ * @brief Get the OTG mode regulation voltage setting
+ * @return OTG voltage in millivolts
+ */
+uint16_t Adafruit_BQ25798::getOTG_mV() {
+  return getField(BQ25798_FIELD_VOTG);
+}
 
-  return true;
+/*!
+ * @brief Set the OTG mode regulation voltage
+ * @param voltage OTG voltage in millivolts (2800mV to 22000mV)
+ * @return True if successful, false if voltage out of range
+ */
+bool Adafruit_BQ25798::setOTG_mV(uint16_t voltage) {
+  return setField(BQ25798_FIELD_VOTG, voltage);
 }
 
 /*!
@@ -613,14 +1074,7 @@ bool Adafruit_BQ25798::setOTGV(float voltage) {
  * @return Precharge timer setting
  */
 bq25798_prechg_timer_t Adafruit_BQ25798::getPrechargeTimer() {
-  Adafruit_BusIO_Register iotg_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_IOTG_REGULATION);
-  Adafruit_BusIO_RegisterBits prechg_tmr_bit =
-      Adafruit_BusIO_RegisterBits(&iotg_reg, 1, 7);
-
-  uint8_t reg_value = prechg_tmr_bit.read();
-
-  return (bq25798_prechg_timer_t)reg_value;
+  return (bq25798_prechg_timer_t)readField(BQ25798_FIELD_PRECHG_TMR);
 }
 
 /*!
@@ -629,18 +1083,7 @@ bq25798_prechg_timer_t Adafruit_BQ25798::getPrechargeTimer() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setPrechargeTimer(bq25798_prechg_timer_t timer) {
-  if (timer > BQ25798_PRECHG_TMR_0_5HR) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register iotg_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_IOTG_REGULATION);
-  Adafruit_BusIO_RegisterBits prechg_tmr_bit =
-      Adafruit_BusIO_RegisterBits(&iotg_reg, 1, 7);
-
-  prechg_tmr_bit.write((uint8_t)timer);
-
-  return true;
+  return setField(BQ25798_FIELD_PRECHG_TMR, timer);
 }
 
 /*!
@@ -648,15 +1091,7 @@ bool Adafruit_BQ25798::setPrechargeTimer(bq25798_prechg_timer_t timer) {
  * @return OTG current limit in amps
  */
 float Adafruit_BQ25798::getOTGLimitA() {
-  Adafruit_BusIO_Register iotg_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_IOTG_REGULATION);
-  Adafruit_BusIO_RegisterBits iotg_bits =
-      Adafruit_BusIO_RegisterBits(&iotg_reg, 7, 0);
-
-  uint8_t reg_value = iotg_bits.read();
-
-  // Convert to current: register_value × 40mA
-  return reg_value * 0.04f;
+  return getOTGLimit_mA() / 1000.0f;
 }
 
 /*!
@@ -669,22 +1104,25 @@ bool Adafruit_BQ25798::setOTGLimitA(float current) {
     return false;
   }
 
-  // Convert current to register value: current / 0.04A
-  uint8_t reg_value = (uint8_t)(current / 0.04f);
-
-  // Clamp to 7-bit range (0-127)
-  if (reg_value > 127) {
-    reg_value = 127;
-  }
-
-  Adafruit_BusIO_Register iotg_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_IOTG_REGULATION);
-  Adafruit_BusIO_RegisterBits iotg_bits =
-      Adafruit_BusIO_RegisterBits(&iotg_reg, 7, 0);
+  // Round to the nearest milliamp, then use the integer path
+  return setOTGLimit_mA((uint16_t)(current * 1000.0f + 0.5f));
+}
 
-  iotg_bits.write(reg_value);
+/*!
+ * @brief Get the OTG current limit setting
+ * @return OTG current limit in milliamps
+ */
+uint16_t Adafruit_BQ25798::getOTGLimit_mA() {
+  return getField(BQ25798_FIELD_IOTG);
+}
 
-  return true;
+/*!
+ * @brief Set the OTG current limit
+ * @param current OTG current limit in milliamps (160mA to 3360mA)
+ * @return True if successful, false if current out of range
+ */
+bool Adafruit_BQ25798::setOTGLimit_mA(uint16_t current) {
+  return setField(BQ25798_FIELD_IOTG, current);
 }
 
 /*!
@@ -692,14 +1130,7 @@ bool Adafruit_BQ25798::setOTGLimitA(float current) {
  * @return Top-off timer setting
  */
 bq25798_topoff_timer_t Adafruit_BQ25798::getTopOffTimer() {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits topoff_bits =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 2, 6);
-
-  uint8_t reg_value = topoff_bits.read();
-
-  return (bq25798_topoff_timer_t)reg_value;
+  return (bq25798_topoff_timer_t)readField(BQ25798_FIELD_TOPOFF_TMR);
 }
 
 /*!
@@ -708,18 +1139,7 @@ bq25798_topoff_timer_t Adafruit_BQ25798::getTopOffTimer() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setTopOffTimer(bq25798_topoff_timer_t timer) {
-  if (timer > BQ25798_TOPOFF_TMR_45MIN) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits topoff_bits =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 2, 6);
-
-  topoff_bits.write((uint8_t)timer);
-
-  return true;
+  return setField(BQ25798_FIELD_TOPOFF_TMR, timer);
 }
 
 /*!
@@ -727,12 +1147,7 @@ bool Adafruit_BQ25798::setTopOffTimer(bq25798_topoff_timer_t timer) {
  * @return True if trickle charge timer is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getTrickleChargeTimerEnable() {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits trickle_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 5);
-
-  return trickle_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_TRICHG_TMR) == 1;
 }
 
 /*!
@@ -741,14 +1156,7 @@ bool Adafruit_BQ25798::getTrickleChargeTimerEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setTrickleChargeTimerEnable(bool enable) {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits trickle_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 5);
-
-  trickle_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_TRICHG_TMR, enable ? 1 : 0);
 }
 
 /*!
@@ -756,12 +1164,7 @@ bool Adafruit_BQ25798::setTrickleChargeTimerEnable(bool enable) {
  * @return True if precharge timer is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getPrechargeTimerEnable() {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits prechg_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 4);
-
-  return prechg_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_PRECHG_TMR) == 1;
 }
 
 /*!
@@ -770,14 +1173,7 @@ bool Adafruit_BQ25798::getPrechargeTimerEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setPrechargeTimerEnable(bool enable) {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits prechg_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 4);
-
-  prechg_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_PRECHG_TMR, enable ? 1 : 0);
 }
 
 /*!
@@ -785,12 +1181,7 @@ bool Adafruit_BQ25798::setPrechargeTimerEnable(bool enable) {
  * @return True if fast charge timer is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getFastChargeTimerEnable() {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits chg_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 3);
-
-  return chg_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_CHG_TMR) == 1;
 }
 
 /*!
@@ -799,14 +1190,7 @@ bool Adafruit_BQ25798::getFastChargeTimerEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setFastChargeTimerEnable(bool enable) {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits chg_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 3);
-
-  chg_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_CHG_TMR, enable ? 1 : 0);
 }
 
 /*!
@@ -814,14 +1198,7 @@ bool Adafruit_BQ25798::setFastChargeTimerEnable(bool enable) {
  * @return Fast charge timer setting
  */
 bq25798_chg_timer_t Adafruit_BQ25798::getFastChargeTimer() {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits chg_tmr_bits =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 2, 1);
-
-  uint8_t reg_value = chg_tmr_bits.read();
-
-  return (bq25798_chg_timer_t)reg_value;
+  return (bq25798_chg_timer_t)readField(BQ25798_FIELD_CHG_TMR);
 }
 
 /*!
@@ -830,18 +1207,7 @@ bq25798_chg_timer_t Adafruit_BQ25798::getFastChargeTimer() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setFastChargeTimer(bq25798_chg_timer_t timer) {
-  if (timer > BQ25798_CHG_TMR_24HR) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits chg_tmr_bits =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 2, 1);
-
-  chg_tmr_bits.write((uint8_t)timer);
-
-  return true;
+  return setField(BQ25798_FIELD_CHG_TMR, timer);
 }
 
 /*!
@@ -849,12 +1215,7 @@ bool Adafruit_BQ25798::setFastChargeTimer(bq25798_chg_timer_t timer) {
  * @return True if timer half-rate is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getTimerHalfRateEnable() {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits tmr2x_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 0);
-
-  return tmr2x_bit.read() == 1;
+  return readField(BQ25798_FIELD_TMR2X_EN) == 1;
 }
 
 /*!
@@ -864,14 +1225,7 @@ bool Adafruit_BQ25798::getTimerHalfRateEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setTimerHalfRateEnable(bool enable) {
-  Adafruit_BusIO_Register timer_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TIMER_CONTROL);
-  Adafruit_BusIO_RegisterBits tmr2x_bit =
-      Adafruit_BusIO_RegisterBits(&timer_reg, 1, 0);
-
-  tmr2x_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_TMR2X_EN, enable ? 1 : 0);
 }
 
 /*!
@@ -879,12 +1233,7 @@ bool Adafruit_BQ25798::setTimerHalfRateEnable(bool enable) {
  * @return True if automatic OVP battery discharge is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getAutoOVPBattDischarge() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits auto_ibatdis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 7);
-
-  return auto_ibatdis_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_AUTO_IBATDIS) == 1;
 }
 
 /*!
@@ -893,14 +1242,7 @@ bool Adafruit_BQ25798::getAutoOVPBattDischarge() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setAutoOVPBattDischarge(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits auto_ibatdis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 7);
-
-  auto_ibatdis_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_AUTO_IBATDIS, enable ? 1 : 0);
 }
 
 /*!
@@ -908,12 +1250,7 @@ bool Adafruit_BQ25798::setAutoOVPBattDischarge(bool enable) {
  * @return True if force battery discharge is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getForceBattDischarge() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits force_ibatdis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 6);
-
-  return force_ibatdis_bit.read() == 1;
+  return readField(BQ25798_FIELD_FORCE_IBATDIS) == 1;
 }
 
 /*!
@@ -922,14 +1259,7 @@ bool Adafruit_BQ25798::getForceBattDischarge() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setForceBattDischarge(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits force_ibatdis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 6);
-
-  force_ibatdis_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_FORCE_IBATDIS, enable ? 1 : 0);
 }
 
 /*!
@@ -937,12 +1267,7 @@ bool Adafruit_BQ25798::setForceBattDischarge(bool enable) {
  * @return True if charging is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getChargeEnable() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_chg_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 5);
-
-  return en_chg_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_CHG) == 1;
 }
 
 /*!
@@ -951,14 +1276,7 @@ bool Adafruit_BQ25798::getChargeEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setChargeEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_chg_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 5);
-
-  en_chg_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_CHG, enable ? 1 : 0);
 }
 
 /*!
@@ -966,12 +1284,7 @@ bool Adafruit_BQ25798::setChargeEnable(bool enable) {
  * @return True if ICO is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getICOEnable() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_ico_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 4);
-
-  return en_ico_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_ICO) == 1;
 }
 
 /*!
@@ -980,14 +1293,7 @@ bool Adafruit_BQ25798::getICOEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setICOEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_ico_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 4);
-
-  en_ico_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_ICO, enable ? 1 : 0);
 }
 
 /*!
@@ -995,12 +1301,7 @@ bool Adafruit_BQ25798::setICOEnable(bool enable) {
  * @return True if force ICO is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getForceICO() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits force_ico_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 3);
-
-  return force_ico_bit.read() == 1;
+  return readField(BQ25798_FIELD_FORCE_ICO) == 1;
 }
 
 /*!
@@ -1009,14 +1310,7 @@ bool Adafruit_BQ25798::getForceICO() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setForceICO(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits force_ico_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 3);
-
-  force_ico_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_FORCE_ICO, enable ? 1 : 0);
 }
 
 /*!
@@ -1024,12 +1318,7 @@ bool Adafruit_BQ25798::setForceICO(bool enable) {
  * @return True if HIZ mode is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getHIZMode() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_hiz_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 2);
-
-  return en_hiz_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_HIZ) == 1;
 }
 
 /*!
@@ -1038,14 +1327,7 @@ bool Adafruit_BQ25798::getHIZMode() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setHIZMode(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_hiz_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 2);
-
-  en_hiz_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_HIZ, enable ? 1 : 0);
 }
 
 /*!
@@ -1053,12 +1335,7 @@ bool Adafruit_BQ25798::setHIZMode(bool enable) {
  * @return True if charge termination is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getTerminationEnable() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_term_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 1);
-
-  return en_term_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_TERM) == 1;
 }
 
 /*!
@@ -1068,14 +1345,7 @@ bool Adafruit_BQ25798::getTerminationEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setTerminationEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_term_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 1);
-
-  en_term_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_TERM, enable ? 1 : 0);
 }
 
 /*!
@@ -1083,12 +1353,7 @@ bool Adafruit_BQ25798::setTerminationEnable(bool enable) {
  * @return True if backup mode is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getBackupModeEnable() {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_backup_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 0);
-
-  return en_backup_bit.read() == 1;
+  return readField(BQ25798_FIELD_EN_BACKUP) == 1;
 }
 
 /*!
@@ -1097,14 +1362,7 @@ bool Adafruit_BQ25798::getBackupModeEnable() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setBackupModeEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl0_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_0);
-  Adafruit_BusIO_RegisterBits en_backup_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl0_reg, 1, 0);
-
-  en_backup_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_EN_BACKUP, enable ? 1 : 0);
 }
 
 /*!
@@ -1112,14 +1370,7 @@ bool Adafruit_BQ25798::setBackupModeEnable(bool enable) {
  * @return Backup mode threshold setting
  */
 bq25798_vbus_backup_t Adafruit_BQ25798::getBackupModeThresh() {
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits vbus_backup_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 2, 6);
-
-  uint8_t reg_value = vbus_backup_bits.read();
-
-  return (bq25798_vbus_backup_t)reg_value;
+  return (bq25798_vbus_backup_t)readField(BQ25798_FIELD_VBUS_BACKUP);
 }
 
 /*!
@@ -1128,18 +1379,7 @@ bq25798_vbus_backup_t Adafruit_BQ25798::getBackupModeThresh() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setBackupModeThresh(bq25798_vbus_backup_t threshold) {
-  if (threshold > BQ25798_VBUS_BACKUP_100_PERCENT) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits vbus_backup_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 2, 6);
-
-  vbus_backup_bits.write((uint8_t)threshold);
-
-  return true;
+  return setField(BQ25798_FIELD_VBUS_BACKUP, threshold);
 }
 
 /*!
@@ -1147,14 +1387,7 @@ bool Adafruit_BQ25798::setBackupModeThresh(bq25798_vbus_backup_t threshold) {
  * @return VAC OVP threshold setting
  */
 bq25798_vac_ovp_t Adafruit_BQ25798::getVACOVP() {
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits vac_ovp_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 2, 4);
-
-  uint8_t reg_value = vac_ovp_bits.read();
-
-  return (bq25798_vac_ovp_t)reg_value;
+  return (bq25798_vac_ovp_t)readField(BQ25798_FIELD_VAC_OVP);
 }
 
 /*!
@@ -1163,18 +1396,7 @@ bq25798_vac_ovp_t Adafruit_BQ25798::getVACOVP() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setVACOVP(bq25798_vac_ovp_t threshold) {
-  if (threshold > BQ25798_VAC_OVP_7V) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits vac_ovp_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 2, 4);
-
-  vac_ovp_bits.write((uint8_t)threshold);
-
-  return true;
+  return setField(BQ25798_FIELD_VAC_OVP, threshold);
 }
 
 /*!
@@ -1182,14 +1404,45 @@ bool Adafruit_BQ25798::setVACOVP(bq25798_vac_ovp_t threshold) {
  * @return True if successful
  */
 bool Adafruit_BQ25798::resetWDT() {
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits wd_rst_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 1, 3);
+  return writeField(BQ25798_FIELD_WD_RST, 1);
+}
 
-  wd_rst_bit.write(1);
+/*!
+ * @brief Watchdog period for a WATCHDOG field code
+ * @param code Field code, bq25798_wdt_t
+ * @return Period in milliseconds, 0 if disabled or unknown
+ */
+static uint32_t wdtPeriodMs(uint8_t code) {
+  static const uint32_t periods[] = {0,     500,   1000,  2000,
+                                     20000, 40000, 80000, 160000};
+  return code < 8 ? periods[code] : 0;
+}
 
-  return true;
+/*!
+ * @brief Keep the charger's watchdog from expiring; call from the main loop
+ *
+ * The driver follows the WATCHDOG setting and every WD_RST written, however
+ * it got there. From half the period on, any write that covers or borders
+ * REG_CHARGER_CONTROL_1 carries WD_RST for free (bordering writes need the
+ * register cache). Only if nothing did by three quarters of the period does
+ * service() write WD_RST itself, so call it at least every quarter period.
+ * The first call after a warm begin() reads the setting and kicks at once.
+ *
+ * @return True if successful, false on a bus error
+ */
+bool Adafruit_BQ25798::service() {
+  if (wdt_code == 0xFF) {
+    uint8_t value;
+    if (!readRegisters(BQ25798_REG_CHARGER_CONTROL_1, &value, 1)) {
+      return false;
+    }
+  }
+
+  if (!watchdogDue(3)) {
+    return true;
+  }
+
+  return resetWDT();
 }
 
 /*!
@@ -1197,14 +1450,7 @@ bool Adafruit_BQ25798::resetWDT() {
  * @return Watchdog timer setting
  */
 bq25798_wdt_t Adafruit_BQ25798::getWDT() {
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits watchdog_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 3, 0);
-
-  uint8_t reg_value = watchdog_bits.read();
-
-  return (bq25798_wdt_t)reg_value;
+  return (bq25798_wdt_t)readField(BQ25798_FIELD_WATCHDOG);
 }
 
 /*!
@@ -1213,18 +1459,7 @@ bq25798_wdt_t Adafruit_BQ25798::getWDT() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setWDT(bq25798_wdt_t timer) {
-  if (timer > BQ25798_WDT_160S) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register chg_ctrl1_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_1);
-  Adafruit_BusIO_RegisterBits watchdog_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl1_reg, 3, 0);
-
-  watchdog_bits.write((uint8_t)timer);
-
-  return true;
+  return setField(BQ25798_FIELD_WATCHDOG, timer);
 }
 
 /*!
@@ -1232,12 +1467,7 @@ bool Adafruit_BQ25798::setWDT(bq25798_wdt_t timer) {
  * @return True if force D+/D- detection is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getForceDPinsDetection() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits force_indet_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 7);
-
-  return force_indet_bit.read() == 1;
+  return readField(BQ25798_FIELD_FORCE_INDET) == 1;
 }
 
 /*!
@@ -1246,14 +1476,7 @@ bool Adafruit_BQ25798::getForceDPinsDetection() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setForceDPinsDetection(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits force_indet_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 7);
-
-  force_indet_bit.write(enable ? 1 : 0);
-
-  return true;
+  return writeField(BQ25798_FIELD_FORCE_INDET, enable ? 1 : 0);
 }
 
 /*!
@@ -1261,12 +1484,7 @@ bool Adafruit_BQ25798::setForceDPinsDetection(bool enable) {
  * @return True if auto D+/D- detection is enabled, false if disabled
  */
 bool Adafruit_BQ25798::getAutoDPinsDetection() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits auto_indet_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 6);
-
-  return auto_indet_bit.read() == 1;
+  return readField(BQ25798_FIELD_AUTO_INDET_EN) == 1;
 }
 
 /*!
@@ -1275,1136 +1493,2100 @@ bool Adafruit_BQ25798::getAutoDPinsDetection() {
  * @return True if successful
  */
 bool Adafruit_BQ25798::setAutoDPinsDetection(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits auto_indet_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 6);
+  return writeField(BQ25798_FIELD_AUTO_INDET_EN, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the HVDCP 12V enable setting
+ * @return True if HVDCP 12V is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getHVDCP12VEnable() {
+  return readField(BQ25798_FIELD_EN_12V) == 1;
+}
 
-  auto_indet_bit.write(enable ? 1 : 0);
+/*!
+ * @brief Set the HVDCP 12V enable
+ * @param enable True = enable HVDCP 12V, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setHVDCP12VEnable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_12V, enable ? 1 : 0);
+}
 
-  return true;
+/*!
+ * @brief Get the HVDCP 9V enable setting
+ * @return True if HVDCP 9V is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getHVDCP9VEnable() {
+  return readField(BQ25798_FIELD_EN_9V) == 1;
+}
+
+/*!
+ * @brief Set the HVDCP 9V enable
+ * @param enable True = enable HVDCP 9V, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setHVDCP9VEnable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_9V, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the HVDCP enable setting
+ * @return True if HVDCP is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getHVDCPEnable() {
+  return readField(BQ25798_FIELD_HVDCP_EN) == 1;
+}
+
+/*!
+ * @brief Set the HVDCP enable
+ * @param enable True = enable HVDCP, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setHVDCPEnable(bool enable) {
+  return writeField(BQ25798_FIELD_HVDCP_EN, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the ship FET mode setting
+ * @return Ship FET mode setting
+ */
+bq25798_sdrv_ctrl_t Adafruit_BQ25798::getShipFETmode() {
+  return (bq25798_sdrv_ctrl_t)readField(BQ25798_FIELD_SDRV_CTRL);
+}
+
+/*!
+ * @brief Set the ship FET mode
+ * @param mode Ship FET mode setting (IDLE, Shutdown, Ship, System Reset)
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setShipFETmode(bq25798_sdrv_ctrl_t mode) {
+  return setField(BQ25798_FIELD_SDRV_CTRL, mode);
+}
+
+/*!
+ * @brief Get the ship FET 10s delay setting
+ * @return True if ship FET 10s delay is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getShipFET10sDelay() {
+  return readField(BQ25798_FIELD_SDRV_DLY) == 1;
+}
+
+/*!
+ * @brief Set the ship FET 10s delay
+ * @param enable True = enable 10s delay, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setShipFET10sDelay(bool enable) {
+  return writeField(BQ25798_FIELD_SDRV_DLY, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the AC driver enable setting
+ * @return True if AC driver is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getACenable() {
+  // Invert the DIS_ACDRV bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_ACDRV) == 0;
+}
+
+/*!
+ * @brief Set the AC driver enable
+ * @param enable True = enable AC driver, false = disable AC driver
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setACenable(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_ACDRV, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the OTG enable setting
+ * @return True if OTG is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getOTGenable() {
+  return readField(BQ25798_FIELD_EN_OTG) == 1;
+}
+
+/*!
+ * @brief Set the OTG enable
+ * @param enable True = enable OTG, false = disable OTG
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setOTGenable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_OTG, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the OTG PFM enable setting
+ * @return True if OTG PFM is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getOTGPFM() {
+  // Invert the PFM_OTG_DIS bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_PFM_OTG_DIS) == 0;
+}
+
+/*!
+ * @brief Set the OTG PFM enable
+ * @param enable True = enable OTG PFM, false = disable OTG PFM
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setOTGPFM(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_PFM_OTG_DIS, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the forward PFM enable setting
+ * @return True if forward PFM is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getForwardPFM() {
+  // Invert the PFM_FWD_DIS bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_PFM_FWD_DIS) == 0;
+}
+
+/*!
+ * @brief Set the forward PFM enable
+ * @param enable True = enable forward PFM, false = disable forward PFM
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setForwardPFM(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_PFM_FWD_DIS, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the ship mode wakeup delay setting
+ * @return Ship mode wakeup delay setting
+ */
+bq25798_wkup_dly_t Adafruit_BQ25798::getShipWakeupDelay() {
+  return (bq25798_wkup_dly_t)readField(BQ25798_FIELD_WKUP_DLY);
+}
+
+/*!
+ * @brief Set the ship mode wakeup delay
+ * @param delay Ship mode wakeup delay setting (1s or 15ms)
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setShipWakeupDelay(bq25798_wkup_dly_t delay) {
+  return setField(BQ25798_FIELD_WKUP_DLY, delay);
+}
+
+/*!
+ * @brief Get the BATFET LDO precharge enable setting
+ * @return True if BATFET LDO precharge is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getBATFETLDOprecharge() {
+  // Invert the DIS_LDO bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_LDO) == 0;
+}
+
+/*!
+ * @brief Set the BATFET LDO precharge enable
+ * @param enable True = enable BATFET LDO precharge, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setBATFETLDOprecharge(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_LDO, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the OTG out-of-audio enable setting
+ * @return True if OTG OOA is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getOTGOOA() {
+  // Invert the DIS_OTG_OOA bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_OTG_OOA) == 0;
+}
+
+/*!
+ * @brief Set the OTG out-of-audio enable
+ * @param enable True = enable OTG OOA, false = disable OTG OOA
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setOTGOOA(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_OTG_OOA, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the forward out-of-audio enable setting
+ * @return True if forward OOA is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getForwardOOA() {
+  // Invert the DIS_FWD_OOA bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_FWD_OOA) == 0;
+}
+
+/*!
+ * @brief Set the forward out-of-audio enable
+ * @param enable True = enable forward OOA, false = disable forward OOA
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setForwardOOA(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_FWD_OOA, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the ACDRV2 enable setting
+ * @return True if ACDRV2 is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getACDRV2enable() {
+  return readField(BQ25798_FIELD_EN_ACDRV2) == 1;
+}
+
+/*!
+ * @brief Set the ACDRV2 enable
+ * @param enable True = enable ACDRV2, false = disable ACDRV2
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setACDRV2enable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_ACDRV2, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the ACDRV1 enable setting
+ * @return True if ACDRV1 is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getACDRV1enable() {
+  return readField(BQ25798_FIELD_EN_ACDRV1) == 1;
+}
+
+/*!
+ * @brief Set the ACDRV1 enable
+ * @param enable True = enable ACDRV1, false = disable ACDRV1
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setACDRV1enable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_ACDRV1, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the PWM switching frequency setting
+ * @return PWM frequency setting
+ */
+bq25798_pwm_freq_t Adafruit_BQ25798::getPWMFrequency() {
+  return (bq25798_pwm_freq_t)readField(BQ25798_FIELD_PWM_FREQ);
+}
+
+/*!
+ * @brief Set the PWM switching frequency
+ * @param frequency PWM frequency setting (1.5MHz or 750kHz)
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setPWMFrequency(bq25798_pwm_freq_t frequency) {
+  return setField(BQ25798_FIELD_PWM_FREQ, frequency);
+}
+
+/*!
+ * @brief Get the STAT pin enable setting
+ * @return True if STAT pin is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getStatPinEnable() {
+  // Invert the DIS_STAT bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_STAT) == 0;
+}
+
+/*!
+ * @brief Set the STAT pin enable
+ * @param enable True = enable STAT pin, false = disable STAT pin
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setStatPinEnable(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_STAT, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the VSYS short protection enable setting
+ * @return True if VSYS short protection is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getVSYSshortProtect() {
+  // Invert the DIS_VSYS_SHORT bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_VSYS_SHORT) == 0;
+}
+
+/*!
+ * @brief Set the VSYS short protection enable
+ * @param enable True = enable VSYS short protection, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVSYSshortProtect(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_VSYS_SHORT, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Get the VOTG UVP protection enable setting
+ * @return True if VOTG UVP protection is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getVOTG_UVPProtect() {
+  // Invert the DIS_VOTG_UVP bit - 1 = disabled, 0 = enabled
+  return readField(BQ25798_FIELD_DIS_VOTG_UVP) == 0;
+}
+
+/*!
+ * @brief Set the VOTG UVP protection enable
+ * @param enable True = enable VOTG UVP protection, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVOTG_UVPProtect(bool enable) {
+  // Invert the enable logic - write 0 to enable, 1 to disable
+  return writeField(BQ25798_FIELD_DIS_VOTG_UVP, enable ? 0 : 1);
+}
+
+/*!
+ * @brief Set the VINDPM detection enable
+ * @param enable True = enable VINDPM detection, false = disable
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVINDPMdetection(bool enable) {
+  return writeField(BQ25798_FIELD_FORCE_VINDPM_DET, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the VINDPM detection enable setting
+ * @return True if VINDPM detection is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getVINDPMdetection() {
+  return readField(BQ25798_FIELD_FORCE_VINDPM_DET) == 1;
+}
+
+/*!
+ * @brief Get the IBUS OCP enable setting
+ * @return True if IBUS OCP is enabled, false if disabled
+ */
+bool Adafruit_BQ25798::getIBUS_OCPenable() {
+  return readField(BQ25798_FIELD_EN_IBUS_OCP) == 1;
+}
+
+/*!
+ * @brief Set the IBUS OCP enable
+ * @param enable True = enable IBUS OCP, false = disable IBUS OCP
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setIBUS_OCPenable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_IBUS_OCP, enable ? 1 : 0);
+}
+
+/*!
+ * @brief Get the ship FET present status
+ * @return True if ship FET is present
+ */
+bool Adafruit_BQ25798::getShipFETpresent() {
+  return readField(BQ25798_FIELD_SFET_PRESENT);
+}
+
+/*!
+ * @brief Set the ship FET present status
+ * @param enable True to set ship FET present
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setShipFETpresent(bool enable) {
+  return writeField(BQ25798_FIELD_SFET_PRESENT, enable);
+}
+
+/*!
+ * @brief Get the battery discharge sense enable status
+ * @return True if battery discharge sense is enabled
+ */
+bool Adafruit_BQ25798::getBatDischargeSenseEnable() {
+  return readField(BQ25798_FIELD_EN_IBAT);
+}
+
+/*!
+ * @brief Set the battery discharge sense enable status
+ * @param enable True to enable battery discharge sense
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setBatDischargeSenseEnable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_IBAT, enable);
+}
+
+/*!
+ * @brief Get the battery discharge current regulation setting
+ * @return Current regulation setting
+ */
+bq25798_ibat_reg_t Adafruit_BQ25798::getBatDischargeA() {
+  return (bq25798_ibat_reg_t)readField(BQ25798_FIELD_IBAT_REG);
+}
+
+/*!
+ * @brief Set the battery discharge current regulation setting
+ * @param current Current regulation setting
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setBatDischargeA(bq25798_ibat_reg_t current) {
+  return writeField(BQ25798_FIELD_IBAT_REG, current);
+}
+
+/*!
+ * @brief Get the IINDPM enable status
+ * @return True if IINDPM is enabled
+ */
+bool Adafruit_BQ25798::getIINDPMenable() {
+  return readField(BQ25798_FIELD_EN_IINDPM);
+}
+
+/*!
+ * @brief Set the IINDPM enable status
+ * @param enable True to enable IINDPM
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setIINDPMenable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_IINDPM, enable);
+}
+
+/*!
+ * @brief Get the external ILIM pin enable status
+ * @return True if external ILIM pin is enabled
+ */
+bool Adafruit_BQ25798::getExtILIMpin() {
+  return readField(BQ25798_FIELD_EN_EXTILIM);
+}
+
+/*!
+ * @brief Set the external ILIM pin enable status
+ * @param enable True to enable external ILIM pin
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setExtILIMpin(bool enable) {
+  return writeField(BQ25798_FIELD_EN_EXTILIM, enable);
+}
+
+/*!
+ * @brief Get the battery discharge OCP enable status
+ * @return True if battery discharge OCP is enabled
+ */
+bool Adafruit_BQ25798::getBatDischargeOCPenable() {
+  return readField(BQ25798_FIELD_EN_BATOC);
+}
+
+/*!
+ * @brief Set the battery discharge OCP enable status
+ * @param enable True to enable battery discharge OCP
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setBatDischargeOCPenable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_BATOC, enable);
+}
+
+/*!
+ * @brief Get the VINDPM VOC percentage setting
+ * @return VOC percentage setting
+ */
+bq25798_voc_pct_t Adafruit_BQ25798::getVINDPM_VOCpercent() {
+  return (bq25798_voc_pct_t)readField(BQ25798_FIELD_VOC_PCT);
+}
+
+/*!
+ * @brief Set the VINDPM VOC percentage setting
+ * @param percentage VOC percentage setting
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVINDPM_VOCpercent(bq25798_voc_pct_t percentage) {
+  return writeField(BQ25798_FIELD_VOC_PCT, percentage);
+}
+
+/*!
+ * @brief Get the VOC delay time setting
+ * @return VOC delay setting
+ */
+bq25798_voc_dly_t Adafruit_BQ25798::getVOCdelay() {
+  return (bq25798_voc_dly_t)readField(BQ25798_FIELD_VOC_DLY);
+}
+
+/*!
+ * @brief Set the VOC delay time setting
+ * @param delay VOC delay setting
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVOCdelay(bq25798_voc_dly_t delay) {
+  return writeField(BQ25798_FIELD_VOC_DLY, delay);
+}
+
+/*!
+ * @brief Get the VOC measurement rate setting
+ * @return VOC rate setting
+ */
+bq25798_voc_rate_t Adafruit_BQ25798::getVOCrate() {
+  return (bq25798_voc_rate_t)readField(BQ25798_FIELD_VOC_RATE);
+}
+
+/*!
+ * @brief Set the VOC measurement rate setting
+ * @param rate VOC rate setting
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVOCrate(bq25798_voc_rate_t rate) {
+  return writeField(BQ25798_FIELD_VOC_RATE, rate);
+}
+
+/*!
+ * @brief Get the MPPT enable status
+ * @return True if MPPT is enabled
+ */
+bool Adafruit_BQ25798::getMPPTenable() {
+  return readField(BQ25798_FIELD_EN_MPPT);
+}
+
+/*!
+ * @brief Set the MPPT enable status
+ * @param enable True to enable MPPT
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setMPPTenable(bool enable) {
+  return writeField(BQ25798_FIELD_EN_MPPT, enable);
+}
+
+/*!
+ * @brief Get the thermal regulation threshold setting
+ * @return Thermal regulation threshold setting
+ */
+bq25798_treg_t Adafruit_BQ25798::getThermRegulationThresh() {
+  return (bq25798_treg_t)readField(BQ25798_FIELD_TREG);
+}
+
+/*!
+ * @brief Set the thermal regulation threshold setting
+ * @param threshold Thermal regulation threshold setting
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setThermRegulationThresh(bq25798_treg_t threshold) {
+  return writeField(BQ25798_FIELD_TREG, threshold);
+}
+
+/*!
+ * @brief Get the thermal shutdown threshold setting
+ * @return Thermal shutdown threshold setting
+ */
+bq25798_tshut_t Adafruit_BQ25798::getThermShutdownThresh() {
+  return (bq25798_tshut_t)readField(BQ25798_FIELD_TSHUT);
+}
+
+/*!
+ * @brief Set the thermal shutdown threshold setting
+ * @param threshold Thermal shutdown threshold setting
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setThermShutdownThresh(bq25798_tshut_t threshold) {
+  return writeField(BQ25798_FIELD_TSHUT, threshold);
+}
+
+/*!
+ * @brief Get the VBUS pulldown enable status
+ * @return True if VBUS pulldown is enabled
+ */
+bool Adafruit_BQ25798::getVBUSpulldown() {
+  return readField(BQ25798_FIELD_VBUS_PD_EN);
+}
+
+/*!
+ * @brief Set the VBUS pulldown enable status
+ * @param enable True to enable VBUS pulldown
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVBUSpulldown(bool enable) {
+  return writeField(BQ25798_FIELD_VBUS_PD_EN, enable);
+}
+
+/*!
+ * @brief Get the VAC1 pulldown enable status
+ * @return True if VAC1 pulldown is enabled
+ */
+bool Adafruit_BQ25798::getVAC1pulldown() {
+  return readField(BQ25798_FIELD_VAC1_PD_EN);
+}
+
+/*!
+ * @brief Set the VAC1 pulldown enable status
+ * @param enable True to enable VAC1 pulldown
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVAC1pulldown(bool enable) {
+  return writeField(BQ25798_FIELD_VAC1_PD_EN, enable);
+}
+
+/*!
+ * @brief Get the VAC2 pulldown enable status
+ * @return True if VAC2 pulldown is enabled
+ */
+bool Adafruit_BQ25798::getVAC2pulldown() {
+  return readField(BQ25798_FIELD_VAC2_PD_EN);
+}
+
+/*!
+ * @brief Set the VAC2 pulldown enable status
+ * @param enable True to enable VAC2 pulldown
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setVAC2pulldown(bool enable) {
+  return writeField(BQ25798_FIELD_VAC2_PD_EN, enable);
+}
+
+/*!
+ * @brief Get the backup ACFET1 on status
+ * @return True if backup ACFET1 is on
+ */
+bool Adafruit_BQ25798::getBackupACFET1on() {
+  return readField(BQ25798_FIELD_BKUP_ACFET1_ON);
+}
+
+/*!
+ * @brief Set the backup ACFET1 on status
+ * @param enable True to turn on backup ACFET1
+ * @return True if successful
+ */
+bool Adafruit_BQ25798::setBackupACFET1on(bool enable) {
+  return writeField(BQ25798_FIELD_BKUP_ACFET1_ON, enable);
 }
 
 /*!
- * @brief Get the HVDCP 12V enable setting
- * @return True if HVDCP 12V is enabled, false if disabled
+ * @brief Get the charge voltage used in the JEITA warm region
+ * @return JEITA warm region voltage setting
  */
-bool Adafruit_BQ25798::getHVDCP12VEnable() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits en_12v_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 5);
-
-  return en_12v_bit.read() == 1;
+bq25798_jeita_vset_t Adafruit_BQ25798::getJEITAWarmVoltage() {
+  return (bq25798_jeita_vset_t)readField(BQ25798_FIELD_JEITA_VSET);
 }
 
 /*!
- * @brief Set the HVDCP 12V enable
- * @param enable True = enable HVDCP 12V, false = disable
+ * @brief Set the charge voltage used in the JEITA warm region
+ * @param setting JEITA warm region voltage setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setHVDCP12VEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits en_12v_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 5);
-
-  en_12v_bit.write(enable ? 1 : 0);
-
-  return true;
+bool Adafruit_BQ25798::setJEITAWarmVoltage(bq25798_jeita_vset_t setting) {
+  return writeField(BQ25798_FIELD_JEITA_VSET, setting);
 }
 
 /*!
- * @brief Get the HVDCP 9V enable setting
- * @return True if HVDCP 9V is enabled, false if disabled
+ * @brief Get the charge current used in the JEITA warm region
+ * @return JEITA warm region current setting
  */
-bool Adafruit_BQ25798::getHVDCP9VEnable() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits en_9v_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 4);
-
-  return en_9v_bit.read() == 1;
+bq25798_jeita_iset_t Adafruit_BQ25798::getJEITAWarmCurrent() {
+  return (bq25798_jeita_iset_t)readField(BQ25798_FIELD_JEITA_ISETH);
 }
 
 /*!
- * @brief Set the HVDCP 9V enable
- * @param enable True = enable HVDCP 9V, false = disable
+ * @brief Set the charge current used in the JEITA warm region
+ * @param setting JEITA warm region current setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setHVDCP9VEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits en_9v_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 4);
-
-  en_9v_bit.write(enable ? 1 : 0);
-
-  return true;
+bool Adafruit_BQ25798::setJEITAWarmCurrent(bq25798_jeita_iset_t setting) {
+  return writeField(BQ25798_FIELD_JEITA_ISETH, setting);
 }
 
 /*!
- * @brief Get the HVDCP enable setting
- * @return True if HVDCP is enabled, false if disabled
+ * @brief Get the charge current used in the JEITA cool region
+ * @return JEITA cool region current setting
  */
-bool Adafruit_BQ25798::getHVDCPEnable() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits hvdcp_en_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 3);
-
-  return hvdcp_en_bit.read() == 1;
+bq25798_jeita_iset_t Adafruit_BQ25798::getJEITACoolCurrent() {
+  return (bq25798_jeita_iset_t)readField(BQ25798_FIELD_JEITA_ISETC);
 }
 
 /*!
- * @brief Set the HVDCP enable
- * @param enable True = enable HVDCP, false = disable
+ * @brief Set the charge current used in the JEITA cool region
+ * @param setting JEITA cool region current setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setHVDCPEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits hvdcp_en_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 3);
-
-  hvdcp_en_bit.write(enable ? 1 : 0);
-
-  return true;
+bool Adafruit_BQ25798::setJEITACoolCurrent(bq25798_jeita_iset_t setting) {
+  return writeField(BQ25798_FIELD_JEITA_ISETC, setting);
 }
 
 /*!
- * @brief Get the ship FET mode setting
- * @return Ship FET mode setting
+ * @brief Get the JEITA cool temperature threshold (T2)
+ * @return Cool threshold setting
  */
-bq25798_sdrv_ctrl_t Adafruit_BQ25798::getShipFETmode() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits sdrv_ctrl_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 2, 1);
-
-  uint8_t reg_value = sdrv_ctrl_bits.read();
-
-  return (bq25798_sdrv_ctrl_t)reg_value;
+bq25798_ts_cool_t Adafruit_BQ25798::getTSCoolThresh() {
+  return (bq25798_ts_cool_t)readField(BQ25798_FIELD_TS_COOL);
 }
 
 /*!
- * @brief Set the ship FET mode
- * @param mode Ship FET mode setting (IDLE, Shutdown, Ship, System Reset)
+ * @brief Set the JEITA cool temperature threshold (T2)
+ * @param threshold Cool threshold setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setShipFETmode(bq25798_sdrv_ctrl_t mode) {
-  if (mode > BQ25798_SDRV_SYSTEM_RESET) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits sdrv_ctrl_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 2, 1);
-
-  sdrv_ctrl_bits.write((uint8_t)mode);
-
-  return true;
+bool Adafruit_BQ25798::setTSCoolThresh(bq25798_ts_cool_t threshold) {
+  return writeField(BQ25798_FIELD_TS_COOL, threshold);
 }
 
 /*!
- * @brief Get the ship FET 10s delay setting
- * @return True if ship FET 10s delay is enabled, false if disabled
+ * @brief Get the JEITA warm temperature threshold (T3)
+ * @return Warm threshold setting
  */
-bool Adafruit_BQ25798::getShipFET10sDelay() {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits sdrv_dly_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 0);
-
-  return sdrv_dly_bit.read() == 1;
+bq25798_ts_warm_t Adafruit_BQ25798::getTSWarmThresh() {
+  return (bq25798_ts_warm_t)readField(BQ25798_FIELD_TS_WARM);
 }
 
 /*!
- * @brief Set the ship FET 10s delay
- * @param enable True = enable 10s delay, false = disable
+ * @brief Set the JEITA warm temperature threshold (T3)
+ * @param threshold Warm threshold setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setShipFET10sDelay(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl2_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_2);
-  Adafruit_BusIO_RegisterBits sdrv_dly_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl2_reg, 1, 0);
-
-  sdrv_dly_bit.write(enable ? 1 : 0);
-
-  return true;
+bool Adafruit_BQ25798::setTSWarmThresh(bq25798_ts_warm_t threshold) {
+  return writeField(BQ25798_FIELD_TS_WARM, threshold);
 }
 
 /*!
- * @brief Get the AC driver enable setting
- * @return True if AC driver is enabled, false if disabled
+ * @brief Get the OTG mode hot temperature threshold
+ * @return OTG hot threshold setting
  */
-bool Adafruit_BQ25798::getACenable() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_acdrv_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 7);
-
-  // Invert the DIS_ACDRV bit - 1 = disabled, 0 = enabled
-  return dis_acdrv_bit.read() == 0;
+bq25798_bhot_t Adafruit_BQ25798::getOTGHotThresh() {
+  return (bq25798_bhot_t)readField(BQ25798_FIELD_BHOT);
 }
 
 /*!
- * @brief Set the AC driver enable
- * @param enable True = enable AC driver, false = disable AC driver
+ * @brief Set the OTG mode hot temperature threshold
+ * @param threshold OTG hot threshold setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setACenable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_acdrv_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 7);
-
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_acdrv_bit.write(enable ? 0 : 1);
-
-  return true;
+bool Adafruit_BQ25798::setOTGHotThresh(bq25798_bhot_t threshold) {
+  return writeField(BQ25798_FIELD_BHOT, threshold);
 }
 
 /*!
- * @brief Get the OTG enable setting
- * @return True if OTG is enabled, false if disabled
+ * @brief Get the OTG mode cold temperature threshold
+ * @return OTG cold threshold setting
  */
-bool Adafruit_BQ25798::getOTGenable() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits en_otg_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 6);
-
-  return en_otg_bit.read() == 1;
+bq25798_bcold_t Adafruit_BQ25798::getOTGColdThresh() {
+  return (bq25798_bcold_t)readField(BQ25798_FIELD_BCOLD);
 }
 
 /*!
- * @brief Set the OTG enable
- * @param enable True = enable OTG, false = disable OTG
+ * @brief Set the OTG mode cold temperature threshold
+ * @param threshold OTG cold threshold setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setOTGenable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits en_otg_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 6);
-
-  en_otg_bit.write(enable ? 1 : 0);
-
-  return true;
+bool Adafruit_BQ25798::setOTGColdThresh(bq25798_bcold_t threshold) {
+  return writeField(BQ25798_FIELD_BCOLD, threshold);
 }
 
 /*!
- * @brief Get the OTG PFM enable setting
- * @return True if OTG PFM is enabled, false if disabled
+ * @brief Get whether the TS pin is ignored
+ * @return True if charging and OTG ignore the TS pin
  */
-bool Adafruit_BQ25798::getOTGPFM() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits pfm_otg_dis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 5);
-
-  // Invert the PFM_OTG_DIS bit - 1 = disabled, 0 = enabled
-  return pfm_otg_dis_bit.read() == 0;
+bool Adafruit_BQ25798::getTSIgnore() {
+  return readField(BQ25798_FIELD_TS_IGNORE);
 }
 
 /*!
- * @brief Set the OTG PFM enable
- * @param enable True = enable OTG PFM, false = disable OTG PFM
+ * @brief Set whether the TS pin is ignored, for packs without a thermistor
+ * @param ignore True to ignore the TS pin
  * @return True if successful
  */
-bool Adafruit_BQ25798::setOTGPFM(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits pfm_otg_dis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 5);
-
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  pfm_otg_dis_bit.write(enable ? 0 : 1);
-
-  return true;
+bool Adafruit_BQ25798::setTSIgnore(bool ignore) {
+  return writeField(BQ25798_FIELD_TS_IGNORE, ignore);
 }
 
 /*!
- * @brief Get the forward PFM enable setting
- * @return True if forward PFM is enabled, false if disabled
+ * @brief Get the ADC enable setting
+ * @return True if the ADC is enabled
  */
-bool Adafruit_BQ25798::getForwardPFM() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits pfm_fwd_dis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 4);
-
-  // Invert the PFM_FWD_DIS bit - 1 = disabled, 0 = enabled
-  return pfm_fwd_dis_bit.read() == 0;
+bool Adafruit_BQ25798::getADCEnable() {
+  return readField(BQ25798_FIELD_ADC_EN) == 1;
 }
 
 /*!
- * @brief Set the forward PFM enable
- * @param enable True = enable forward PFM, false = disable forward PFM
+ * @brief Set the ADC enable. In one-shot mode the charger clears this bit
+ * once the conversion is complete.
+ * @param enable True to enable the ADC
  * @return True if successful
  */
-bool Adafruit_BQ25798::setForwardPFM(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits pfm_fwd_dis_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 4);
-
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  pfm_fwd_dis_bit.write(enable ? 0 : 1);
-
-  return true;
+bool Adafruit_BQ25798::setADCEnable(bool enable) {
+  return writeField(BQ25798_FIELD_ADC_EN, enable ? 1 : 0);
 }
 
 /*!
- * @brief Get the ship mode wakeup delay setting
- * @return Ship mode wakeup delay setting
+ * @brief Get the ADC conversion rate setting
+ * @return True if in one-shot mode, false if in continuous mode
  */
-bq25798_wkup_dly_t Adafruit_BQ25798::getShipWakeupDelay() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits wkup_dly_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 3);
-
-  uint8_t reg_value = wkup_dly_bit.read();
-
-  return (bq25798_wkup_dly_t)reg_value;
+bool Adafruit_BQ25798::getADCOneShot() {
+  return readField(BQ25798_FIELD_ADC_RATE) == 1;
 }
 
 /*!
- * @brief Set the ship mode wakeup delay
- * @param delay Ship mode wakeup delay setting (1s or 15ms)
+ * @brief Set the ADC conversion rate
+ * @param oneShot True = one-shot conversion, false = continuous conversion
  * @return True if successful
  */
-bool Adafruit_BQ25798::setShipWakeupDelay(bq25798_wkup_dly_t delay) {
-  if (delay > BQ25798_WKUP_DLY_15MS) {
-    return false;
-  }
-
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits wkup_dly_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 3);
-
-  wkup_dly_bit.write((uint8_t)delay);
-
-  return true;
+bool Adafruit_BQ25798::setADCOneShot(bool oneShot) {
+  return writeField(BQ25798_FIELD_ADC_RATE, oneShot ? 1 : 0);
 }
 
 /*!
- * @brief Get the BATFET LDO precharge enable setting
- * @return True if BATFET LDO precharge is enabled, false if disabled
+ * @brief Get the ADC sample speed / effective resolution setting
+ * @return ADC resolution setting
  */
-bool Adafruit_BQ25798::getBATFETLDOprecharge() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_ldo_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 2);
-
-  // Invert the DIS_LDO bit - 1 = disabled, 0 = enabled
-  return dis_ldo_bit.read() == 0;
+bq25798_adc_sample_t Adafruit_BQ25798::getADCResolution() {
+  return (bq25798_adc_sample_t)readField(BQ25798_FIELD_ADC_SAMPLE);
 }
 
 /*!
- * @brief Set the BATFET LDO precharge enable
- * @param enable True = enable BATFET LDO precharge, false = disable
+ * @brief Set the ADC sample speed / effective resolution. Each step down in
+ * resolution halves the conversion time.
+ * @param resolution ADC resolution setting
  * @return True if successful
  */
-bool Adafruit_BQ25798::setBATFETLDOprecharge(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_ldo_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 2);
-
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_ldo_bit.write(enable ? 0 : 1);
-
-  return true;
+bool Adafruit_BQ25798::setADCResolution(bq25798_adc_sample_t resolution) {
+  return setField(BQ25798_FIELD_ADC_SAMPLE, resolution);
 }
 
 /*!
- * @brief Get the OTG out-of-audio enable setting
- * @return True if OTG OOA is enabled, false if disabled
+ * @brief Get the ADC averaging setting
+ * @return True if running average is enabled, false for single values
  */
-bool Adafruit_BQ25798::getOTGOOA() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_otg_ooa_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 1);
-
-  // Invert the DIS_OTG_OOA bit - 1 = disabled, 0 = enabled
-  return dis_otg_ooa_bit.read() == 0;
+bool Adafruit_BQ25798::getADCAverage() {
+  return readField(BQ25798_FIELD_ADC_AVG) == 1;
 }
 
 /*!
- * @brief Set the OTG out-of-audio enable
- * @param enable True = enable OTG OOA, false = disable OTG OOA
+ * @brief Set the ADC averaging control
+ * @param enable True = running average, false = single value
  * @return True if successful
  */
-bool Adafruit_BQ25798::setOTGOOA(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_otg_ooa_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 1);
-
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_otg_ooa_bit.write(enable ? 0 : 1);
-
-  return true;
+bool Adafruit_BQ25798::setADCAverage(bool enable) {
+  return writeField(BQ25798_FIELD_ADC_AVG, enable ? 1 : 0);
 }
 
 /*!
- * @brief Get the forward out-of-audio enable setting
- * @return True if forward OOA is enabled, false if disabled
+ * @brief Get the ADC average initial value setting
+ * @return True if averaging starts from a new conversion, false if it
+ * starts from the existing register value
  */
-bool Adafruit_BQ25798::getForwardOOA() {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_fwd_ooa_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 0);
-
-  // Invert the DIS_FWD_OOA bit - 1 = disabled, 0 = enabled
-  return dis_fwd_ooa_bit.read() == 0;
+bool Adafruit_BQ25798::getADCAverageInit() {
+  return readField(BQ25798_FIELD_ADC_AVG_INIT) == 1;
 }
 
 /*!
- * @brief Set the forward out-of-audio enable
- * @param enable True = enable forward OOA, false = disable forward OOA
+ * @brief Set the ADC average initial value control
+ * @param enable True = start averaging from a new conversion, false = start
+ * from the existing register value
  * @return True if successful
  */
-bool Adafruit_BQ25798::setForwardOOA(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl3_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_3);
-  Adafruit_BusIO_RegisterBits dis_fwd_ooa_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl3_reg, 1, 0);
-
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_fwd_ooa_bit.write(enable ? 0 : 1);
-
-  return true;
+bool Adafruit_BQ25798::setADCAverageInit(bool enable) {
+  return writeField(BQ25798_FIELD_ADC_AVG_INIT, enable ? 1 : 0);
 }
 
 /*!
- * @brief Get the ACDRV2 enable setting
- * @return True if ACDRV2 is enabled, false if disabled
+ * @brief Start a single ADC conversion cycle without waiting for it
+ *
+ * Sets ADC_EN and ADC_RATE together in one write, keeping the resolution
+ * and averaging settings. Poll getADCDone() (or wait for
+ * BQ25798_EVENT_ADC_DONE) and then fetch the results with readAllADC().
+ *
+ * @return True if successful
  */
-bool Adafruit_BQ25798::getACDRV2enable() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits en_acdrv2_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 7);
+bool Adafruit_BQ25798::startADCOneShot() {
+  static const bq25798_field_t fields[] = {BQ25798_FIELD_ADC_EN,
+                                          BQ25798_FIELD_ADC_RATE};
+  static const uint16_t values[] = {1, 1};
 
-  return en_acdrv2_bit.read() == 1;
+  // Both bits land in one register, so this is still a single write
+  return setFields(fields, values, 2);
 }
 
 /*!
- * @brief Set the ACDRV2 enable
- * @param enable True = enable ACDRV2, false = disable ACDRV2
- * @return True if successful
+ * @brief Check whether a one-shot ADC conversion has completed
+ * @return True if the conversion is complete (ADC_DONE_STAT)
  */
-bool Adafruit_BQ25798::setACDRV2enable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits en_acdrv2_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 7);
-
-  en_acdrv2_bit.write(enable ? 1 : 0);
-
-  return true;
+bool Adafruit_BQ25798::getADCDone() {
+  return readField(BQ25798_FIELD_ADC_DONE_STAT) == 1;
 }
 
 /*!
- * @brief Get the ACDRV1 enable setting
- * @return True if ACDRV1 is enabled, false if disabled
+ * @brief Get which ADC channels are disabled
+ * @return Disabled channels (BQ25798_ADC_CH_* bits), or 0 if the read failed
  */
-bool Adafruit_BQ25798::getACDRV1enable() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits en_acdrv1_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 6);
+uint16_t Adafruit_BQ25798::getADCDisableMask() {
+  uint8_t buffer[2];
+
+  if (!readRegisters(BQ25798_REG_ADC_FUNCTION_DISABLE_0, buffer, 2)) {
+    return 0;
+  }
 
-  return en_acdrv1_bit.read() == 1;
+  return (((uint16_t)buffer[0] << 8) | buffer[1]) & BQ25798_ADC_CH_ALL;
 }
 
 /*!
- * @brief Set the ACDRV1 enable
- * @param enable True = enable ACDRV1, false = disable ACDRV1
+ * @brief Disable ADC channels, writing both disable registers at once
+ *
+ * Disabled channels are skipped in every conversion cycle, which shortens
+ * the cycle by one conversion time per channel.
+ *
+ * @param channels Channels to disable (BQ25798_ADC_CH_* bits), 0 enables all
  * @return True if successful
  */
-bool Adafruit_BQ25798::setACDRV1enable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits en_acdrv1_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 6);
+bool Adafruit_BQ25798::setADCDisableMask(uint16_t channels) {
+  uint8_t buffer[2];
 
-  en_acdrv1_bit.write(enable ? 1 : 0);
+  channels &= BQ25798_ADC_CH_ALL;
+  buffer[0] = channels >> 8;
+  buffer[1] = channels & 0xFF;
 
-  return true;
+  return writeRegisters(BQ25798_REG_ADC_FUNCTION_DISABLE_0, buffer, 2);
 }
 
 /*!
- * @brief Get the PWM switching frequency setting
- * @return PWM frequency setting
- */
-bq25798_pwm_freq_t Adafruit_BQ25798::getPWMFrequency() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits pwm_freq_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 5);
-
-  uint8_t reg_value = pwm_freq_bit.read();
+ * @brief Estimate the duration of one full ADC conversion cycle
+ *
+ * Each enabled channel takes 24ms at 15-bit resolution, halving with each
+ * bit of resolution dropped (3ms at 12-bit).
+ *
+ * @param disabled Disabled channels (BQ25798_ADC_CH_* bits)
+ * @param resolution ADC resolution setting
+ * @return Typical conversion cycle time in milliseconds
+ */
+uint16_t Adafruit_BQ25798::getADCCycleTime(uint16_t disabled,
+                                           bq25798_adc_sample_t resolution) {
+  uint16_t enabled = BQ25798_ADC_CH_ALL & ~disabled;
+  uint8_t channels = 0;
+
+  while (enabled) {
+    enabled &= enabled - 1;
+    channels++;
+  }
 
-  return (bq25798_pwm_freq_t)reg_value;
+  return channels * (24 >> ((uint8_t)resolution & 0x03));
 }
 
 /*!
- * @brief Set the PWM switching frequency
- * @param frequency PWM frequency setting (1.5MHz or 750kHz)
+ * @brief Reset all registers to default values
  * @return True if successful
  */
-bool Adafruit_BQ25798::setPWMFrequency(bq25798_pwm_freq_t frequency) {
-  if (frequency > BQ25798_PWM_FREQ_750KHZ) {
+bool Adafruit_BQ25798::reset() {
+  // Staged changes would be wiped by the reset anyway
+  updating = false;
+
+  if (!writeField(BQ25798_FIELD_REG_RST, 1)) {
     return false;
   }
 
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits pwm_freq_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 5);
+  // The watchdog restarts at its default period
+  wdt_code = BQ25798_WDT_40S;
+  wdt_synced = true;
+  wdt_kicked_at = millis();
 
-  pwm_freq_bit.write((uint8_t)frequency);
+  if (cache_enabled) {
+    // Every control register just returned to its default
+    return refreshCache();
+  }
 
   return true;
 }
 
 /*!
- * @brief Get the STAT pin enable setting
- * @return True if STAT pin is enabled, false if disabled
+ * @brief Fields held by a bq25798_profile_t, in the order profileValues()
+ * lists them. All live in registers 0x00-0x18.
+ */
+static const bq25798_field_t profile_fields[] = {
+    BQ25798_FIELD_VSYSMIN,       BQ25798_FIELD_VREG,
+    BQ25798_FIELD_ICHG,          BQ25798_FIELD_VINDPM,
+    BQ25798_FIELD_IINDPM,        BQ25798_FIELD_IPRECHG,
+    BQ25798_FIELD_ITERM,         BQ25798_FIELD_VRECHG,
+    BQ25798_FIELD_VBAT_LOWV,     BQ25798_FIELD_CELL,
+    BQ25798_FIELD_PRECHG_TMR,    BQ25798_FIELD_TOPOFF_TMR,
+    BQ25798_FIELD_CHG_TMR,       BQ25798_FIELD_EN_TRICHG_TMR,
+    BQ25798_FIELD_EN_PRECHG_TMR, BQ25798_FIELD_EN_CHG_TMR,
+    BQ25798_FIELD_TMR2X_EN,      BQ25798_FIELD_JEITA_VSET,
+    BQ25798_FIELD_JEITA_ISETH,   BQ25798_FIELD_JEITA_ISETC,
+    BQ25798_FIELD_TS_COOL,       BQ25798_FIELD_TS_WARM,
+    BQ25798_FIELD_BHOT,          BQ25798_FIELD_BCOLD,
+    BQ25798_FIELD_TS_IGNORE,
+};
+
+/*!
+ * @brief Number of fields in a profile
+ */
+#define BQ25798_PROFILE_FIELDS \
+  (sizeof(profile_fields) / sizeof(profile_fields[0]))
+
+/*!
+ * @brief Flatten a profile into field values in profile_fields order
+ * @param profile Profile to read
+ * @param values Destination, BQ25798_PROFILE_FIELDS entries
+ */
+static void profileValues(const bq25798_profile_t& profile,
+                          uint16_t* values) {
+  uint16_t* v = values;
+
+  *v++ = profile.vsysmin_mV;
+  *v++ = profile.vreg_mV;
+  *v++ = profile.ichg_mA;
+  *v++ = profile.vindpm_mV;
+  *v++ = profile.iindpm_mA;
+  *v++ = profile.iprechg_mA;
+  *v++ = profile.iterm_mA;
+  *v++ = profile.vrechg_mV;
+  *v++ = profile.vbat_lowv;
+  *v++ = profile.cell_count;
+  *v++ = profile.prechg_timer;
+  *v++ = profile.topoff_timer;
+  *v++ = profile.chg_timer;
+  *v++ = profile.trickle_timer_enable;
+  *v++ = profile.prechg_timer_enable;
+  *v++ = profile.chg_timer_enable;
+  *v++ = profile.timer_half_rate;
+  *v++ = profile.jeita_vset;
+  *v++ = profile.jeita_iseth;
+  *v++ = profile.jeita_isetc;
+  *v++ = profile.ts_cool;
+  *v++ = profile.ts_warm;
+  *v++ = profile.bhot;
+  *v++ = profile.bcold;
+  *v++ = profile.ts_ignore;
+}
+
+/*!
+ * @brief Program a complete charge profile with as few writes as possible
+ *
+ * Every value is range checked first, then registers 0x00-0x18 are read in
+ * one burst (or taken from the register cache where it can be trusted) and
+ * the profile is merged in. Only registers whose contents change are
+ * written, each contiguous run of them in one burst, so applying the
+ * profile the charger already holds costs a single read. Both bytes of a
+ * 16-bit limit are written together.
+ *
+ * @param profile Settings to apply
+ * @return True if successful, false on a bus error or an out-of-range value
  */
-bool Adafruit_BQ25798::getStatPinEnable() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits dis_stat_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 4);
-
-  // Invert the DIS_STAT bit - 1 = disabled, 0 = enabled
-  return dis_stat_bit.read() == 0;
-}
+bool Adafruit_BQ25798::applyProfile(const bq25798_profile_t& profile) {
+  uint16_t values[BQ25798_PROFILE_FIELDS];
+  uint8_t current[BQ25798_FIELD_SPAN_MAX];
+  bq25798_field_plan_t plan;
+  bq25798_field_desc_t desc;
 
-/*!
- * @brief Set the STAT pin enable
- * @param enable True = enable STAT pin, false = disable STAT pin
- * @return True if successful
- */
-bool Adafruit_BQ25798::setStatPinEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits dis_stat_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 4);
+  profileValues(profile, values);
+  if (!planFields(profile_fields, values, BQ25798_PROFILE_FIELDS, plan)) {
+    return false;
+  }
+  if (!plan.cached && !readRegisters(plan.first, plan.buffer, plan.len)) {
+    return false;
+  }
 
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_stat_bit.write(enable ? 0 : 1);
+  memcpy(current, plan.buffer, plan.len);
+  mergeFields(profile_fields, values, BQ25798_PROFILE_FIELDS, plan);
 
-  return true;
-}
+  // Drop registers that already hold their target, keeping 16-bit pairs
+  // whole
+  uint8_t changed[BQ25798_FIELD_SPAN_MAX];
+  for (uint8_t i = 0; i < plan.len; i++) {
+    changed[i] = plan.buffer[i] != current[i];
+  }
+  for (uint8_t i = 0; i < BQ25798_PROFILE_FIELDS; i++) {
+    if (!fieldDesc(profile_fields[i], desc)) {
+      return false;
+    }
+    uint8_t at = desc.reg - plan.first;
+    if (fieldWidth(desc) == 2 && (changed[at] || changed[at + 1])) {
+      changed[at] = changed[at + 1] = true;
+    }
+  }
+  for (uint8_t i = 0; i < plan.len; i++) {
+    if (!changed[i]) {
+      plan.touched[i] = 0;
+    }
+  }
 
-/*!
- * @brief Get the VSYS short protection enable setting
- * @return True if VSYS short protection is enabled, false if disabled
- */
-bool Adafruit_BQ25798::getVSYSshortProtect() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits dis_vsys_short_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 3);
+  uint8_t pos = 0;
+  uint8_t run;
+  uint8_t len;
+  while (nextRun(plan, pos, run, len)) {
+    if (!writeRegisters(plan.first + run, plan.buffer + run, len)) {
+      return false;
+    }
+  }
 
-  // Invert the DIS_VSYS_SHORT bit - 1 = disabled, 0 = enabled
-  return dis_vsys_short_bit.read() == 0;
+  return true;
 }
 
 /*!
- * @brief Set the VSYS short protection enable
- * @param enable True = enable VSYS short protection, false = disable
+ * @brief Read the charger's current settings as a profile, in one burst
+ * @param profile Destination for the settings
  * @return True if successful
  */
-bool Adafruit_BQ25798::setVSYSshortProtect(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits dis_vsys_short_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 3);
+bool Adafruit_BQ25798::getProfile(bq25798_profile_t& profile) {
+  uint16_t values[BQ25798_PROFILE_FIELDS];
 
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_vsys_short_bit.write(enable ? 0 : 1);
+  if (!getFields(profile_fields, values, BQ25798_PROFILE_FIELDS)) {
+    return false;
+  }
 
-  return true;
+  const uint16_t* v = values;
+  profile.vsysmin_mV = *v++;
+  profile.vreg_mV = *v++;
+  profile.ichg_mA = *v++;
+  profile.vindpm_mV = *v++;
+  profile.iindpm_mA = *v++;
+  profile.iprechg_mA = *v++;
+  profile.iterm_mA = *v++;
+  profile.vrechg_mV = *v++;
+  profile.vbat_lowv = (bq25798_vbat_lowv_t)*v++;
+  profile.cell_count = (bq25798_cell_count_t)*v++;
+  profile.prechg_timer = (bq25798_prechg_timer_t)*v++;
+  profile.topoff_timer = (bq25798_topoff_timer_t)*v++;
+  profile.chg_timer = (bq25798_chg_timer_t)*v++;
+  profile.trickle_timer_enable = *v++;
+  profile.prechg_timer_enable = *v++;
+  profile.chg_timer_enable = *v++;
+  profile.timer_half_rate = *v++;
+  profile.jeita_vset = (bq25798_jeita_vset_t)*v++;
+  profile.jeita_iseth = (bq25798_jeita_iset_t)*v++;
+  profile.jeita_isetc = (bq25798_jeita_iset_t)*v++;
+  profile.ts_cool = (bq25798_ts_cool_t)*v++;
+  profile.ts_warm = (bq25798_ts_warm_t)*v++;
+  profile.bhot = (bq25798_bhot_t)*v++;
+  profile.bcold = (bq25798_bcold_t)*v++;
+  profile.ts_ignore = *v++;
+
+  return true;
+}
+
+/*!
+ * @brief Bits of the saved registers that a stored config must not carry:
+ * commands, modes that should not come back on by themselves after a
+ * restart, and the ACDRV enables the charger drives itself
+ * @param reg Register address
+ * @return Mask of bits saveConfig() clears and loadConfig() leaves alone
+ */
+static uint8_t configSkipBits(uint8_t reg) {
+  switch (reg) {
+    case BQ25798_REG_TERMINATION_CONTROL: // REG_RST
+      return 0x40;
+    case BQ25798_REG_CHARGER_CONTROL_0: // FORCE_ICO, EN_HIZ
+      return 0x0C;
+    case BQ25798_REG_CHARGER_CONTROL_1: // WD_RST
+      return 0x08;
+    case BQ25798_REG_CHARGER_CONTROL_2: // FORCE_INDET, SDRV_CTRL
+      return 0x86;
+    case BQ25798_REG_CHARGER_CONTROL_3: // EN_OTG
+      return 0x40;
+    case BQ25798_REG_CHARGER_CONTROL_4: // EN_ACDRV2/1, FORCE_VINDPM_DET
+      return 0xC2;
+    case BQ25798_REG_TEMPERATURE_CONTROL: // BKUP_ACFET1_ON
+      return 0x01;
+    default:
+      return 0x00;
+  }
 }
 
 /*!
- * @brief Get the VOTG UVP protection enable setting
- * @return True if VOTG UVP protection is enabled, false if disabled
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ * @param data Bytes to check
+ * @param len Number of bytes
+ * @return CRC of the bytes
  */
-bool Adafruit_BQ25798::getVOTG_UVPProtect() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits dis_votg_uvp_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 2);
+static uint16_t configCrc(const uint8_t* data, uint8_t len) {
+  uint16_t crc = 0xFFFF;
 
-  // Invert the DIS_VOTG_UVP bit - 1 = disabled, 0 = enabled
-  return dis_votg_uvp_bit.read() == 0;
+  for (uint8_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
 }
 
+static_assert(BQ25798_CONFIG_SIZE == 1 + BQ25798_CONFIG_REGS + 2,
+              "saved config is a version byte, the registers and a CRC");
+
 /*!
- * @brief Set the VOTG UVP protection enable
- * @param enable True = enable VOTG UVP protection, false = disable
+ * @brief Save the charger's configuration for storing in EEPROM or flash
+ *
+ * Registers 0x00-0x18 are read in one burst and stored after a version
+ * byte, followed by a big-endian CRC-16 of everything before it. Command
+ * bits, HIZ, OTG, ship FET and ACDRV control are stored as 0 and never
+ * restored.
+ *
+ * @param buffer Destination, BQ25798_CONFIG_SIZE bytes
  * @return True if successful
  */
-bool Adafruit_BQ25798::setVOTG_UVPProtect(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits dis_votg_uvp_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 2);
+bool Adafruit_BQ25798::saveConfig(uint8_t* buffer) {
+  uint8_t* regs = buffer + 1;
 
-  // Invert the enable logic - write 0 to enable, 1 to disable
-  dis_votg_uvp_bit.write(enable ? 0 : 1);
+  if (!readRegisters(0x00, regs, BQ25798_CONFIG_REGS)) {
+    return false;
+  }
+  for (uint8_t reg = 0; reg < BQ25798_CONFIG_REGS; reg++) {
+    regs[reg] &= ~configSkipBits(reg);
+  }
 
+  buffer[0] = BQ25798_CONFIG_VERSION;
+  uint16_t crc = configCrc(buffer, 1 + BQ25798_CONFIG_REGS);
+  buffer[1 + BQ25798_CONFIG_REGS] = crc >> 8;
+  buffer[2 + BQ25798_CONFIG_REGS] = crc & 0xFF;
   return true;
 }
 
 /*!
- * @brief Set the VINDPM detection enable
- * @param enable True = enable VINDPM detection, false = disable
- * @return True if successful
+ * @brief Restore a configuration from saveConfig()
+ *
+ * The blob's version and CRC are checked before anything touches the bus.
+ * The charger's registers are then read in one burst, and if they differ
+ * from the blob the span from the first to the last differing register is
+ * written back in one burst. A charger that already matches costs the
+ * single read.
+ *
+ * @param buffer Configuration, BQ25798_CONFIG_SIZE bytes
+ * @return True if the charger now holds the configuration, false for a
+ * corrupt or unknown blob or a bus error
  */
-bool Adafruit_BQ25798::setVINDPMdetection(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits force_vindpm_det_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 1);
+bool Adafruit_BQ25798::loadConfig(const uint8_t* buffer) {
+  uint8_t target[BQ25798_CONFIG_REGS];
+  uint8_t chip[BQ25798_CONFIG_REGS];
+
+  if (!readConfig(buffer, target, chip)) {
+    return false;
+  }
 
-  force_vindpm_det_bit.write(enable ? 1 : 0);
+  uint8_t first = 0;
+  uint8_t last = BQ25798_CONFIG_REGS;
+  while (first < BQ25798_CONFIG_REGS && target[first] == chip[first]) {
+    first++;
+  }
+  if (first == BQ25798_CONFIG_REGS) {
+    return true;
+  }
+  while (target[last - 1] == chip[last - 1]) {
+    last--;
+  }
 
-  return true;
+  return writeRegisters(first, target + first, last - first);
 }
 
 /*!
- * @brief Get the VINDPM detection enable setting
- * @return True if VINDPM detection is enabled, false if disabled
+ * @brief Check the charger against a configuration from saveConfig(), with
+ * one burst read
+ * @param buffer Configuration, BQ25798_CONFIG_SIZE bytes
+ * @return True if the blob is valid and the charger holds it
  */
-bool Adafruit_BQ25798::getVINDPMdetection() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits force_vindpm_det_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 1);
+bool Adafruit_BQ25798::verifyConfig(const uint8_t* buffer) {
+  uint8_t target[BQ25798_CONFIG_REGS];
+  uint8_t chip[BQ25798_CONFIG_REGS];
 
-  return force_vindpm_det_bit.read() == 1;
+  return readConfig(buffer, target, chip) &&
+         memcmp(target, chip, BQ25798_CONFIG_REGS) == 0;
 }
 
 /*!
- * @brief Get the IBUS OCP enable setting
- * @return True if IBUS OCP is enabled, false if disabled
+ * @brief Extract one big-endian ADC word from a burst of the ADC block
+ * @param buffer Bytes read starting at BQ25798_REG_IBUS_ADC
+ * @param reg Register address of the ADC channel MSB
+ * @return Raw 16-bit ADC value
  */
-bool Adafruit_BQ25798::getIBUS_OCPenable() {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits en_ibus_ocp_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 0);
-
-  return en_ibus_ocp_bit.read() == 1;
+static uint16_t adcWord(const uint8_t* buffer, uint8_t reg) {
+  const uint8_t* word = buffer + (reg - BQ25798_REG_IBUS_ADC);
+  return ((uint16_t)word[0] << 8) | word[1];
 }
 
 /*!
- * @brief Set the IBUS OCP enable
- * @param enable True = enable IBUS OCP, false = disable IBUS OCP
+ * @brief Read every ADC result register in one burst
+ *
+ * Fetches 0x31-0x46 in a single I2C transaction and decodes all eleven
+ * channels. The ADC must be enabled for the values to be updated.
+ *
+ * @param snapshot Destination for the decoded results
  * @return True if successful
  */
-bool Adafruit_BQ25798::setIBUS_OCPenable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl4_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_4);
-  Adafruit_BusIO_RegisterBits en_ibus_ocp_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl4_reg, 1, 0);
+bool Adafruit_BQ25798::readAllADC(bq25798_adc_snapshot_t& snapshot) {
+  uint8_t buffer[BQ25798_ADC_BLOCK_SIZE];
 
-  en_ibus_ocp_bit.write(enable ? 1 : 0);
+  if (!readRegisters(BQ25798_REG_IBUS_ADC, buffer, sizeof(buffer))) {
+    return false;
+  }
 
+  decodeADC(buffer, snapshot);
   return true;
 }
 
 /*!
- * @brief Get the ship FET present status
- * @return True if ship FET is present
+ * @brief Read the input voltage and current in one short burst
+ *
+ * Fetches IBUS through VBUS (0x31-0x36), 6 bytes instead of the whole ADC
+ * block, for loops that only watch input power.
+ *
+ * @param vbus_mV Destination for the VBUS voltage in mV
+ * @param ibus_mA Destination for the IBUS current in mA, positive into the
+ * charger
+ * @return True if successful
  */
-bool Adafruit_BQ25798::getShipFETpresent() {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits sfet_present_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 7);
+bool Adafruit_BQ25798::readInputADC(uint16_t& vbus_mV, int16_t& ibus_mA) {
+  uint8_t buffer[BQ25798_REG_VBUS_ADC + 2 - BQ25798_REG_IBUS_ADC];
+
+  if (!readRegisters(BQ25798_REG_IBUS_ADC, buffer, sizeof(buffer))) {
+    return false;
+  }
 
-  return sfet_present_bit.read();
+  ibus_mA = (int16_t)adcWord(buffer, BQ25798_REG_IBUS_ADC);
+  vbus_mV = adcWord(buffer, BQ25798_REG_VBUS_ADC);
+  return true;
 }
 
 /*!
- * @brief Set the ship FET present status
- * @param enable True to set ship FET present
+ * @brief Read the battery voltage and current in one short burst
+ *
+ * Fetches IBAT through VBAT (0x33-0x3C), 10 bytes instead of the whole ADC
+ * block, for loops that only track the battery.
+ *
+ * @param vbat_mV Destination for the VBAT voltage in mV
+ * @param ibat_mA Destination for the IBAT current in mA, positive while
+ * charging
  * @return True if successful
  */
-bool Adafruit_BQ25798::setShipFETpresent(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits sfet_present_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 7);
+bool Adafruit_BQ25798::readBatteryADC(uint16_t& vbat_mV, int16_t& ibat_mA) {
+  uint8_t buffer[BQ25798_REG_VBAT_ADC + 2 - BQ25798_REG_IBAT_ADC];
 
-  sfet_present_bit.write(enable);
+  if (!readRegisters(BQ25798_REG_IBAT_ADC, buffer, sizeof(buffer))) {
+    return false;
+  }
 
+  const uint8_t* vbat = buffer + (BQ25798_REG_VBAT_ADC - BQ25798_REG_IBAT_ADC);
+  ibat_mA = (int16_t)(((uint16_t)buffer[0] << 8) | buffer[1]);
+  vbat_mV = ((uint16_t)vbat[0] << 8) | vbat[1];
   return true;
 }
 
 /*!
- * @brief Get the battery discharge sense enable status
- * @return True if battery discharge sense is enabled
+ * @brief Decode a burst of the ADC result registers
+ * @param buffer BQ25798_ADC_BLOCK_SIZE bytes read from BQ25798_REG_IBUS_ADC
+ * @param snapshot Destination for the decoded results
  */
-bool Adafruit_BQ25798::getBatDischargeSenseEnable() {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_ibat_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 5);
-
-  return en_ibat_bit.read();
+void Adafruit_BQ25798::decodeADC(const uint8_t* buffer,
+                                 bq25798_adc_snapshot_t& snapshot) {
+  // Currents and die temperature are two's complement, the rest unsigned
+  snapshot.ibus_mA = (int16_t)adcWord(buffer, BQ25798_REG_IBUS_ADC);
+  snapshot.ibat_mA = (int16_t)adcWord(buffer, BQ25798_REG_IBAT_ADC);
+  snapshot.vbus_mV = adcWord(buffer, BQ25798_REG_VBUS_ADC);
+  snapshot.vac1_mV = adcWord(buffer, BQ25798_REG_VAC1_ADC);
+  snapshot.vac2_mV = adcWord(buffer, BQ25798_REG_VAC2_ADC);
+  snapshot.vbat_mV = adcWord(buffer, BQ25798_REG_VBAT_ADC);
+  snapshot.vsys_mV = adcWord(buffer, BQ25798_REG_VSYS_ADC);
+  snapshot.ts_raw = adcWord(buffer, BQ25798_REG_TS_ADC);
+  snapshot.tdie_raw = (int16_t)adcWord(buffer, BQ25798_REG_TDIE_ADC);
+  snapshot.dp_mV = adcWord(buffer, BQ25798_REG_DPLUS_ADC);
+  snapshot.dm_mV = adcWord(buffer, BQ25798_REG_DMINUS_ADC);
 }
 
 /*!
- * @brief Set the battery discharge sense enable status
- * @param enable True to enable battery discharge sense
+ * @brief Read all status and fault registers in one burst
+ *
+ * Fetches Charger Status 0-4 and FAULT Status 0-1 (0x1B-0x21) in a single
+ * 7-byte I2C transaction and decodes every field.
+ *
+ * @param status Destination for the decoded status
  * @return True if successful
  */
-bool Adafruit_BQ25798::setBatDischargeSenseEnable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_ibat_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 5);
+bool Adafruit_BQ25798::getStatus(bq25798_status_t& status) {
+  uint8_t buffer[BQ25798_STATUS_BLOCK_SIZE];
 
-  en_ibat_bit.write(enable);
+  if (!readRegisters(BQ25798_REG_CHARGER_STATUS_0, buffer, sizeof(buffer))) {
+    return false;
+  }
 
+  decodeStatus(buffer, status);
   return true;
 }
 
 /*!
- * @brief Get the battery discharge current regulation setting
- * @return Current regulation setting
+ * @brief Read just the charge phase, one byte instead of the status block
+ * @return Charge status (CHG_STAT), BQ25798_CHG_STAT_NOT_CHARGING if the
+ * read fails
  */
-bq25798_ibat_reg_t Adafruit_BQ25798::getBatDischargeA() {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits ibat_reg_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 2, 3);
-
-  return (bq25798_ibat_reg_t)ibat_reg_bits.read();
+bq25798_chg_stat_t Adafruit_BQ25798::getChargeStatus() {
+  return (bq25798_chg_stat_t)readField(BQ25798_FIELD_CHG_STAT);
 }
 
 /*!
- * @brief Set the battery discharge current regulation setting
- * @param current Current regulation setting
- * @return True if successful
+ * @brief Decode a burst of the status and fault registers
+ * @param buffer BQ25798_STATUS_BLOCK_SIZE bytes read from
+ * BQ25798_REG_CHARGER_STATUS_0
+ * @param status Destination for the decoded status
  */
-bool Adafruit_BQ25798::setBatDischargeA(bq25798_ibat_reg_t current) {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits ibat_reg_bits =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 2, 3);
+void Adafruit_BQ25798::decodeStatus(const uint8_t* buffer,
+                                    bq25798_status_t& status) {
+  // Charger Status 0
+  status.iindpm = (buffer[0] >> 7) & 0x01;
+  status.vindpm = (buffer[0] >> 6) & 0x01;
+  status.wd_expired = (buffer[0] >> 5) & 0x01;
+  status.power_good = (buffer[0] >> 3) & 0x01;
+  status.ac2_present = (buffer[0] >> 2) & 0x01;
+  status.ac1_present = (buffer[0] >> 1) & 0x01;
+  status.vbus_present = buffer[0] & 0x01;
 
-  ibat_reg_bits.write((uint8_t)current);
+  // Charger Status 1
+  status.chg_stat = (buffer[1] >> 5) & 0x07;
+  status.vbus_stat = (buffer[1] >> 1) & 0x0F;
+  status.bc12_done = buffer[1] & 0x01;
 
-  return true;
-}
+  // Charger Status 2
+  status.ico_stat = (buffer[2] >> 6) & 0x03;
+  status.treg = (buffer[2] >> 2) & 0x01;
+  status.dpdm_busy = (buffer[2] >> 1) & 0x01;
+  status.vbat_present = buffer[2] & 0x01;
 
-/*!
- * @brief Get the IINDPM enable status
- * @return True if IINDPM is enabled
- */
-bool Adafruit_BQ25798::getIINDPMenable() {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_iindpm_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 2);
+  // Charger Status 3
+  status.acrb2 = (buffer[3] >> 7) & 0x01;
+  status.acrb1 = (buffer[3] >> 6) & 0x01;
+  status.adc_done = (buffer[3] >> 5) & 0x01;
+  status.vsys_min_reg = (buffer[3] >> 4) & 0x01;
+  status.chg_tmr = (buffer[3] >> 3) & 0x01;
+  status.trichg_tmr = (buffer[3] >> 2) & 0x01;
+  status.prechg_tmr = (buffer[3] >> 1) & 0x01;
 
-  return en_iindpm_bit.read();
+  // Charger Status 4
+  status.vbat_otg_low = (buffer[4] >> 4) & 0x01;
+  status.ts_cold = (buffer[4] >> 3) & 0x01;
+  status.ts_cool = (buffer[4] >> 2) & 0x01;
+  status.ts_warm = (buffer[4] >> 1) & 0x01;
+  status.ts_hot = buffer[4] & 0x01;
+
+  // FAULT Status 0
+  status.ibat_reg = (buffer[5] >> 7) & 0x01;
+  status.vbus_ovp = (buffer[5] >> 6) & 0x01;
+  status.vbat_ovp = (buffer[5] >> 5) & 0x01;
+  status.ibus_ocp = (buffer[5] >> 4) & 0x01;
+  status.ibat_ocp = (buffer[5] >> 3) & 0x01;
+  status.conv_ocp = (buffer[5] >> 2) & 0x01;
+  status.vac2_ovp = (buffer[5] >> 1) & 0x01;
+  status.vac1_ovp = buffer[5] & 0x01;
+
+  // FAULT Status 1
+  status.vsys_short = (buffer[6] >> 7) & 0x01;
+  status.vsys_ovp = (buffer[6] >> 6) & 0x01;
+  status.otg_ovp = (buffer[6] >> 5) & 0x01;
+  status.otg_uvp = (buffer[6] >> 4) & 0x01;
+  status.tshut = (buffer[6] >> 2) & 0x01;
 }
 
 /*!
- * @brief Set the IINDPM enable status
- * @param enable True to enable IINDPM
- * @return True if successful
+ * @brief Watch the charger INT pin for events
+ *
+ * The ISR only records that INT fell, since I2C cannot be used from
+ * interrupt context on most cores. The next updateEvents() call then reads
+ * all six flag registers in one burst. Only one charger at a time can own
+ * the built-in ISR; for more, call handleInterrupt() from your own ISRs.
+ *
+ * @param pin Arduino pin connected to the open-drain INT output
+ * @return True if successful, false if the pin has no interrupt
  */
-bool Adafruit_BQ25798::setIINDPMenable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_iindpm_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 2);
+bool Adafruit_BQ25798::attachInterruptPin(uint8_t pin) {
+  int irq = digitalPinToInterrupt(pin);
+#ifdef NOT_AN_INTERRUPT
+  if (irq == NOT_AN_INTERRUPT) {
+    return false;
+  }
+#endif
 
-  en_iindpm_bit.write(enable);
+  detachInterruptPin();
+
+  pinMode(pin, INPUT_PULLUP);
+  int_pin = pin;
+  irq_instance = this;
+  // Pick up anything that was flagged before the ISR was attached
+  int_pending = true;
+  attachInterrupt(irq, irqHandler, FALLING);
 
   return true;
 }
 
 /*!
- * @brief Get the external ILIM pin enable status
- * @return True if external ILIM pin is enabled
+ * @brief Stop watching the INT pin
  */
-bool Adafruit_BQ25798::getExtILIMpin() {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_extilim_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 1);
+void Adafruit_BQ25798::detachInterruptPin() {
+  if (int_pin < 0) {
+    return;
+  }
 
-  return en_extilim_bit.read();
+  detachInterrupt(digitalPinToInterrupt(int_pin));
+  if (irq_instance == this) {
+    irq_instance = NULL;
+  }
+  int_pin = -1;
 }
 
 /*!
- * @brief Set the external ILIM pin enable status
- * @param enable True to enable external ILIM pin
- * @return True if successful
+ * @brief ISR attached by attachInterruptPin()
  */
-bool Adafruit_BQ25798::setExtILIMpin(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_extilim_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 1);
-
-  en_extilim_bit.write(enable);
-
-  return true;
+void BQ25798_ISR_ATTR Adafruit_BQ25798::irqHandler() {
+  if (irq_instance) {
+    irq_instance->handleInterrupt();
+  }
 }
 
 /*!
- * @brief Get the battery discharge OCP enable status
- * @return True if battery discharge OCP is enabled
+ * @brief Record that the INT line fell. Safe to call from an ISR.
  */
-bool Adafruit_BQ25798::getBatDischargeOCPenable() {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_batoc_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 0);
+void BQ25798_ISR_ATTR Adafruit_BQ25798::handleInterrupt() {
+  int_pending = true;
+}
 
-  return en_batoc_bit.read();
+/*!
+ * @brief Check whether INT fell since the last updateEvents()
+ * @return True if an interrupt is waiting to be serviced
+ */
+bool Adafruit_BQ25798::interruptPending() {
+  return int_pending;
 }
 
 /*!
- * @brief Set the battery discharge OCP enable status
- * @param enable True to enable battery discharge OCP
- * @return True if successful
+ * @brief Latch the flag registers into the pending event word
+ *
+ * If INT fell since the last call (or force is true), reads all six
+ * clear-on-read flag registers (0x22-0x27) in a single burst and ORs them
+ * into the pending events. Otherwise the bus is not touched.
+ *
+ * @param force Read the flags even if no interrupt was seen, for polling
+ * @return True if successful, false if the flag read failed
  */
-bool Adafruit_BQ25798::setBatDischargeOCPenable(bool enable) {
-  Adafruit_BusIO_Register chg_ctrl5_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_CHARGER_CONTROL_5);
-  Adafruit_BusIO_RegisterBits en_batoc_bit =
-      Adafruit_BusIO_RegisterBits(&chg_ctrl5_reg, 1, 0);
+bool Adafruit_BQ25798::updateEvents(bool force) {
+  if (!int_pending && !force) {
+    return true;
+  }
+
+  // Clear first, so an edge that arrives during the read is not lost
+  int_pending = false;
+
+  uint8_t buffer[BQ25798_FLAG_BLOCK_SIZE];
+  if (!readRegisters(BQ25798_REG_CHARGER_FLAG_0, buffer, sizeof(buffer))) {
+    int_pending = true;
+    return false;
+  }
 
-  en_batoc_bit.write(enable);
+  uint64_t events = 0;
+  for (uint8_t i = 0; i < BQ25798_FLAG_BLOCK_SIZE; i++) {
+    events |= (uint64_t)buffer[i] << (8 * i);
+  }
+  pending_events |= events & BQ25798_EVENT_ALL;
 
   return true;
 }
 
 /*!
- * @brief Get the VINDPM VOC percentage setting
- * @return VOC percentage setting
+ * @brief Drain latched events without touching the bus
+ * @param mask Events to take, other pending events are kept
+ * @return The pending events selected by mask (BQ25798_EVENT_* bits)
  */
-bq25798_voc_pct_t Adafruit_BQ25798::getVINDPM_VOCpercent() {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits voc_pct_bits =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 3, 5);
-
-  return (bq25798_voc_pct_t)voc_pct_bits.read();
+uint64_t Adafruit_BQ25798::takeEvents(uint64_t mask) {
+  uint64_t events = pending_events & mask;
+  pending_events &= ~mask;
+  return events;
 }
 
 /*!
- * @brief Set the VINDPM VOC percentage setting
- * @param percentage VOC percentage setting
- * @return True if successful
+ * @brief Get which events are masked from pulling INT low
+ * @return Masked events (BQ25798_EVENT_* bits), or 0 if the read failed
  */
-bool Adafruit_BQ25798::setVINDPM_VOCpercent(bq25798_voc_pct_t percentage) {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits voc_pct_bits =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 3, 5);
+uint64_t Adafruit_BQ25798::getEventMask() {
+  uint8_t buffer[BQ25798_FLAG_BLOCK_SIZE];
 
-  voc_pct_bits.write((uint8_t)percentage);
-
-  return true;
-}
+  if (!readRegisters(BQ25798_REG_CHARGER_MASK_0, buffer, sizeof(buffer))) {
+    return 0;
+  }
 
-/*!
- * @brief Get the VOC delay time setting
- * @return VOC delay setting
- */
-bq25798_voc_dly_t Adafruit_BQ25798::getVOCdelay() {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits voc_dly_bits =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 2, 3);
+  uint64_t mask = 0;
+  for (uint8_t i = 0; i < BQ25798_FLAG_BLOCK_SIZE; i++) {
+    mask |= (uint64_t)buffer[i] << (8 * i);
+  }
 
-  return (bq25798_voc_dly_t)voc_dly_bits.read();
+  return mask & BQ25798_EVENT_ALL;
 }
 
 /*!
- * @brief Set the VOC delay time setting
- * @param delay VOC delay setting
+ * @brief Mask events from pulling INT low, in a single burst write
+ *
+ * Writes all six mask registers (0x28-0x2D) in one transaction. Masked
+ * events are still latched in the flag registers and will be reported by
+ * the next updateEvents(), they just no longer wake the host.
+ *
+ * @param mask Events to mask (BQ25798_EVENT_* bits), 0 unmasks everything
  * @return True if successful
  */
-bool Adafruit_BQ25798::setVOCdelay(bq25798_voc_dly_t delay) {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits voc_dly_bits =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 2, 3);
+bool Adafruit_BQ25798::setEventMask(uint64_t mask) {
+  uint8_t buffer[BQ25798_FLAG_BLOCK_SIZE];
 
-  voc_dly_bits.write((uint8_t)delay);
+  mask &= BQ25798_EVENT_ALL;
+  for (uint8_t i = 0; i < BQ25798_FLAG_BLOCK_SIZE; i++) {
+    buffer[i] = (uint8_t)(mask >> (8 * i));
+  }
 
-  return true;
+  return writeRegisters(BQ25798_REG_CHARGER_MASK_0, buffer, sizeof(buffer));
 }
 
 /*!
- * @brief Get the VOC measurement rate setting
- * @return VOC rate setting
+ * @brief Bits of a shadowed register that the charger may change at any
+ * time, or that are read-only. These are always fetched from the chip.
+ * @param reg Register address
+ * @return Mask of volatile bits
  */
-bq25798_voc_rate_t Adafruit_BQ25798::getVOCrate() {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits voc_rate_bits =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 2, 1);
+static uint8_t shadowVolatileBits(uint8_t reg) {
+  switch (reg) {
+    case BQ25798_REG_INPUT_VOLTAGE_LIMIT: // reloaded by VOC detection
+    case BQ25798_REG_INPUT_CURRENT_LIMIT: // reloaded by ICO and DPDM
+    case BQ25798_REG_INPUT_CURRENT_LIMIT + 1:
+    case BQ25798_REG_ICO_CURRENT_LIMIT: // read-only ICO result
+      return 0xFF;
+    case BQ25798_REG_CHARGER_CONTROL_4: // EN_ACDRV2/1 follow input selection
+      return 0xC0;
+    default:
+      return 0x00;
+  }
+}
 
-  return (bq25798_voc_rate_t)voc_rate_bits.read();
+/*!
+ * @brief Bits of a shadowed register that the charger only ever clears
+ * (self-clearing commands, HIZ, OTG and ship FET control). A cached 0 is
+ * safe to write back, a cached 1 may be stale.
+ * @param reg Register address
+ * @return Mask of auto-clearing bits
+ */
+static uint8_t shadowAutoclearBits(uint8_t reg) {
+  switch (reg) {
+    case BQ25798_REG_TERMINATION_CONTROL: // REG_RST
+      return 0x40;
+    case BQ25798_REG_CHARGER_CONTROL_0: // FORCE_ICO, EN_HIZ
+      return 0x0C;
+    case BQ25798_REG_CHARGER_CONTROL_1: // WD_RST
+      return 0x08;
+    case BQ25798_REG_CHARGER_CONTROL_2: // FORCE_INDET, SDRV_CTRL
+      return 0x86;
+    case BQ25798_REG_CHARGER_CONTROL_3: // EN_OTG
+      return 0x40;
+    case BQ25798_REG_CHARGER_CONTROL_4: // FORCE_VINDPM_DET
+      return 0x02;
+    case BQ25798_REG_TEMPERATURE_CONTROL: // BKUP_ACFET1_ON
+      return 0x01;
+    default:
+      return 0x00;
+  }
 }
 
 /*!
- * @brief Set the VOC measurement rate setting
- * @param rate VOC rate setting
- * @return True if successful
+ * @brief Check whether a register field can be served from the shadow copy
+ * @param reg First register address of the field
+ * @param width Register width in bytes (1 or 2)
+ * @param mask Field mask within the (big-endian) register value
+ * @param for_write True when the bits *outside* the mask are needed to
+ * rebuild the register for a write, false when the masked bits are read
+ * @return True if the shadow copy can be used
  */
-bool Adafruit_BQ25798::setVOCrate(bq25798_voc_rate_t rate) {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits voc_rate_bits =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 2, 1);
+bool Adafruit_BQ25798::shadowHolds(uint8_t reg, uint8_t width, uint16_t mask,
+                                   bool for_write) {
+  if (!cache_valid || (reg + width) > BQ25798_SHADOW_SIZE) {
+    return false;
+  }
 
-  voc_rate_bits.write((uint8_t)rate);
+  for (uint8_t i = 0; i < width; i++) {
+    uint8_t addr = reg + i;
+    uint8_t field = (uint8_t)(mask >> (8 * (width - 1 - i)));
+    uint8_t volatile_bits = shadowVolatileBits(addr);
+    uint8_t autoclear_bits = shadowAutoclearBits(addr);
+
+    if (for_write) {
+      uint8_t kept = ~field;
+      if ((kept & volatile_bits) || (kept & autoclear_bits & shadow[addr])) {
+        return false;
+      }
+    } else if (field & (volatile_bits | autoclear_bits)) {
+      return false;
+    }
+  }
 
   return true;
 }
 
 /*!
- * @brief Get the MPPT enable status
- * @return True if MPPT is enabled
- */
-bool Adafruit_BQ25798::getMPPTenable() {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits en_mppt_bit =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 1, 0);
+ * @brief Check a multi-field write and work out which registers it touches
+ *
+ * Every value is range checked before anything else. If the register cache
+ * holds all the untouched bits of the touched registers, plan.buffer is
+ * filled from it and plan.cached is set; otherwise the caller must read
+ * plan.len registers from plan.first into plan.buffer.
+ *
+ * @param fields Fields to write
+ * @param values Field values as for setField(), one per field
+ * @param count Number of fields
+ * @param plan Filled with the register span and touched bits
+ * @return False on an unknown field, an out-of-range value, or a span wider
+ * than BQ25798_FIELD_SPAN_MAX
+ */
+bool Adafruit_BQ25798::planFields(const bq25798_field_t* fields,
+                                  const uint16_t* values, uint8_t count,
+                                  bq25798_field_plan_t& plan) {
+  bq25798_field_desc_t desc;
+  uint8_t first = 0xFF;
+  uint8_t last = 0;
+
+  plan.first = 0;
+  plan.len = 0;
+  plan.cached = true;
+
+  for (uint8_t i = 0; i < count; i++) {
+    if (!fieldDesc(fields[i], desc) || values[i] < desc.min ||
+        values[i] > desc.max) {
+      return false;
+    }
+    if (desc.reg < first) {
+      first = desc.reg;
+    }
+    if (desc.reg + fieldWidth(desc) - 1 > last) {
+      last = desc.reg + fieldWidth(desc) - 1;
+    }
+  }
 
-  return en_mppt_bit.read();
-}
+  if (count == 0) {
+    return true;
+  }
+  if (last - first + 1 > BQ25798_FIELD_SPAN_MAX) {
+    return false;
+  }
 
-/*!
- * @brief Set the MPPT enable status
- * @param enable True to enable MPPT
- * @return True if successful
- */
-bool Adafruit_BQ25798::setMPPTenable(bool enable) {
-  Adafruit_BusIO_Register mppt_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_MPPT_CONTROL);
-  Adafruit_BusIO_RegisterBits en_mppt_bit =
-      Adafruit_BusIO_RegisterBits(&mppt_ctrl_reg, 1, 0);
+  plan.first = first;
+  plan.len = last - first + 1;
+
+  memset(plan.touched, 0, plan.len);
+  for (uint8_t i = 0; i < count; i++) {
+    fieldDesc(fields[i], desc);
+    uint16_t mask = fieldMask(desc);
+    if (fieldWidth(desc) == 2) {
+      plan.touched[desc.reg - first] |= mask >> 8;
+      plan.touched[desc.reg - first + 1] |= mask & 0xFF;
+    } else {
+      plan.touched[desc.reg - first] |= mask;
+    }
+  }
+
+  // Only the registers actually being written need their other bits
+  for (uint8_t i = 0; i < plan.len && plan.cached; i++) {
+    plan.cached = !plan.touched[i] ||
+                  shadowHolds(first + i, 1, plan.touched[i], true);
+  }
 
-  en_mppt_bit.write(enable);
+  if (plan.cached) {
+    memcpy(plan.buffer, shadow + first, plan.len);
+  }
 
   return true;
 }
 
 /*!
- * @brief Get the thermal regulation threshold setting
- * @return Thermal regulation threshold setting
+ * @brief Merge field values into the current register contents of a plan
+ * @param fields Fields passed to planFields()
+ * @param values Values passed to planFields()
+ * @param count Number of fields
+ * @param plan Plan whose buffer holds the current register contents
  */
-bq25798_treg_t Adafruit_BQ25798::getThermRegulationThresh() {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits treg_bits =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 2, 6);
+void Adafruit_BQ25798::mergeFields(const bq25798_field_t* fields,
+                                   const uint16_t* values, uint8_t count,
+                                   bq25798_field_plan_t& plan) {
+  // planFields() has already checked every field
+  bq25798_field_desc_t desc = {};
 
-  return (bq25798_treg_t)treg_bits.read();
+  for (uint8_t i = 0; i < count; i++) {
+    fieldDesc(fields[i], desc);
+    uint8_t* data = plan.buffer + (desc.reg - plan.first);
+    uint16_t mask = fieldMask(desc);
+    uint16_t code = (values[i] - desc.offset) / desc.lsb;
+    if (fieldWidth(desc) == 2) {
+      uint16_t reg_value = ((uint16_t)data[0] << 8) | data[1];
+      reg_value = (reg_value & ~mask) | ((code << fieldShift(desc)) & mask);
+      data[0] = reg_value >> 8;
+      data[1] = reg_value & 0xFF;
+    } else {
+      data[0] = (data[0] & ~mask) | ((code << fieldShift(desc)) & mask);
+    }
+  }
 }
 
 /*!
- * @brief Set the thermal regulation threshold setting
- * @param threshold Thermal regulation threshold setting
- * @return True if successful
+ * @brief Find the next contiguous run of touched registers in a plan.
+ * Registers in the span that no field touches are left alone.
+ * @param plan Planned write
+ * @param pos Search position, advanced past the run
+ * @param run Offset of the run within the plan
+ * @param len Length of the run
+ * @return True if a run was found
  */
-bool Adafruit_BQ25798::setThermRegulationThresh(bq25798_treg_t threshold) {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits treg_bits =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 2, 6);
-
-  treg_bits.write((uint8_t)threshold);
+bool Adafruit_BQ25798::nextRun(const bq25798_field_plan_t& plan, uint8_t& pos,
+                               uint8_t& run, uint8_t& len) {
+  while (pos < plan.len && !plan.touched[pos]) {
+    pos++;
+  }
+  if (pos >= plan.len) {
+    return false;
+  }
 
+  run = pos;
+  while (pos < plan.len && plan.touched[pos]) {
+    pos++;
+  }
+  len = pos - run;
   return true;
 }
 
 /*!
- * @brief Get the thermal shutdown threshold setting
- * @return Thermal shutdown threshold setting
+ * @brief Copy registers just read from or written to the chip into the
+ * shadow copy, if it is in use, and follow the watchdog setting and kicks
+ * @param reg First register address
+ * @param buffer Register contents
+ * @param len Number of registers
  */
-bq25798_tshut_t Adafruit_BQ25798::getThermShutdownThresh() {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits tshut_bits =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 2, 4);
+void Adafruit_BQ25798::absorbRegisters(uint8_t reg, const uint8_t* buffer,
+                                       uint8_t len) {
+  if (reg <= BQ25798_REG_CHARGER_CONTROL_1 &&
+      reg + len > BQ25798_REG_CHARGER_CONTROL_1) {
+    // WD_RST always reads back 0, so a set bit is a kick being written
+    uint8_t value = buffer[BQ25798_REG_CHARGER_CONTROL_1 - reg];
+    wdt_code = value & 0x07;
+    if (value & 0x08) {
+      wdt_synced = true;
+      wdt_kicked_at = millis();
+    }
+  }
 
-  return (bq25798_tshut_t)tshut_bits.read();
+  if (cache_valid) {
+    for (uint8_t i = 0; i < len && (reg + i) < BQ25798_SHADOW_SIZE; i++) {
+      shadow[reg + i] = buffer[i];
+    }
+    // The chip clears WD_RST as soon as it is written
+    shadow[BQ25798_REG_CHARGER_CONTROL_1] &= ~0x08;
+  }
 }
 
 /*!
- * @brief Set the thermal shutdown threshold setting
- * @param threshold Thermal shutdown threshold setting
- * @return True if successful
+ * @brief Validate a saved configuration and work out what the charger
+ * should hold: the saved bits, plus the chip's own skipped bits
+ * @param buffer Configuration, BQ25798_CONFIG_SIZE bytes
+ * @param target Filled with the wanted register contents
+ * @param chip Filled with the charger's current register contents
+ * @return False for a bad version or CRC, or a bus error
  */
-bool Adafruit_BQ25798::setThermShutdownThresh(bq25798_tshut_t threshold) {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits tshut_bits =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 2, 4);
+bool Adafruit_BQ25798::readConfig(const uint8_t* buffer, uint8_t* target,
+                                  uint8_t* chip) {
+  uint16_t crc = ((uint16_t)buffer[1 + BQ25798_CONFIG_REGS] << 8) |
+                 buffer[2 + BQ25798_CONFIG_REGS];
 
-  tshut_bits.write((uint8_t)threshold);
+  if (buffer[0] != BQ25798_CONFIG_VERSION ||
+      configCrc(buffer, 1 + BQ25798_CONFIG_REGS) != crc) {
+    return false;
+  }
+  if (!readRegisters(0x00, chip, BQ25798_CONFIG_REGS)) {
+    return false;
+  }
 
+  for (uint8_t reg = 0; reg < BQ25798_CONFIG_REGS; reg++) {
+    uint8_t skip = configSkipBits(reg);
+    target[reg] = (buffer[1 + reg] & ~skip) | (chip[reg] & skip);
+  }
   return true;
 }
 
 /*!
- * @brief Get the VBUS pulldown enable status
- * @return True if VBUS pulldown is enabled
+ * @brief Check how far the watchdog period has run since the last kick
+ * @param quarters Quarters of the period that must have passed
+ * @return True if the watchdog is enabled and a kick is due: that much of
+ * the period has passed, or the time of the last kick is unknown
  */
-bool Adafruit_BQ25798::getVBUSpulldown() {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits vbus_pd_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 3);
+bool Adafruit_BQ25798::watchdogDue(uint8_t quarters) {
+  uint32_t period = wdtPeriodMs(wdt_code);
 
-  return vbus_pd_bit.read();
+  if (period == 0) {
+    return false;
+  }
+  return !wdt_synced || millis() - wdt_kicked_at >= period / 4 * quarters;
 }
 
 /*!
- * @brief Set the VBUS pulldown enable status
- * @param enable True to enable VBUS pulldown
- * @return True if successful
+ * @brief Overlay bits staged by setters during an update on register
+ * contents read from the chip or the shadow copy
+ * @param reg First register address
+ * @param buffer Register contents, updated in place
+ * @param len Number of registers
  */
-bool Adafruit_BQ25798::setVBUSpulldown(bool enable) {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits vbus_pd_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 3);
-
-  vbus_pd_bit.write(enable);
-
-  return true;
+void Adafruit_BQ25798::overlayStaged(uint8_t reg, uint8_t* buffer,
+                                     uint8_t len) {
+  if (updating) {
+    for (uint8_t i = 0; i < len && (reg + i) < BQ25798_SHADOW_SIZE; i++) {
+      uint8_t bits = staged_bits[reg + i];
+      buffer[i] = (buffer[i] & ~bits) | (staged[reg + i] & bits);
+    }
+  }
 }
 
 /*!
- * @brief Get the VAC1 pulldown enable status
- * @return True if VAC1 pulldown is enabled
+ * @brief Switch to a new register transport, deleting the old one if owned
+ * @param bus New transport, or NULL
+ * @param owned True if this object must delete the transport
  */
-bool Adafruit_BQ25798::getVAC1pulldown() {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits vac1_pd_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 2);
-
-  return vac1_pd_bit.read();
+void Adafruit_BQ25798::setBus(Adafruit_BQ25798_Bus* bus, bool owned) {
+  if (this->bus && bus_owned) {
+    delete this->bus;
+  }
+  this->bus = bus;
+  bus_owned = owned;
+  cache_valid = false;
 }
 
 /*!
- * @brief Set the VAC1 pulldown enable status
- * @param enable True to enable VAC1 pulldown
- * @return True if successful
+ * @brief Verify the part number, then reset the chip or adopt its settings
+ * @param reset_registers True to reset every register to its default
+ * @return True if a BQ25798 answered and the reset or cache fill succeeded
  */
-bool Adafruit_BQ25798::setVAC1pulldown(bool enable) {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits vac1_pd_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 2);
+bool Adafruit_BQ25798::init(bool reset_registers) {
+  // Check part information register to verify chip
+  uint8_t part_info = readField(BQ25798_FIELD_PART_INFO);
+
+  // Verify part number (bits 5-3 should be 011b = 3h for BQ25798)
+  if ((part_info & 0x38) != 0x18) {
+    return false;
+  }
 
-  vac1_pd_bit.write(enable);
+  if (!reset_registers) {
+    // Warm start: keep the programmed limits, only the shadow copy (if
+    // any) needs the chip's current contents
+    return !cache_enabled || refreshCache();
+  }
 
-  return true;
+  // Reset all registers to default values, this also fills the shadow copy
+  // of the control registers when the cache is enabled
+  return reset();
 }
 
 /*!
- * @brief Get the VAC2 pulldown enable status
- * @return True if VAC2 pulldown is enabled
+ * @brief Burst read consecutive registers from the chip
+ * @param reg First register address
+ * @param buffer Destination buffer
+ * @param len Number of bytes to read
+ * @return True if successful
  */
-bool Adafruit_BQ25798::getVAC2pulldown() {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits vac2_pd_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 1);
+bool Adafruit_BQ25798::readRegisters(uint8_t reg, uint8_t* buffer,
+                                     uint8_t len) {
+  if (!bus->readRegisters(reg, buffer, len)) {
+    return false;
+  }
 
-  return vac2_pd_bit.read();
+  // Anything fresh from the chip also refreshes the shadow copy
+  absorbRegisters(reg, buffer, len);
+  return true;
 }
 
 /*!
- * @brief Set the VAC2 pulldown enable status
- * @param enable True to enable VAC2 pulldown
+ * @brief Burst write consecutive registers to the chip
+ * @param reg First register address
+ * @param buffer Source buffer
+ * @param len Number of bytes to write
  * @return True if successful
  */
-bool Adafruit_BQ25798::setVAC2pulldown(bool enable) {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits vac2_pd_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 1);
+bool Adafruit_BQ25798::writeRegisters(uint8_t reg, const uint8_t* buffer,
+                                      uint8_t len) {
+  const uint8_t ctl1 = BQ25798_REG_CHARGER_CONTROL_1;
+  uint8_t burst[BQ25798_FIELD_SPAN_MAX + 1];
+
+  // Once the watchdog is half way to expiring, a write that covers or
+  // borders REG_CHARGER_CONTROL_1 carries WD_RST along
+  if (len <= BQ25798_FIELD_SPAN_MAX && watchdogDue(2)) {
+    if (reg <= ctl1 && reg + len > ctl1) {
+      memcpy(burst, buffer, len);
+      burst[ctl1 - reg] |= 0x08;
+      buffer = burst;
+    } else if (reg + len == ctl1 && shadowHolds(ctl1, 1, 0x08, true)) {
+      memcpy(burst, buffer, len);
+      burst[len++] = shadow[ctl1] | 0x08;
+      buffer = burst;
+    } else if (reg == ctl1 + 1 && shadowHolds(ctl1, 1, 0x08, true)) {
+      burst[0] = shadow[ctl1] | 0x08;
+      memcpy(burst + 1, buffer, len++);
+      buffer = burst;
+      reg = ctl1;
+    }
+  }
 
-  vac2_pd_bit.write(enable);
+  if (!bus->writeRegisters(reg, buffer, len)) {
+    return false;
+  }
 
+  absorbRegisters(reg, buffer, len);
   return true;
 }
 
 /*!
- * @brief Get the backup ACFET1 on status
- * @return True if backup ACFET1 is on
+ * @brief Read a bit field from a register, from RAM when the cache allows
+ * @param reg Register address (MSB for 16-bit registers)
+ * @param width Register width in bytes (1 or 2)
+ * @param bits Number of bits in the field
+ * @param shift Bit position of the field LSB
+ * @return The field value, or 0 if the read failed
  */
-bool Adafruit_BQ25798::getBackupACFET1on() {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits bkup_acfet1_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 0);
-
-  return bkup_acfet1_bit.read();
-}
+uint16_t Adafruit_BQ25798::readBits(uint8_t reg, uint8_t width, uint8_t bits,
+                                    uint8_t shift) {
+  uint16_t mask = (uint16_t)(((1UL << bits) - 1) << shift);
+  uint8_t buffer[2];
 
-/*!
- * @brief Set the backup ACFET1 on status
- * @param enable True to turn on backup ACFET1
- * @return True if successful
- */
-bool Adafruit_BQ25798::setBackupACFET1on(bool enable) {
-  Adafruit_BusIO_Register temp_ctrl_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TEMPERATURE_CONTROL);
-  Adafruit_BusIO_RegisterBits bkup_acfet1_bit =
-      Adafruit_BusIO_RegisterBits(&temp_ctrl_reg, 1, 0);
+  if (shadowHolds(reg, width, mask, false)) {
+    memcpy(buffer, shadow + reg, width);
+  } else if (!readRegisters(reg, buffer, width)) {
+    return 0;
+  }
+  overlayStaged(reg, buffer, width);
 
-  bkup_acfet1_bit.write(enable);
+  uint16_t value = (width == 2) ? ((uint16_t)buffer[0] << 8) | buffer[1]
+                                : buffer[0];
 
-  return true;
+  return (value & mask) >> shift;
 }
 
 /*!
- * @brief Reset all registers to default values
+ * @brief Write a bit field in a register, preserving the other bits
+ *
+ * With the cache enabled the other bits come from RAM, so this costs a single
+ * write transaction instead of a read-modify-write.
+ * Between beginUpdate() and commit() control register fields are only
+ * staged in RAM.
+ *
+ * @param reg Register address (MSB for 16-bit registers)
+ * @param width Register width in bytes (1 or 2)
+ * @param bits Number of bits in the field
+ * @param shift Bit position of the field LSB
+ * @param value New field value
  * @return True if successful
  */
-bool Adafruit_BQ25798::reset() {
-  Adafruit_BusIO_Register term_reg =
-      Adafruit_BusIO_Register(i2c_dev, BQ25798_REG_TERMINATION_CONTROL);
-  Adafruit_BusIO_RegisterBits reg_rst_bit =
-      Adafruit_BusIO_RegisterBits(&term_reg, 1, 6);
+bool Adafruit_BQ25798::writeBits(uint8_t reg, uint8_t width, uint8_t bits,
+                                 uint8_t shift, uint16_t value) {
+  uint16_t mask = (uint16_t)(((1UL << bits) - 1) << shift);
+  uint8_t buffer[2];
+
+  if (updating && (reg + width) <= BQ25798_SHADOW_SIZE) {
+    // Inside beginUpdate()/commit(): only the staging copy changes
+    uint16_t staged_value = (value << shift) & mask;
+    for (uint8_t i = 0; i < width; i++) {
+      uint8_t byte_shift = 8 * (width - 1 - i);
+      uint8_t byte_mask = mask >> byte_shift;
+      staged[reg + i] = (staged[reg + i] & ~byte_mask) |
+                        (uint8_t)(staged_value >> byte_shift);
+      staged_bits[reg + i] |= byte_mask;
+    }
+    return true;
+  }
+
+  if (mask == (width == 2 ? 0xFFFF : 0xFF)) {
+    // The field is the whole register, nothing to preserve
+    buffer[0] = buffer[1] = 0;
+  } else if (shadowHolds(reg, width, mask, true)) {
+    memcpy(buffer, shadow + reg, width);
+  } else if (!readRegisters(reg, buffer, width)) {
+    return false;
+  }
 
-  reg_rst_bit.write(1);
+  uint16_t reg_value = (width == 2) ? ((uint16_t)buffer[0] << 8) | buffer[1]
+                                    : buffer[0];
+  reg_value = (reg_value & ~mask) | ((value << shift) & mask);
 
-  return true;
+  if (width == 2) {
+    buffer[0] = reg_value >> 8;
+    buffer[1] = reg_value & 0xFF;
+  } else {
+    buffer[0] = reg_value;
+  }
+
+  return writeRegisters(reg, buffer, width);
 }
\ No newline at end of file
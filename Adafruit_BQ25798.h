@@ -81,6 +81,74 @@
 #define BQ25798_REG_DPDM_DRIVER 0x47            ///< DPDM Driver
 #define BQ25798_REG_PART_INFORMATION 0x48       ///< Part Information
 
+#define BQ25798_SHADOW_SIZE 0x1A    ///< Control registers 0x00-0x19 held in RAM
+#define BQ25798_ADC_BLOCK_SIZE 22   ///< ADC result registers 0x31-0x46
+#define BQ25798_STATUS_BLOCK_SIZE 7 ///< Status registers 0x1B-0x21
+#define BQ25798_FLAG_BLOCK_SIZE 6   ///< Flag registers 0x22-0x27
+#define BQ25798_FIELD_SPAN_MAX 31   ///< Widest register span for getFields()
+#define BQ25798_CONFIG_REGS 0x19    ///< Registers 0x00-0x18 in a saved config
+#define BQ25798_CONFIG_VERSION 1    ///< Layout of a saved config
+#define BQ25798_CONFIG_SIZE 28      ///< Saved config: version, regs, CRC-16
+
+// Event bits. Bit (8 * n + b) mirrors bit b of flag register 0x22 + n and of
+// mask register 0x28 + n, so a burst of the six flag or mask registers maps
+// straight onto an event word.
+#define BQ25798_EVENT_VBUS_PRESENT (1ULL << 0) ///< VBUS present changed
+#define BQ25798_EVENT_AC1_PRESENT (1ULL << 1)  ///< VAC1 present changed
+#define BQ25798_EVENT_AC2_PRESENT (1ULL << 2)  ///< VAC2 present changed
+#define BQ25798_EVENT_PG (1ULL << 3)           ///< Power good changed
+#define BQ25798_EVENT_POORSRC (1ULL << 4)      ///< Poor source detected
+#define BQ25798_EVENT_WD (1ULL << 5)           ///< I2C watchdog expired
+#define BQ25798_EVENT_VINDPM (1ULL << 6)       ///< Entered VINDPM/VOTG
+#define BQ25798_EVENT_IINDPM (1ULL << 7)       ///< Entered IINDPM/IOTG
+#define BQ25798_EVENT_BC12_DONE (1ULL << 8)    ///< BC1.2 detection done
+#define BQ25798_EVENT_VBAT_PRESENT (1ULL << 9) ///< Battery present changed
+#define BQ25798_EVENT_TREG (1ULL << 10)        ///< Thermal regulation
+#define BQ25798_EVENT_VBUS (1ULL << 12)        ///< VBUS status changed
+#define BQ25798_EVENT_ICO (1ULL << 14)         ///< ICO status changed
+#define BQ25798_EVENT_CHG (1ULL << 15)         ///< Charge status changed
+#define BQ25798_EVENT_TOPOFF_TMR (1ULL << 16)  ///< Top-off timer expired
+#define BQ25798_EVENT_PRECHG_TMR (1ULL << 17)  ///< Pre-charge timer expired
+#define BQ25798_EVENT_TRICHG_TMR (1ULL << 18)  ///< Trickle timer expired
+#define BQ25798_EVENT_CHG_TMR (1ULL << 19)     ///< Fast charge timer expired
+#define BQ25798_EVENT_VSYS (1ULL << 20)        ///< VSYSMIN regulation changed
+#define BQ25798_EVENT_ADC_DONE (1ULL << 21)    ///< ADC conversion done
+#define BQ25798_EVENT_DPDM_DONE (1ULL << 22)   ///< D+/D- detection done
+#define BQ25798_EVENT_TS_HOT (1ULL << 24)      ///< TS crossed hot threshold
+#define BQ25798_EVENT_TS_WARM (1ULL << 25)     ///< TS crossed warm threshold
+#define BQ25798_EVENT_TS_COOL (1ULL << 26)     ///< TS crossed cool threshold
+#define BQ25798_EVENT_TS_COLD (1ULL << 27)     ///< TS crossed cold threshold
+#define BQ25798_EVENT_VBATOTG_LOW (1ULL << 28) ///< VBAT too low for OTG
+#define BQ25798_EVENT_VAC1_OVP (1ULL << 32)    ///< VAC1 over-voltage
+#define BQ25798_EVENT_VAC2_OVP (1ULL << 33)    ///< VAC2 over-voltage
+#define BQ25798_EVENT_CONV_OCP (1ULL << 34)    ///< Converter over-current
+#define BQ25798_EVENT_IBAT_OCP (1ULL << 35)    ///< IBAT over-current
+#define BQ25798_EVENT_IBUS_OCP (1ULL << 36)    ///< IBUS over-current
+#define BQ25798_EVENT_VBAT_OVP (1ULL << 37)    ///< VBAT over-voltage
+#define BQ25798_EVENT_VBUS_OVP (1ULL << 38)    ///< VBUS over-voltage
+#define BQ25798_EVENT_IBAT_REG (1ULL << 39)    ///< IBAT regulation
+#define BQ25798_EVENT_TSHUT (1ULL << 42)       ///< Thermal shutdown
+#define BQ25798_EVENT_OTG_UVP (1ULL << 44)     ///< OTG under-voltage
+#define BQ25798_EVENT_OTG_OVP (1ULL << 45)     ///< OTG over-voltage
+#define BQ25798_EVENT_VSYS_OVP (1ULL << 46)    ///< VSYS over-voltage
+#define BQ25798_EVENT_VSYS_SHORT (1ULL << 47)  ///< VSYS short circuit
+#define BQ25798_EVENT_ALL 0xF4FF1F7FD7FFULL    ///< Every defined event bit
+
+// ADC channels. The high byte mirrors ADC Function Disable 0 (0x2F) and the
+// low byte ADC Function Disable 1 (0x30), so both go out in one write.
+#define BQ25798_ADC_CH_IBUS 0x8000   ///< IBUS channel
+#define BQ25798_ADC_CH_IBAT 0x4000   ///< IBAT channel
+#define BQ25798_ADC_CH_VBUS 0x2000   ///< VBUS channel
+#define BQ25798_ADC_CH_VBAT 0x1000   ///< VBAT channel
+#define BQ25798_ADC_CH_VSYS 0x0800   ///< VSYS channel
+#define BQ25798_ADC_CH_TS 0x0400     ///< TS channel
+#define BQ25798_ADC_CH_TDIE 0x0200   ///< TDIE channel
+#define BQ25798_ADC_CH_DPLUS 0x0080  ///< D+ channel
+#define BQ25798_ADC_CH_DMINUS 0x0040 ///< D- channel
+#define BQ25798_ADC_CH_VAC2 0x0020   ///< VAC2 channel
+#define BQ25798_ADC_CH_VAC1 0x0010   ///< VAC1 channel
+#define BQ25798_ADC_CH_ALL 0xFEF0    ///< Every ADC channel
+
 /*!
  * @brief Battery voltage threshold for precharge to fast charge transition
  */
@@ -263,6 +331,419 @@ typedef enum {
   BQ25798_TSHUT_85C = 0x03   ///< 85°C
 } bq25798_tshut_t;
 
+/*!
+ * @brief Charge voltage in the JEITA warm region (TS between T2 and T3)
+ */
+typedef enum {
+  BQ25798_JEITA_VSET_SUSPEND = 0x00,   ///< Charge suspended
+  BQ25798_JEITA_VSET_MINUS_800 = 0x01, ///< VREG - 800mV
+  BQ25798_JEITA_VSET_MINUS_600 = 0x02, ///< VREG - 600mV
+  BQ25798_JEITA_VSET_MINUS_400 = 0x03, ///< VREG - 400mV (default)
+  BQ25798_JEITA_VSET_MINUS_300 = 0x04, ///< VREG - 300mV
+  BQ25798_JEITA_VSET_MINUS_200 = 0x05, ///< VREG - 200mV
+  BQ25798_JEITA_VSET_MINUS_100 = 0x06, ///< VREG - 100mV
+  BQ25798_JEITA_VSET_UNCHANGED = 0x07  ///< VREG unchanged
+} bq25798_jeita_vset_t;
+
+/*!
+ * @brief Charge current in a JEITA warm or cool region
+ */
+typedef enum {
+  BQ25798_JEITA_ISET_SUSPEND = 0x00,    ///< Charge suspended
+  BQ25798_JEITA_ISET_20_PERCENT = 0x01, ///< 20% of ICHG (cool default)
+  BQ25798_JEITA_ISET_40_PERCENT = 0x02, ///< 40% of ICHG
+  BQ25798_JEITA_ISET_UNCHANGED = 0x03   ///< ICHG unchanged (warm default)
+} bq25798_jeita_iset_t;
+
+/*!
+ * @brief JEITA cool threshold (T2), as a fraction of REGN on TS
+ */
+typedef enum {
+  BQ25798_TS_COOL_5C = 0x00,  ///< 71.1% (5°C)
+  BQ25798_TS_COOL_10C = 0x01, ///< 68.4% (10°C, default)
+  BQ25798_TS_COOL_15C = 0x02, ///< 65.5% (15°C)
+  BQ25798_TS_COOL_20C = 0x03  ///< 62.4% (20°C)
+} bq25798_ts_cool_t;
+
+/*!
+ * @brief JEITA warm threshold (T3), as a fraction of REGN on TS
+ */
+typedef enum {
+  BQ25798_TS_WARM_40C = 0x00, ///< 48.4% (40°C)
+  BQ25798_TS_WARM_45C = 0x01, ///< 44.8% (45°C, default)
+  BQ25798_TS_WARM_50C = 0x02, ///< 41.2% (50°C)
+  BQ25798_TS_WARM_55C = 0x03  ///< 37.7% (55°C)
+} bq25798_ts_warm_t;
+
+/*!
+ * @brief OTG mode hot temperature threshold
+ */
+typedef enum {
+  BQ25798_BHOT_55C = 0x00,    ///< 55°C
+  BQ25798_BHOT_60C = 0x01,    ///< 60°C (default)
+  BQ25798_BHOT_65C = 0x02,    ///< 65°C
+  BQ25798_BHOT_DISABLE = 0x03 ///< Disabled
+} bq25798_bhot_t;
+
+/*!
+ * @brief OTG mode cold temperature threshold
+ */
+typedef enum {
+  BQ25798_BCOLD_MINUS_10C = 0x00, ///< -10°C (default)
+  BQ25798_BCOLD_MINUS_20C = 0x01  ///< -20°C
+} bq25798_bcold_t;
+
+/*!
+ * @brief ADC sample speed / effective resolution setting
+ */
+typedef enum {
+  BQ25798_ADC_SAMPLE_15BIT = 0x00, ///< 15-bit effective resolution (default)
+  BQ25798_ADC_SAMPLE_14BIT = 0x01, ///< 14-bit effective resolution
+  BQ25798_ADC_SAMPLE_13BIT = 0x02, ///< 13-bit effective resolution
+  BQ25798_ADC_SAMPLE_12BIT = 0x03  ///< 12-bit effective resolution
+} bq25798_adc_sample_t;
+
+/*!
+ * @brief Charge status (CHRG_STAT)
+ */
+typedef enum {
+  BQ25798_CHG_STAT_NOT_CHARGING = 0x00, ///< Not charging
+  BQ25798_CHG_STAT_TRICKLE = 0x01,      ///< Trickle charge
+  BQ25798_CHG_STAT_PRECHARGE = 0x02,    ///< Pre-charge
+  BQ25798_CHG_STAT_FAST = 0x03,         ///< Fast charge (CC mode)
+  BQ25798_CHG_STAT_TAPER = 0x04,        ///< Taper charge (CV mode)
+  BQ25798_CHG_STAT_TOPOFF = 0x06,       ///< Top-off timer active charging
+  BQ25798_CHG_STAT_DONE = 0x07          ///< Charge termination done
+} bq25798_chg_stat_t;
+
+/*!
+ * @brief Input source type (VBUS_STAT)
+ */
+typedef enum {
+  BQ25798_VBUS_STAT_NONE = 0x00,          ///< No input or BHOT/BCOLD in OTG
+  BQ25798_VBUS_STAT_USB_SDP = 0x01,       ///< USB SDP (500mA)
+  BQ25798_VBUS_STAT_USB_CDP = 0x02,       ///< USB CDP (1.5A)
+  BQ25798_VBUS_STAT_USB_DCP = 0x03,       ///< USB DCP (3.25A)
+  BQ25798_VBUS_STAT_HVDCP = 0x04,         ///< Adjustable high voltage DCP
+  BQ25798_VBUS_STAT_UNKNOWN = 0x05,       ///< Unknown adaptor (3A)
+  BQ25798_VBUS_STAT_NON_STANDARD = 0x06,  ///< Non-standard adapter
+  BQ25798_VBUS_STAT_OTG = 0x07,           ///< In OTG mode
+  BQ25798_VBUS_STAT_NOT_QUALIFIED = 0x08, ///< Not qualified adaptor
+  BQ25798_VBUS_STAT_DIRECT = 0x0B,        ///< Powered directly from VBUS
+  BQ25798_VBUS_STAT_BACKUP = 0x0C         ///< Backup mode
+} bq25798_vbus_stat_t;
+
+/*!
+ * @brief Input current optimizer status (ICO_STAT)
+ */
+typedef enum {
+  BQ25798_ICO_STAT_DISABLED = 0x00,    ///< ICO disabled
+  BQ25798_ICO_STAT_IN_PROGRESS = 0x01, ///< ICO optimization in progress
+  BQ25798_ICO_STAT_MAX_DETECTED = 0x02 ///< Maximum input current detected
+} bq25798_ico_stat_t;
+
+/*!
+ * @brief Decoded status and fault registers, fetched in a single burst by
+ * getStatus()
+ */
+typedef struct {
+  uint8_t iindpm : 1;       ///< In IINDPM regulation or IOTG regulation
+  uint8_t vindpm : 1;       ///< In VINDPM regulation or VOTG regulation
+  uint8_t wd_expired : 1;   ///< I2C watchdog timer expired
+  uint8_t power_good : 1;   ///< Input source is good
+  uint8_t ac2_present : 1;  ///< VAC2 present
+  uint8_t ac1_present : 1;  ///< VAC1 present
+  uint8_t vbus_present : 1; ///< VBUS present
+
+  uint8_t chg_stat : 3;  ///< Charge status, see bq25798_chg_stat_t
+  uint8_t vbus_stat : 4; ///< Input source type, see bq25798_vbus_stat_t
+  uint8_t bc12_done : 1; ///< BC1.2 or non-standard detection complete
+
+  uint8_t ico_stat : 2;     ///< ICO status, see bq25798_ico_stat_t
+  uint8_t treg : 1;         ///< In thermal regulation
+  uint8_t dpdm_busy : 1;    ///< D+/D- detection ongoing
+  uint8_t vbat_present : 1; ///< Battery present
+
+  uint8_t acrb2 : 1;        ///< ACFET2-RBFET2 placed
+  uint8_t acrb1 : 1;        ///< ACFET1-RBFET1 placed
+  uint8_t adc_done : 1;     ///< One-shot ADC conversion complete
+  uint8_t vsys_min_reg : 1; ///< In VSYSMIN regulation (VBAT < VSYSMIN)
+  uint8_t chg_tmr : 1;      ///< Fast charge safety timer expired
+  uint8_t trichg_tmr : 1;   ///< Trickle charge safety timer expired
+  uint8_t prechg_tmr : 1;   ///< Pre-charge safety timer expired
+  uint8_t vbat_otg_low : 1; ///< VBAT too low to enable OTG
+  uint8_t ts_cold : 1;      ///< TS in cold range (below T1)
+  uint8_t ts_cool : 1;      ///< TS in cool range (T1-T2)
+  uint8_t ts_warm : 1;      ///< TS in warm range (T3-T5)
+  uint8_t ts_hot : 1;       ///< TS in hot range (above T5)
+
+  uint8_t ibat_reg : 1;   ///< Fault: in battery discharge current regulation
+  uint8_t vbus_ovp : 1;   ///< Fault: VBUS over-voltage
+  uint8_t vbat_ovp : 1;   ///< Fault: VBAT over-voltage
+  uint8_t ibus_ocp : 1;   ///< Fault: IBUS over-current
+  uint8_t ibat_ocp : 1;   ///< Fault: IBAT over-current
+  uint8_t conv_ocp : 1;   ///< Fault: converter over-current
+  uint8_t vac2_ovp : 1;   ///< Fault: VAC2 over-voltage
+  uint8_t vac1_ovp : 1;   ///< Fault: VAC1 over-voltage
+  uint8_t vsys_short : 1; ///< Fault: VSYS short circuit
+  uint8_t vsys_ovp : 1;   ///< Fault: VSYS over-voltage
+  uint8_t otg_ovp : 1;    ///< Fault: OTG over-voltage
+  uint8_t otg_uvp : 1;    ///< Fault: OTG under-voltage
+  uint8_t tshut : 1;      ///< Fault: IC thermal shutdown
+} bq25798_status_t;
+
+/*!
+ * @brief Decoded ADC results, fetched in a single burst by readAllADC()
+ */
+typedef struct {
+  int16_t ibus_mA;  ///< Input current in mA (negative in OTG mode)
+  int16_t ibat_mA;  ///< Battery current in mA (positive while charging)
+  uint16_t vbus_mV; ///< VBUS voltage in mV
+  uint16_t vac1_mV; ///< VAC1 voltage in mV
+  uint16_t vac2_mV; ///< VAC2 voltage in mV
+  uint16_t vbat_mV; ///< Battery voltage in mV
+  uint16_t vsys_mV; ///< System voltage in mV
+  uint16_t ts_raw;  ///< TS as a fraction of REGN, 0.0976563 % per LSB
+  int16_t tdie_raw; ///< Die temperature, 0.5 degC per LSB
+  uint16_t dp_mV;   ///< D+ voltage in mV
+  uint16_t dm_mV;   ///< D- voltage in mV
+} bq25798_adc_snapshot_t;
+
+/*!
+ * @brief Battery-specific charge settings, applied with
+ * Adafruit_BQ25798::applyProfile(). Limits are in mV and mA with the same
+ * ranges and steps as the matching setters.
+ */
+typedef struct {
+  uint16_t vsysmin_mV;                 ///< Minimal system voltage
+  uint16_t vreg_mV;                    ///< Charge voltage limit
+  uint16_t ichg_mA;                    ///< Charge current limit
+  uint16_t vindpm_mV;                  ///< Input voltage limit
+  uint16_t iindpm_mA;                  ///< Input current limit
+  uint16_t iprechg_mA;                 ///< Precharge current limit
+  uint16_t iterm_mA;                   ///< Termination current
+  uint16_t vrechg_mV;                  ///< Recharge threshold below VREG
+  bq25798_vbat_lowv_t vbat_lowv;       ///< Precharge to fast charge threshold
+  bq25798_cell_count_t cell_count;     ///< Battery cell count
+  bq25798_prechg_timer_t prechg_timer; ///< Precharge safety timer
+  bq25798_topoff_timer_t topoff_timer; ///< Top-off timer
+  bq25798_chg_timer_t chg_timer;       ///< Fast charge safety timer
+  bool trickle_timer_enable;           ///< Trickle charge timer enable
+  bool prechg_timer_enable;            ///< Precharge timer enable
+  bool chg_timer_enable;               ///< Fast charge timer enable
+  bool timer_half_rate;                ///< Slow timers during DPM/TREG
+  bq25798_jeita_vset_t jeita_vset;     ///< Warm region charge voltage
+  bq25798_jeita_iset_t jeita_iseth;    ///< Warm region charge current
+  bq25798_jeita_iset_t jeita_isetc;    ///< Cool region charge current
+  bq25798_ts_cool_t ts_cool;           ///< JEITA cool threshold
+  bq25798_ts_warm_t ts_warm;           ///< JEITA warm threshold
+  bq25798_bhot_t bhot;                 ///< OTG hot threshold
+  bq25798_bcold_t bcold;               ///< OTG cold threshold
+  bool ts_ignore;                      ///< Ignore the TS pin
+} bq25798_profile_t;
+
+/*!
+ * @brief Register fields known to the field descriptor table, named after the
+ * datasheet bit fields. Used with readField(), getField() and friends.
+ */
+typedef enum {
+  BQ25798_FIELD_VSYSMIN,          ///< Minimal system voltage, mV
+  BQ25798_FIELD_VREG,             ///< Charge voltage limit, mV
+  BQ25798_FIELD_ICHG,             ///< Charge current limit, mA
+  BQ25798_FIELD_VINDPM,           ///< Input voltage limit, mV
+  BQ25798_FIELD_IINDPM,           ///< Input current limit, mA
+  BQ25798_FIELD_VBAT_LOWV,        ///< Precharge to fast charge threshold
+  BQ25798_FIELD_IPRECHG,          ///< Precharge current limit, mA
+  BQ25798_FIELD_REG_RST,          ///< Reset registers to defaults
+  BQ25798_FIELD_STOP_WD_CHG,      ///< Stop charging on watchdog expiry
+  BQ25798_FIELD_ITERM,            ///< Termination current, mA
+  BQ25798_FIELD_CELL,             ///< Battery cell count
+  BQ25798_FIELD_TRECHG,           ///< Recharge deglitch time
+  BQ25798_FIELD_VRECHG,           ///< Recharge threshold offset, mV
+  BQ25798_FIELD_VOTG,             ///< OTG voltage, mV
+  BQ25798_FIELD_PRECHG_TMR,       ///< Precharge safety timer
+  BQ25798_FIELD_IOTG,             ///< OTG current limit, mA
+  BQ25798_FIELD_TOPOFF_TMR,       ///< Top-off timer
+  BQ25798_FIELD_EN_TRICHG_TMR,    ///< Trickle charge timer enable
+  BQ25798_FIELD_EN_PRECHG_TMR,    ///< Precharge timer enable
+  BQ25798_FIELD_EN_CHG_TMR,       ///< Fast charge timer enable
+  BQ25798_FIELD_CHG_TMR,          ///< Fast charge timer
+  BQ25798_FIELD_TMR2X_EN,         ///< Slow safety timers during DPM/TREG
+  BQ25798_FIELD_EN_AUTO_IBATDIS,  ///< Auto battery discharge on VBAT OVP
+  BQ25798_FIELD_FORCE_IBATDIS,    ///< Force battery discharge current
+  BQ25798_FIELD_EN_CHG,           ///< Charge enable
+  BQ25798_FIELD_EN_ICO,           ///< Input current optimizer enable
+  BQ25798_FIELD_FORCE_ICO,        ///< Force input current optimizer
+  BQ25798_FIELD_EN_HIZ,           ///< High impedance mode
+  BQ25798_FIELD_EN_TERM,          ///< Termination enable
+  BQ25798_FIELD_EN_BACKUP,        ///< Backup mode enable
+  BQ25798_FIELD_VBUS_BACKUP,      ///< Backup mode threshold
+  BQ25798_FIELD_VAC_OVP,          ///< VAC over-voltage threshold
+  BQ25798_FIELD_WD_RST,           ///< Watchdog timer reset
+  BQ25798_FIELD_WATCHDOG,         ///< Watchdog timer period
+  BQ25798_FIELD_FORCE_INDET,      ///< Force D+/D- detection
+  BQ25798_FIELD_AUTO_INDET_EN,    ///< Automatic D+/D- detection
+  BQ25798_FIELD_EN_12V,           ///< HVDCP 12V enable
+  BQ25798_FIELD_EN_9V,            ///< HVDCP 9V enable
+  BQ25798_FIELD_HVDCP_EN,         ///< HVDCP handshake enable
+  BQ25798_FIELD_SDRV_CTRL,        ///< Ship FET mode
+  BQ25798_FIELD_SDRV_DLY,         ///< Ship FET 10s delay disable
+  BQ25798_FIELD_DIS_ACDRV,        ///< ACDRV disable
+  BQ25798_FIELD_EN_OTG,           ///< OTG mode enable
+  BQ25798_FIELD_PFM_OTG_DIS,      ///< OTG PFM disable
+  BQ25798_FIELD_PFM_FWD_DIS,      ///< Forward PFM disable
+  BQ25798_FIELD_WKUP_DLY,         ///< Ship mode wakeup delay
+  BQ25798_FIELD_DIS_LDO,          ///< BATFET LDO precharge disable
+  BQ25798_FIELD_DIS_OTG_OOA,      ///< OTG out-of-audio disable
+  BQ25798_FIELD_DIS_FWD_OOA,      ///< Forward out-of-audio disable
+  BQ25798_FIELD_EN_ACDRV2,        ///< ACDRV2 enable
+  BQ25798_FIELD_EN_ACDRV1,        ///< ACDRV1 enable
+  BQ25798_FIELD_PWM_FREQ,         ///< Switching frequency
+  BQ25798_FIELD_DIS_STAT,         ///< STAT pin disable
+  BQ25798_FIELD_DIS_VSYS_SHORT,   ///< VSYS short protection disable
+  BQ25798_FIELD_DIS_VOTG_UVP,     ///< VOTG UVP protection disable
+  BQ25798_FIELD_FORCE_VINDPM_DET, ///< Force VINDPM detection
+  BQ25798_FIELD_EN_IBUS_OCP,      ///< IBUS OCP enable
+  BQ25798_FIELD_SFET_PRESENT,     ///< Ship FET populated
+  BQ25798_FIELD_EN_IBAT,          ///< Battery discharge current sensing
+  BQ25798_FIELD_IBAT_REG,         ///< Battery discharge current regulation
+  BQ25798_FIELD_EN_IINDPM,        ///< IINDPM enable
+  BQ25798_FIELD_EN_EXTILIM,       ///< External ILIM_HIZ pin enable
+  BQ25798_FIELD_EN_BATOC,         ///< Battery discharge OCP enable
+  BQ25798_FIELD_VOC_PCT,          ///< VINDPM as a percentage of VOC
+  BQ25798_FIELD_VOC_DLY,          ///< VOC measurement delay
+  BQ25798_FIELD_VOC_RATE,         ///< VOC measurement interval
+  BQ25798_FIELD_EN_MPPT,          ///< MPPT enable
+  BQ25798_FIELD_TREG,             ///< Thermal regulation threshold
+  BQ25798_FIELD_TSHUT,            ///< Thermal shutdown threshold
+  BQ25798_FIELD_VBUS_PD_EN,       ///< VBUS pulldown enable
+  BQ25798_FIELD_VAC1_PD_EN,       ///< VAC1 pulldown enable
+  BQ25798_FIELD_VAC2_PD_EN,       ///< VAC2 pulldown enable
+  BQ25798_FIELD_BKUP_ACFET1_ON,   ///< Turn on ACFET1 in backup mode
+  BQ25798_FIELD_JEITA_VSET,       ///< JEITA warm region charge voltage
+  BQ25798_FIELD_JEITA_ISETH,      ///< JEITA warm region charge current
+  BQ25798_FIELD_JEITA_ISETC,      ///< JEITA cool region charge current
+  BQ25798_FIELD_TS_COOL,          ///< JEITA cool threshold
+  BQ25798_FIELD_TS_WARM,          ///< JEITA warm threshold
+  BQ25798_FIELD_BHOT,             ///< OTG hot threshold
+  BQ25798_FIELD_BCOLD,            ///< OTG cold threshold
+  BQ25798_FIELD_TS_IGNORE,        ///< Ignore the TS pin
+  BQ25798_FIELD_CHG_STAT,         ///< Charge status
+  BQ25798_FIELD_ADC_DONE_STAT,    ///< One-shot ADC conversion complete
+  BQ25798_FIELD_ADC_EN,           ///< ADC enable
+  BQ25798_FIELD_ADC_RATE,         ///< ADC one-shot mode
+  BQ25798_FIELD_ADC_SAMPLE,       ///< ADC resolution
+  BQ25798_FIELD_ADC_AVG,          ///< ADC running average
+  BQ25798_FIELD_ADC_AVG_INIT,     ///< ADC average starts from a new conversion
+  BQ25798_FIELD_PART_INFO,        ///< Part number and revision
+  BQ25798_FIELD_COUNT             ///< Number of fields in the descriptor table
+} bq25798_field_t;
+
+/*!
+ * @brief Progress of a transfer started with Adafruit_BQ25798_Bus::startRead()
+ * or startWrite()
+ */
+typedef enum {
+  BQ25798_XFER_DONE = 0x00, ///< Finished successfully
+  BQ25798_XFER_BUSY = 0x01, ///< Still on the bus
+  BQ25798_XFER_ERROR = 0x02 ///< Finished with an error
+} bq25798_xfer_state_t;
+
+/*!
+ * @brief A multi-register field write worked out by the driver: the span of
+ * registers involved, which bits of each are written, and their new contents
+ */
+typedef struct {
+  uint8_t first;                           ///< First register of the span
+  uint8_t len;                             ///< Registers in the span
+  bool cached;                             ///< buffer was filled from cache
+  uint8_t touched[BQ25798_FIELD_SPAN_MAX]; ///< Bits written, per register
+  uint8_t buffer[BQ25798_FIELD_SPAN_MAX];  ///< Register contents
+} bq25798_field_plan_t;
+
+/*!
+ * @brief Register-level transport used by Adafruit_BQ25798
+ *
+ * The driver only ever reads or writes runs of consecutive registers, so a
+ * backend needs just these two calls. Adafruit_BQ25798_I2CBus goes through
+ * BusIO and TwoWire; Adafruit_BQ25798_LinuxI2C talks to /dev/i2c-N.
+ *
+ * Backends with interrupt or DMA driven transfers can also override
+ * startRead(), startWrite() and transferState() so Adafruit_BQ25798_Async
+ * does not wait on the bus. By default those run the blocking calls.
+ */
+class Adafruit_BQ25798_Bus {
+ public:
+  virtual ~Adafruit_BQ25798_Bus() {}
+
+  /*!
+   * @brief Burst read consecutive registers
+   * @param reg First register address
+   * @param buffer Destination buffer
+   * @param len Number of bytes to read
+   * @return True if successful
+   */
+  virtual bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t len) = 0;
+
+  /*!
+   * @brief Burst write consecutive registers
+   * @param reg First register address
+   * @param buffer Source buffer
+   * @param len Number of bytes to write
+   * @return True if successful
+   */
+  virtual bool writeRegisters(uint8_t reg, const uint8_t* buffer,
+                              uint8_t len) = 0;
+
+  /*!
+   * @brief Start a burst read that may finish after this call returns. The
+   * buffer must stay valid until transferState() stops reporting busy.
+   * @param reg First register address
+   * @param buffer Destination buffer
+   * @param len Number of bytes to read
+   * @return True if the transfer started (or already finished) successfully
+   */
+  virtual bool startRead(uint8_t reg, uint8_t* buffer, uint8_t len) {
+    return readRegisters(reg, buffer, len);
+  }
+
+  /*!
+   * @brief Start a burst write that may finish after this call returns. The
+   * buffer must stay valid until transferState() stops reporting busy.
+   * @param reg First register address
+   * @param buffer Source buffer
+   * @param len Number of bytes to write
+   * @return True if the transfer started (or already finished) successfully
+   */
+  virtual bool startWrite(uint8_t reg, const uint8_t* buffer, uint8_t len) {
+    return writeRegisters(reg, buffer, len);
+  }
+
+  /*!
+   * @brief Get the progress of the last startRead() or startWrite()
+   * @return BQ25798_XFER_BUSY while on the bus, then DONE or ERROR
+   */
+  virtual bq25798_xfer_state_t transferState() {
+    return BQ25798_XFER_DONE;
+  }
+};
+
+/*!
+ * @brief Adafruit_BQ25798_Bus over an Arduino TwoWire port via BusIO
+ */
+class Adafruit_BQ25798_I2CBus : public Adafruit_BQ25798_Bus {
+ public:
+  Adafruit_BQ25798_I2CBus(uint8_t i2c_addr = BQ25798_DEFAULT_ADDR,
+                          TwoWire* wire = &Wire);
+
+  bool begin();
+  bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t len);
+  bool writeRegisters(uint8_t reg, const uint8_t* buffer, uint8_t len);
+
+ private:
+  Adafruit_I2CDevice i2c_dev; ///< BusIO device at the charger's address
+};
+
 /*!
  * @brief BQ25798 I2C controlled buck-boost battery charger
  */
@@ -271,34 +752,67 @@ class Adafruit_BQ25798 {
   Adafruit_BQ25798();
   ~Adafruit_BQ25798();
 
-  bool begin(uint8_t i2c_addr = BQ25798_DEFAULT_ADDR, TwoWire* wire = &Wire);
+  bool begin(uint8_t i2c_addr = BQ25798_DEFAULT_ADDR, TwoWire* wire = &Wire,
+             bool reset_registers = true);
+  bool begin(Adafruit_BQ25798_Bus* bus, bool reset_registers = true);
+
+  bool getCacheEnable();
+  bool setCacheEnable(bool enable);
+  bool refreshCache();
+
+  uint16_t readField(bq25798_field_t field);
+  bool writeField(bq25798_field_t field, uint16_t code);
+  uint16_t getField(bq25798_field_t field);
+  bool setField(bq25798_field_t field, uint16_t value);
+  bool getFields(const bq25798_field_t* fields, uint16_t* values,
+                 uint8_t count);
+  bool setFields(const bq25798_field_t* fields, const uint16_t* values,
+                 uint8_t count);
+
+  void beginUpdate();
+  bool commit();
+  void cancelUpdate();
 
   float getMinSystemV();
   bool setMinSystemV(float voltage);
+  uint16_t getMinSystem_mV();
+  bool setMinSystem_mV(uint16_t voltage);
 
   float getChargeLimitV();
   bool setChargeLimitV(float voltage);
+  uint16_t getChargeLimit_mV();
+  bool setChargeLimit_mV(uint16_t voltage);
 
   float getChargeLimitA();
   bool setChargeLimitA(float current);
+  uint16_t getChargeLimit_mA();
+  bool setChargeLimit_mA(uint16_t current);
 
   float getInputLimitV();
   bool setInputLimitV(float voltage);
+  uint16_t getInputLimit_mV();
+  bool setInputLimit_mV(uint16_t voltage);
 
   float getInputLimitA();
   bool setInputLimitA(float current);
+  uint16_t getInputLimit_mA();
+  bool setInputLimit_mA(uint16_t current);
 
   bq25798_vbat_lowv_t getVBatLowV();
   bool setVBatLowV(bq25798_vbat_lowv_t threshold);
 
   float getPrechargeLimitA();
   bool setPrechargeLimitA(float current);
+  uint16_t getPrechargeLimit_mA();
+  bool setPrechargeLimit_mA(uint16_t current);
 
   bool getStopOnWDT();
   bool setStopOnWDT(bool stopOnWDT);
 
   float getTerminationA();
   bool setTerminationA(float current);
+  uint16_t getTermination_mA();
+  bool setTermination_mA(uint16_t current);
 
   bq25798_cell_count_t getCellCount();
   bool setCellCount(bq25798_cell_count_t cellCount);
@@ -308,15 +822,21 @@ class Adafruit_BQ25798 {
 
   float getRechargeThreshOffsetV();
   bool setRechargeThreshOffsetV(float voltage);
+  uint16_t getRechargeThreshOffset_mV();
+  bool setRechargeThreshOffset_mV(uint16_t voltage);
 
   float getOTGV();
   bool setOTGV(float voltage);
+  uint16_t getOTG_mV();
+  bool setOTG_mV(uint16_t voltage);
 
   bq25798_prechg_timer_t getPrechargeTimer();
   bool setPrechargeTimer(bq25798_prechg_timer_t timer);
 
   float getOTGLimitA();
   bool setOTGLimitA(float current);
+  uint16_t getOTGLimit_mA();
+  bool setOTGLimit_mA(uint16_t current);
 
   bq25798_topoff_timer_t getTopOffTimer();
   bool setTopOffTimer(bq25798_topoff_timer_t timer);
@@ -367,6 +887,7 @@ class Adafruit_BQ25798 {
   bool setVACOVP(bq25798_vac_ovp_t threshold);
 
   bool resetWDT();
+  bool service();
 
   bq25798_wdt_t getWDT();
   bool setWDT(bq25798_wdt_t timer);
@@ -488,10 +1009,121 @@ class Adafruit_BQ25798 {
   bool getBackupACFET1on();
   bool setBackupACFET1on(bool enable);
 
+  bq25798_jeita_vset_t getJEITAWarmVoltage();
+  bool setJEITAWarmVoltage(bq25798_jeita_vset_t setting);
+
+  bq25798_jeita_iset_t getJEITAWarmCurrent();
+  bool setJEITAWarmCurrent(bq25798_jeita_iset_t setting);
+
+  bq25798_jeita_iset_t getJEITACoolCurrent();
+  bool setJEITACoolCurrent(bq25798_jeita_iset_t setting);
+
+  bq25798_ts_cool_t getTSCoolThresh();
+  bool setTSCoolThresh(bq25798_ts_cool_t threshold);
+
+  bq25798_ts_warm_t getTSWarmThresh();
+  bool setTSWarmThresh(bq25798_ts_warm_t threshold);
+
+  bq25798_bhot_t getOTGHotThresh();
+  bool setOTGHotThresh(bq25798_bhot_t threshold);
+
+  bq25798_bcold_t getOTGColdThresh();
+  bool setOTGColdThresh(bq25798_bcold_t threshold);
+
+  bool getTSIgnore();
+  bool setTSIgnore(bool ignore);
+
+  bool getADCEnable();
+  bool setADCEnable(bool enable);
+
+  bool getADCOneShot();
+  bool setADCOneShot(bool oneShot);
+
+  bq25798_adc_sample_t getADCResolution();
+  bool setADCResolution(bq25798_adc_sample_t resolution);
+
+  bool getADCAverage();
+  bool setADCAverage(bool enable);
+
+  bool getADCAverageInit();
+  bool setADCAverageInit(bool enable);
+
+  bool startADCOneShot();
+  bool getADCDone();
+
+  uint16_t getADCDisableMask();
+  bool setADCDisableMask(uint16_t channels);
+  static uint16_t getADCCycleTime(uint16_t disabled,
+                                  bq25798_adc_sample_t resolution);
+
   bool reset();
 
+  bool applyProfile(const bq25798_profile_t& profile);
+  bool getProfile(bq25798_profile_t& profile);
+
+  bool saveConfig(uint8_t* buffer);
+  bool loadConfig(const uint8_t* buffer);
+  bool verifyConfig(const uint8_t* buffer);
+
+  bool readAllADC(bq25798_adc_snapshot_t& snapshot);
+  bool readInputADC(uint16_t& vbus_mV, int16_t& ibus_mA);
+  bool readBatteryADC(uint16_t& vbat_mV, int16_t& ibat_mA);
+  bool getStatus(bq25798_status_t& status);
+  bq25798_chg_stat_t getChargeStatus();
+
+  bool attachInterruptPin(uint8_t pin);
+  void detachInterruptPin();
+  void handleInterrupt();
+  bool interruptPending();
+  bool updateEvents(bool force = false);
+  uint64_t takeEvents(uint64_t mask = BQ25798_EVENT_ALL);
+
+  uint64_t getEventMask();
+  bool setEventMask(uint64_t mask);
+
  private:
-  Adafruit_I2CDevice* i2c_dev; ///< Pointer to I2C bus interface
+  static void irqHandler();
+  static Adafruit_BQ25798* irq_instance; ///< Charger owning irqHandler()
+
+  friend class Adafruit_BQ25798_Async;
+
+  void setBus(Adafruit_BQ25798_Bus* bus, bool owned);
+  bool init(bool reset_registers);
+  bool planFields(const bq25798_field_t* fields, const uint16_t* values,
+                  uint8_t count, bq25798_field_plan_t& plan);
+  static void mergeFields(const bq25798_field_t* fields,
+                          const uint16_t* values, uint8_t count,
+                          bq25798_field_plan_t& plan);
+  static bool nextRun(const bq25798_field_plan_t& plan, uint8_t& pos,
+                      uint8_t& run, uint8_t& len);
+  static void decodeStatus(const uint8_t* buffer, bq25798_status_t& status);
+  static void decodeADC(const uint8_t* buffer,
+                        bq25798_adc_snapshot_t& snapshot);
+  void absorbRegisters(uint8_t reg, const uint8_t* buffer, uint8_t len);
+  bool watchdogDue(uint8_t quarters);
+  void overlayStaged(uint8_t reg, uint8_t* buffer, uint8_t len);
+  bool readConfig(const uint8_t* buffer, uint8_t* target, uint8_t* chip);
+  bool shadowHolds(uint8_t reg, uint8_t width, uint16_t mask, bool for_write);
+  bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t len);
+  bool writeRegisters(uint8_t reg, const uint8_t* buffer, uint8_t len);
+  uint16_t readBits(uint8_t reg, uint8_t width, uint8_t bits, uint8_t shift);
+  bool writeBits(uint8_t reg, uint8_t width, uint8_t bits, uint8_t shift,
+                 uint16_t value);
+
+  Adafruit_BQ25798_Bus* bus;                ///< Register transport
+  bool bus_owned;                           ///< bus was created by begin()
+  uint8_t shadow[BQ25798_SHADOW_SIZE];      ///< RAM copy of control registers
+  bool cache_enabled;                       ///< Serve getters from the shadow
+  bool cache_valid;                         ///< Shadow is in sync with the chip
+  bool updating;                            ///< Setters are being staged
+  uint8_t staged[BQ25798_SHADOW_SIZE];      ///< Register bits awaiting commit()
+  uint8_t staged_bits[BQ25798_SHADOW_SIZE]; ///< Which bits of staged are set
+  int16_t int_pin;                          ///< INT pin, or -1 if not attached
+  volatile bool int_pending;                ///< INT fell since the last update
+  uint64_t pending_events;                  ///< Latched, undrained event flags
+  uint8_t wdt_code;                         ///< WATCHDOG field, 0xFF if unknown
+  bool wdt_synced;                          ///< wdt_kicked_at is trustworthy
+  uint32_t wdt_kicked_at;                   ///< millis() of the last WD_RST
 };
 
 #endif // __ADAFRUIT_BQ25798_H__
\ No newline at end of file
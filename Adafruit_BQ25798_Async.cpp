@@ -0,0 +1,279 @@
+/*!
+ * @file Adafruit_BQ25798_Async.cpp
+ *
+ * Non-blocking request engine for the Adafruit BQ25798 battery charger
+ * library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Async.h"
+
+/*!
+ * @brief  Instantiates a request engine for a charger
+ * @param  charger
+ *         Charger to drive. begin() must have succeeded before the first
+ *         request is submitted.
+ */
+Adafruit_BQ25798_Async::Adafruit_BQ25798_Async(Adafruit_BQ25798* charger)
+    : charger(charger) {
+  fields = NULL;
+  values = NULL;
+  count = 0;
+  dest = NULL;
+  callback = NULL;
+  context = NULL;
+  kind = KIND_STATUS;
+  step = STEP_IDLE;
+  pos = 0;
+  xfer_reg = 0;
+  xfer_len = 0;
+  in_flight = false;
+  max_burst = 0;
+  plan.first = 0;
+  plan.len = 0;
+  plan.cached = false;
+}
+
+/*!
+ * @brief Queue a read of the status and fault registers, as getStatus()
+ * @param status Destination, written when the request completes
+ * @param callback Called with the result when the request completes
+ * @param context Passed to the callback
+ * @return True if queued, false if a request is already busy
+ */
+bool Adafruit_BQ25798_Async::requestStatus(bq25798_status_t* status,
+                                           bq25798_async_callback_t callback,
+                                           void* context) {
+  if (!submit(KIND_STATUS, status, callback, context)) {
+    return false;
+  }
+
+  plan.first = BQ25798_REG_CHARGER_STATUS_0;
+  plan.len = BQ25798_STATUS_BLOCK_SIZE;
+  step = STEP_READ;
+  return true;
+}
+
+/*!
+ * @brief Queue a read of every ADC result register, as readAllADC()
+ * @param snapshot Destination, written when the request completes
+ * @param callback Called with the result when the request completes
+ * @param context Passed to the callback
+ * @return True if queued, false if a request is already busy
+ */
+bool Adafruit_BQ25798_Async::requestADC(bq25798_adc_snapshot_t* snapshot,
+                                        bq25798_async_callback_t callback,
+                                        void* context) {
+  if (!submit(KIND_ADC, snapshot, callback, context)) {
+    return false;
+  }
+
+  plan.first = BQ25798_REG_IBUS_ADC;
+  plan.len = BQ25798_ADC_BLOCK_SIZE;
+  step = STEP_READ;
+  return true;
+}
+
+/*!
+ * @brief Queue a multi-field write, as setFields()
+ *
+ * Values are range checked here, so a bad value fails the submit rather
+ * than the request. The registers spanning the fields are read (unless the
+ * register cache holds them), then each touched run is written back.
+ *
+ * @param fields Fields to write; must stay valid until the request completes
+ * @param values Values as for setField(); must stay valid until the request
+ * completes
+ * @param count Number of fields
+ * @param callback Called with the result when the request completes
+ * @param context Passed to the callback
+ * @return True if queued, false if busy, a value is out of range, or the
+ * fields span more than BQ25798_FIELD_SPAN_MAX registers
+ */
+bool Adafruit_BQ25798_Async::requestFields(const bq25798_field_t* fields,
+                                           const uint16_t* values,
+                                           uint8_t count,
+                                           bq25798_async_callback_t callback,
+                                           void* context) {
+  if (busy() || !charger->planFields(fields, values, count, plan)) {
+    return false;
+  }
+  if (!submit(KIND_FIELDS, NULL, callback, context)) {
+    return false;
+  }
+
+  this->fields = fields;
+  this->values = values;
+  this->count = count;
+
+  if (plan.cached) {
+    Adafruit_BQ25798::mergeFields(fields, values, count, plan);
+    step = STEP_WRITE;
+  } else {
+    step = STEP_READ;
+  }
+  return true;
+}
+
+/*!
+ * @brief Advance the request in flight by at most one bus transfer
+ *
+ * Call from the main loop until the result is no longer
+ * BQ25798_ASYNC_BUSY, or from the backend's transfer-complete interrupt.
+ * The callback, if any, runs inside the poll() that finishes the request.
+ *
+ * @return BQ25798_ASYNC_BUSY while in progress, BQ25798_ASYNC_DONE or
+ * BQ25798_ASYNC_ERROR once when the request finishes, then
+ * BQ25798_ASYNC_IDLE
+ */
+bq25798_async_state_t Adafruit_BQ25798_Async::poll() {
+  if (step == STEP_IDLE) {
+    return BQ25798_ASYNC_IDLE;
+  }
+
+  if (in_flight) {
+    bq25798_xfer_state_t state = charger->bus->transferState();
+    if (state == BQ25798_XFER_BUSY) {
+      return BQ25798_ASYNC_BUSY;
+    }
+    in_flight = false;
+    if (state == BQ25798_XFER_ERROR) {
+      return finish(false);
+    }
+
+    charger->absorbRegisters(
+        xfer_reg, plan.buffer + (xfer_reg - plan.first), xfer_len);
+
+    if (step == STEP_READ) {
+      pos += xfer_len;
+      if (pos >= plan.len) {
+        if (kind == KIND_STATUS) {
+          Adafruit_BQ25798::decodeStatus(plan.buffer,
+                                         *(bq25798_status_t*)dest);
+          return finish(true);
+        }
+        if (kind == KIND_ADC) {
+          Adafruit_BQ25798::decodeADC(plan.buffer,
+                                      *(bq25798_adc_snapshot_t*)dest);
+          return finish(true);
+        }
+        Adafruit_BQ25798::mergeFields(fields, values, count, plan);
+        step = STEP_WRITE;
+        pos = 0;
+      }
+    }
+  }
+
+  return startNext();
+}
+
+/*!
+ * @brief Check whether a request is in progress
+ * @return True from a successful submit until the request finishes
+ */
+bool Adafruit_BQ25798_Async::busy() {
+  return step != STEP_IDLE;
+}
+
+/*!
+ * @brief Limit how many registers a single read transfer fetches
+ *
+ * With a blocking bus each poll() waits for one transfer, so this bounds
+ * the time spent in poll(): at 400 kHz each byte costs about 23 us on top
+ * of roughly 70 us for the address phases. The limit is rounded down to an
+ * even count, at least 2, so 16-bit ADC words are never split.
+ *
+ * @param bytes Longest read per transfer, or 0 for no limit
+ */
+void Adafruit_BQ25798_Async::setMaxBurst(uint8_t bytes) {
+  if (bytes == 0) {
+    max_burst = 0;
+  } else {
+    max_burst = bytes < 2 ? 2 : (bytes & 0xFE);
+  }
+}
+
+/*!
+ * @brief Get the read transfer length limit
+ * @return Longest read per transfer, or 0 for no limit
+ */
+uint8_t Adafruit_BQ25798_Async::getMaxBurst() {
+  return max_burst;
+}
+
+/*!
+ * @brief Claim the engine for a new request
+ * @param kind Request type
+ * @param dest Status or snapshot destination
+ * @param callback Completion callback, or NULL
+ * @param context Callback argument
+ * @return False if a request is busy or the charger has no bus
+ */
+bool Adafruit_BQ25798_Async::submit(kind_t kind, void* dest,
+                                    bq25798_async_callback_t callback,
+                                    void* context) {
+  if (busy() || !charger->bus) {
+    return false;
+  }
+
+  this->kind = kind;
+  this->dest = dest;
+  this->callback = callback;
+  this->context = context;
+  pos = 0;
+  in_flight = false;
+  return true;
+}
+
+/*!
+ * @brief Start the next read chunk or write run, or finish if none is left
+ * @return BQ25798_ASYNC_BUSY if a transfer started, otherwise the result
+ */
+bq25798_async_state_t Adafruit_BQ25798_Async::startNext() {
+  if (step == STEP_READ) {
+    xfer_reg = plan.first + pos;
+    xfer_len = plan.len - pos;
+    if (max_burst && xfer_len > max_burst) {
+      xfer_len = max_burst;
+    }
+    in_flight = true;
+    if (!charger->bus->startRead(xfer_reg, plan.buffer + pos, xfer_len)) {
+      return finish(false);
+    }
+    return BQ25798_ASYNC_BUSY;
+  }
+
+  uint8_t run;
+  if (!Adafruit_BQ25798::nextRun(plan, pos, run, xfer_len)) {
+    return finish(true);
+  }
+
+  xfer_reg = plan.first + run;
+  in_flight = true;
+  if (!charger->bus->startWrite(xfer_reg, plan.buffer + run, xfer_len)) {
+    return finish(false);
+  }
+  return BQ25798_ASYNC_BUSY;
+}
+
+/*!
+ * @brief End the request and run its callback
+ * @param ok True if the request succeeded
+ * @return BQ25798_ASYNC_DONE or BQ25798_ASYNC_ERROR
+ */
+bq25798_async_state_t Adafruit_BQ25798_Async::finish(bool ok) {
+  // Go idle first so the callback can submit the next request
+  step = STEP_IDLE;
+  in_flight = false;
+
+  if (callback) {
+    callback(ok, context);
+  }
+
+  return ok ? BQ25798_ASYNC_DONE : BQ25798_ASYNC_ERROR;
+}
@@ -0,0 +1,114 @@
+/*!
+ * @file Adafruit_BQ25798_Async.h
+ *
+ * Non-blocking request engine for the Adafruit BQ25798 battery charger
+ * library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_ASYNC_H__
+#define __ADAFRUIT_BQ25798_ASYNC_H__
+
+#include "Adafruit_BQ25798.h"
+
+/*!
+ * @brief Result of Adafruit_BQ25798_Async::poll()
+ */
+typedef enum {
+  BQ25798_ASYNC_IDLE = 0x00, ///< No request submitted
+  BQ25798_ASYNC_BUSY = 0x01, ///< Request in progress
+  BQ25798_ASYNC_DONE = 0x02, ///< Request just finished successfully
+  BQ25798_ASYNC_ERROR = 0x03 ///< Request just failed
+} bq25798_async_state_t;
+
+/*!
+ * @brief Completion callback for Adafruit_BQ25798_Async requests
+ * @param ok True if the request succeeded
+ * @param context Pointer passed when the request was submitted
+ */
+typedef void (*bq25798_async_callback_t)(bool ok, void* context);
+
+/*!
+ * @brief Runs status reads, ADC reads and field writes as small steps
+ *
+ * Submitting a request never touches the bus. Each poll() call starts at
+ * most one bus transfer, or collects the one in flight, so a control loop
+ * can call it once per tick without stalling for a whole burst. poll() may
+ * also be called from a backend's transfer-complete interrupt, as long as
+ * it never runs in two contexts at once.
+ *
+ * With a blocking backend (TwoWire through BusIO) each transfer still
+ * blocks inside poll(); setMaxBurst() splits long reads into shorter
+ * transfers to bound that time. Backends that override
+ * Adafruit_BQ25798_Bus::startRead() and friends return immediately.
+ *
+ * Only one request is in flight at a time. Blocking calls on the same
+ * charger must not be mixed in while a request is busy.
+ */
+class Adafruit_BQ25798_Async {
+ public:
+  Adafruit_BQ25798_Async(Adafruit_BQ25798* charger);
+
+  bool requestStatus(bq25798_status_t* status,
+                     bq25798_async_callback_t callback = NULL,
+                     void* context = NULL);
+  bool requestADC(bq25798_adc_snapshot_t* snapshot,
+                  bq25798_async_callback_t callback = NULL,
+                  void* context = NULL);
+  bool requestFields(const bq25798_field_t* fields, const uint16_t* values,
+                     uint8_t count, bq25798_async_callback_t callback = NULL,
+                     void* context = NULL);
+
+  bq25798_async_state_t poll();
+  bool busy();
+
+  void setMaxBurst(uint8_t bytes);
+  uint8_t getMaxBurst();
+
+ private:
+  /*!
+   * @brief What the current request is doing
+   */
+  typedef enum {
+    STEP_IDLE, ///< Nothing to do
+    STEP_READ, ///< Reading plan.len bytes from plan.first
+    STEP_WRITE ///< Writing the touched runs of plan
+  } step_t;
+
+  /*!
+   * @brief Which request is in flight
+   */
+  typedef enum {
+    KIND_STATUS, ///< requestStatus()
+    KIND_ADC,    ///< requestADC()
+    KIND_FIELDS  ///< requestFields()
+  } kind_t;
+
+  bool submit(kind_t kind, void* dest, bq25798_async_callback_t callback,
+              void* context);
+  bq25798_async_state_t startNext();
+  bq25798_async_state_t finish(bool ok);
+
+  Adafruit_BQ25798* charger;         ///< Charger being driven
+  bq25798_field_plan_t plan;         ///< Registers and buffer of the request
+  const bq25798_field_t* fields;     ///< requestFields() fields
+  const uint16_t* values;            ///< requestFields() values
+  uint8_t count;                     ///< requestFields() field count
+  void* dest;                        ///< Status or snapshot destination
+  bq25798_async_callback_t callback; ///< Completion callback, or NULL
+  void* context;                     ///< Callback argument
+  kind_t kind;                       ///< Request type
+  volatile step_t step;              ///< Current step
+  uint8_t pos;                       ///< Bytes read, or run search position
+  uint8_t xfer_reg;                  ///< Register of the transfer in flight
+  uint8_t xfer_len;                  ///< Length of the transfer in flight
+  bool in_flight;                    ///< A transfer has been started
+  uint8_t max_burst;                 ///< Longest read per transfer, 0 = any
+};
+
+#endif // __ADAFRUIT_BQ25798_ASYNC_H__
@@ -0,0 +1,178 @@
+/*!
+ * @file Adafruit_BQ25798_CoulombCounter.cpp
+ *
+ * Coulomb counter integrating the BQ25798 battery current ADC, for the
+ * Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_CoulombCounter.h"
+
+/*!
+ * @brief Half mA x us per uAh
+ */
+#define HALF_MAUS_PER_UAH 7200000LL
+
+/*!
+ * @brief  Instantiates a counter
+ * @param  charger
+ *         Charger read by update(). Leave NULL to feed samples taken
+ *         elsewhere, such as readAllADC() snapshots, through addSample().
+ */
+Adafruit_BQ25798_CoulombCounter::Adafruit_BQ25798_CoulombCounter(
+    Adafruit_BQ25798* charger)
+    : charger(charger) {
+  in_half_mAus = 0;
+  out_half_mAus = 0;
+  offset_x256 = 0;
+  rest_samples = 0;
+  current_mA = 0;
+  sampled_at = 0;
+  sampled = false;
+}
+
+/*!
+ * @brief Read and count one IBAT sample; call from the main loop
+ *
+ * Costs two reads: IBAT in a short ADC burst, then the charge status byte.
+ * A charger reporting termination counts as a rest state, as does the
+ * caller passing at_rest.
+ *
+ * @param at_rest True if the caller knows the battery is idle, e.g. with
+ * the load switched off and no input
+ * @return True if successful, false on a bus error or without a charger
+ */
+bool Adafruit_BQ25798_CoulombCounter::update(bool at_rest) {
+  if (charger == NULL) {
+    return false;
+  }
+
+  uint16_t vbat_mV;
+  int16_t ibat_mA;
+  if (!charger->readBatteryADC(vbat_mV, ibat_mA)) {
+    return false;
+  }
+  uint32_t now = micros();
+
+  if (!at_rest) {
+    // Termination means the battery is full and neither charging nor
+    // supplying the system
+    at_rest = charger->getChargeStatus() == BQ25798_CHG_STAT_DONE;
+  }
+
+  addSample(ibat_mA, now, at_rest);
+  return true;
+}
+
+/*!
+ * @brief Count one IBAT sample taken elsewhere
+ * @param ibat_mA Raw IBAT reading in mA, positive while charging
+ * @param now_us micros() when the sample was taken
+ * @param at_rest True if the battery is known to be idle, so the reading
+ * is the ADC offset
+ */
+void Adafruit_BQ25798_CoulombCounter::addSample(int16_t ibat_mA,
+                                                uint32_t now_us,
+                                                bool at_rest) {
+  int16_t current;
+
+  if (at_rest && ibat_mA >= -BQ25798_COULOMB_MAX_OFFSET_MA &&
+      ibat_mA <= BQ25798_COULOMB_MAX_OFFSET_MA) {
+    // Running mean of the first 16 rest samples, then a moving average
+    if (rest_samples < 16) {
+      rest_samples++;
+    }
+    offset_x256 += ((int32_t)ibat_mA * 256 - offset_x256) / rest_samples;
+    current = 0;
+  } else {
+    current = ibat_mA - getOffset_mA();
+  }
+
+  if (sampled) {
+    // Unsigned subtraction copes with one micros() wrap
+    int64_t area = (int64_t)((int32_t)current_mA + current) *
+                   (uint32_t)(now_us - sampled_at);
+    if (area > 0) {
+      in_half_mAus += area;
+    } else {
+      out_half_mAus -= area;
+    }
+  }
+
+  current_mA = current;
+  sampled_at = now_us;
+  sampled = true;
+}
+
+/*!
+ * @brief Zero the charge totals, keeping the learned offset
+ */
+void Adafruit_BQ25798_CoulombCounter::clear() {
+  in_half_mAus = 0;
+  out_half_mAus = 0;
+}
+
+/*!
+ * @brief Get the charge that has gone into the battery
+ * @return Charge in mAh
+ */
+float Adafruit_BQ25798_CoulombCounter::getChargeIn_mAh() {
+  return (float)in_half_mAus / (HALF_MAUS_PER_UAH * 1000);
+}
+
+/*!
+ * @brief Get the charge that has been taken out of the battery
+ * @return Charge in mAh
+ */
+float Adafruit_BQ25798_CoulombCounter::getChargeOut_mAh() {
+  return (float)out_half_mAus / (HALF_MAUS_PER_UAH * 1000);
+}
+
+/*!
+ * @brief Get the charge gained since the counter started or was cleared
+ * @return Charge in mAh, negative if more went out than in
+ */
+float Adafruit_BQ25798_CoulombCounter::getNet_mAh() {
+  return (float)(in_half_mAus - out_half_mAus) / (HALF_MAUS_PER_UAH * 1000);
+}
+
+/*!
+ * @brief Get the charge gained since the counter started or was cleared,
+ * without floating point
+ * @return Charge in uAh, negative if more went out than in
+ */
+int32_t Adafruit_BQ25798_CoulombCounter::getNet_uAh() {
+  return (int32_t)((in_half_mAus - out_half_mAus) / HALF_MAUS_PER_UAH);
+}
+
+/*!
+ * @brief Get the battery current from the last sample, offset corrected
+ * @return Current in mA, positive while charging, 0 at rest
+ */
+int16_t Adafruit_BQ25798_CoulombCounter::getCurrent_mA() {
+  return current_mA;
+}
+
+/*!
+ * @brief Get the IBAT offset learned from rest samples
+ * @return Offset in mA, rounded to nearest
+ */
+int16_t Adafruit_BQ25798_CoulombCounter::getOffset_mA() {
+  int32_t half = offset_x256 < 0 ? -128 : 128;
+  return (int16_t)((offset_x256 + half) / 256);
+}
+
+/*!
+ * @brief Set the IBAT offset, e.g. one saved from an earlier run; later
+ * rest samples keep refining it
+ * @param offset Offset in mA
+ */
+void Adafruit_BQ25798_CoulombCounter::setOffset_mA(int16_t offset) {
+  offset_x256 = (int32_t)offset * 256;
+  rest_samples = 16;
+}
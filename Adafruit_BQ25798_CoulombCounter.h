@@ -0,0 +1,64 @@
+/*!
+ * @file Adafruit_BQ25798_CoulombCounter.h
+ *
+ * Coulomb counter integrating the BQ25798 battery current ADC, for the
+ * Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_COULOMBCOUNTER_H__
+#define __ADAFRUIT_BQ25798_COULOMBCOUNTER_H__
+
+#include "Adafruit_BQ25798.h"
+
+#define BQ25798_COULOMB_MAX_OFFSET_MA 50 ///< Largest rest reading trusted
+
+/*!
+ * @brief Counts charge into and out of the battery from IBAT samples
+ *
+ * Each sample's current is integrated against a micros() timestamp using
+ * the trapezoid rule, in 64-bit integer mA x us so no charge is lost to
+ * rounding between samples. Samples must be less than 71 minutes apart,
+ * when micros() wraps.
+ *
+ * The IBAT ADC reads a few mA off zero. Samples taken while the battery is
+ * known to be idle, because the charger reports termination or the caller
+ * says so, are averaged into an offset that is subtracted from every other
+ * sample, and count as no current at all. Rest readings more than
+ * BQ25798_COULOMB_MAX_OFFSET_MA from zero are taken as real current and
+ * counted normally.
+ */
+class Adafruit_BQ25798_CoulombCounter {
+ public:
+  Adafruit_BQ25798_CoulombCounter(Adafruit_BQ25798* charger = NULL);
+
+  bool update(bool at_rest = false);
+  void addSample(int16_t ibat_mA, uint32_t now_us, bool at_rest = false);
+  void clear();
+
+  float getChargeIn_mAh();
+  float getChargeOut_mAh();
+  float getNet_mAh();
+  int32_t getNet_uAh();
+  int16_t getCurrent_mA();
+
+  int16_t getOffset_mA();
+  void setOffset_mA(int16_t offset);
+
+ private:
+  Adafruit_BQ25798* charger; ///< Charger read by update(), may be NULL
+  int64_t in_half_mAus;      ///< Charge in, units of 0.5 mA x us
+  int64_t out_half_mAus;     ///< Charge out, units of 0.5 mA x us
+  int32_t offset_x256;       ///< IBAT offset in 1/256 mA
+  uint16_t rest_samples;     ///< Rest samples averaged into the offset
+  int16_t current_mA;        ///< Last offset-corrected current
+  uint32_t sampled_at;       ///< micros() of the last sample
+  bool sampled;              ///< At least one sample taken
+};
+
+#endif // __ADAFRUIT_BQ25798_COULOMBCOUNTER_H__
@@ -0,0 +1,425 @@
+/*!
+ * @file Adafruit_BQ25798_Group.cpp
+ *
+ * Manager for several BQ25798 chargers, directly on one or more buses or
+ * behind TCA9548A I2C switches.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Group.h"
+
+#define MUX_NONE -1    ///< mux_t::channel with every channel off
+#define MUX_UNKNOWN -2 ///< mux_t::channel before the first write
+
+/*!
+ * @brief  Instantiates an empty group
+ */
+Adafruit_BQ25798_Group::Adafruit_BQ25798_Group() {
+  for (uint8_t i = 0; i < BQ25798_GROUP_MAX; i++) {
+    members[i] = NULL;
+  }
+  num_members = 0;
+  num_muxes = 0;
+  cursor = 0;
+  read_adc = true;
+  reset_registers = true;
+  mux_switches = 0;
+}
+
+/*!
+ * @brief  Destroys the group and its charger instances
+ */
+Adafruit_BQ25798_Group::~Adafruit_BQ25798_Group() {
+  for (uint8_t i = 0; i < num_members; i++) {
+    delete members[i];
+  }
+}
+
+/*!
+ * @brief  Adds a charger to the group. Nothing is sent on the bus until
+ *         begin() or the first poll.
+ * @param  i2c_addr
+ *         The charger's I2C address.
+ * @param  wire
+ *         The bus the charger, or its mux, is on.
+ * @param  mux_channel
+ *         TCA9548A channel 0-7, or BQ25798_NO_MUX.
+ * @param  mux_addr
+ *         The TCA9548A's I2C address.
+ * @return Index of the charger, or -1 if the group is full or the channel
+ *         is invalid
+ */
+int8_t Adafruit_BQ25798_Group::add(uint8_t i2c_addr, TwoWire* wire,
+                                   int8_t mux_channel, uint8_t mux_addr) {
+  if (num_members >= BQ25798_GROUP_MAX || mux_channel > 7 ||
+      mux_channel < BQ25798_NO_MUX) {
+    return -1;
+  }
+
+  uint8_t mux = 0xFF;
+  if (mux_channel != BQ25798_NO_MUX) {
+    for (mux = 0; mux < num_muxes; mux++) {
+      if (muxes[mux].wire == wire && muxes[mux].addr == mux_addr) {
+        break;
+      }
+    }
+    if (mux == num_muxes) {
+      muxes[mux].wire = wire;
+      muxes[mux].addr = mux_addr;
+      muxes[mux].channel = MUX_UNKNOWN;
+      num_muxes++;
+    }
+  }
+
+  member_t* m = new member_t;
+  m->wire = wire;
+  m->addr = i2c_addr;
+  m->mux = mux;
+  m->channel = mux_channel;
+  m->begun = false;
+  m->online = false;
+  m->polled_at = 0;
+  memset(&m->status, 0, sizeof(m->status));
+  memset(&m->adc, 0, sizeof(m->adc));
+
+  uint8_t index = num_members++;
+  members[index] = m;
+
+  // Keep the poll order sorted by route so each channel is visited once
+  uint8_t pos = index;
+  while (pos > 0 && routeBefore(index, order[pos - 1])) {
+    order[pos] = order[pos - 1];
+    pos--;
+  }
+  order[pos] = index;
+  cursor = 0;
+
+  return index;
+}
+
+/*!
+ * @brief Get the number of chargers in the group
+ * @return Chargers added
+ */
+uint8_t Adafruit_BQ25798_Group::count() {
+  return num_members;
+}
+
+/*!
+ * @brief  Disconnects every mux channel, then runs begin() on each charger
+ *         in poll order
+ * @param  reset_registers
+ *         True to reset each charger to its defaults, false for a warm
+ *         start that keeps their settings. Chargers started later by poll()
+ *         use the same mode.
+ * @return True if every charger was found and initialized
+ */
+bool Adafruit_BQ25798_Group::begin(bool reset_registers) {
+  bool ok = true;
+
+  this->reset_registers = reset_registers;
+
+  for (uint8_t i = 0; i < num_muxes; i++) {
+    muxes[i].channel = MUX_UNKNOWN;
+    ok = setMux(i, MUX_NONE) && ok;
+  }
+
+  for (uint8_t i = 0; i < num_members; i++) {
+    member_t* m = members[order[i]];
+    m->online = select(order[i]) &&
+                m->charger.begin(m->addr, m->wire, reset_registers);
+    m->begun = m->online;
+    ok = ok && m->online;
+  }
+
+  cursor = 0;
+  return ok;
+}
+
+/*!
+ * @brief Route the bus to one charger, for calling its methods directly
+ *
+ * Other muxes on the same bus are switched off first so chargers sharing
+ * the address never answer together. The pointer stays valid for the
+ * life of the group, but other calls on the group may re-route the bus.
+ *
+ * @param index Charger index from add()
+ * @return The charger, or NULL on a bad index or if a mux did not answer
+ */
+Adafruit_BQ25798* Adafruit_BQ25798_Group::select(uint8_t index) {
+  if (index >= num_members) {
+    return NULL;
+  }
+
+  member_t* m = members[index];
+  for (uint8_t i = 0; i < num_muxes; i++) {
+    if (muxes[i].wire == m->wire && i != m->mux && !setMux(i, MUX_NONE)) {
+      return NULL;
+    }
+  }
+  if (m->mux != 0xFF && !setMux(m->mux, m->channel)) {
+    return NULL;
+  }
+
+  return &m->charger;
+}
+
+/*!
+ * @brief Poll every charger once, in route order
+ * @return True if every charger answered
+ */
+bool Adafruit_BQ25798_Group::update() {
+  bool ok = true;
+
+  for (uint8_t i = 0; i < num_members; i++) {
+    ok = pollMember(order[i]) && ok;
+  }
+
+  cursor = 0;
+  return ok;
+}
+
+/*!
+ * @brief Poll the next batch of chargers sharing one bus, mux and channel
+ *
+ * Chargers that have not been initialized yet get begin() instead, so a
+ * pack plugged in later is picked up on its next turn.
+ *
+ * @return Number of chargers polled, 0 if the group is empty
+ */
+uint8_t Adafruit_BQ25798_Group::poll() {
+  if (num_members == 0) {
+    return 0;
+  }
+
+  uint8_t first = order[cursor];
+  uint8_t polled = 0;
+  do {
+    pollMember(order[cursor]);
+    polled++;
+    cursor = (cursor + 1) % num_members;
+  } while (cursor != 0 && sameRoute(order[cursor], first));
+
+  return polled;
+}
+
+/*!
+ * @brief Choose whether polls also fetch the ADC block
+ * @param enable True to read status and ADC, false for status only
+ */
+void Adafruit_BQ25798_Group::setReadADC(bool enable) {
+  read_adc = enable;
+}
+
+/*!
+ * @brief Check whether a charger answered its last poll
+ * @param index Charger index from add()
+ * @return True if online
+ */
+bool Adafruit_BQ25798_Group::isOnline(uint8_t index) {
+  return index < num_members && members[index]->online;
+}
+
+/*!
+ * @brief Get the status from a charger's last poll
+ * @param index Charger index from add()
+ * @param status Destination for the status
+ * @return True if the charger is online, so the status is current
+ */
+bool Adafruit_BQ25798_Group::getStatus(uint8_t index,
+                                       bq25798_status_t& status) {
+  if (index >= num_members) {
+    return false;
+  }
+
+  status = members[index]->status;
+  return members[index]->online;
+}
+
+/*!
+ * @brief Get the ADC readings from a charger's last poll
+ * @param index Charger index from add()
+ * @param snapshot Destination for the readings
+ * @return True if the charger is online, so the readings are current
+ */
+bool Adafruit_BQ25798_Group::getADC(uint8_t index,
+                                    bq25798_adc_snapshot_t& snapshot) {
+  if (index >= num_members) {
+    return false;
+  }
+
+  snapshot = members[index]->adc;
+  return members[index]->online;
+}
+
+/*!
+ * @brief Get when a charger was last polled
+ * @param index Charger index from add()
+ * @return millis() at the last poll, or 0 if never polled
+ */
+uint32_t Adafruit_BQ25798_Group::getPollTime(uint8_t index) {
+  return index < num_members ? members[index]->polled_at : 0;
+}
+
+/*!
+ * @brief Combine the last readings of every charger
+ *
+ * Currents and battery voltages only include online chargers, and only
+ * mean anything if the ADC is enabled on them and setReadADC() is on.
+ *
+ * @param summary Destination for the totals
+ * @return True if at least one charger is online
+ */
+bool Adafruit_BQ25798_Group::getSummary(bq25798_group_summary_t& summary) {
+  memset(&summary, 0, sizeof(summary));
+
+  for (uint8_t i = 0; i < num_members; i++) {
+    const member_t* m = members[i];
+    if (!m->online) {
+      summary.offline_mask |= 1 << i;
+      continue;
+    }
+
+    summary.online++;
+    if (m->status.chg_stat != BQ25798_CHG_STAT_NOT_CHARGING &&
+        m->status.chg_stat != BQ25798_CHG_STAT_DONE) {
+      summary.charging++;
+    }
+    if (m->status.power_good) {
+      summary.power_good++;
+    }
+    if (hasFault(m->status)) {
+      summary.faulted++;
+      summary.fault_mask |= 1 << i;
+    }
+
+    summary.ibus_mA += m->adc.ibus_mA;
+    summary.ibat_mA += m->adc.ibat_mA;
+    if (summary.online == 1 || m->adc.vbat_mV < summary.vbat_min_mV) {
+      summary.vbat_min_mV = m->adc.vbat_mV;
+    }
+    if (m->adc.vbat_mV > summary.vbat_max_mV) {
+      summary.vbat_max_mV = m->adc.vbat_mV;
+    }
+  }
+
+  return summary.online > 0;
+}
+
+/*!
+ * @brief Get the number of mux control writes issued so far
+ * @return Mux switches
+ */
+uint32_t Adafruit_BQ25798_Group::getMuxSwitches() {
+  return mux_switches;
+}
+
+/*!
+ * @brief Check whether two chargers are reached the same way
+ * @param a Member index
+ * @param b Member index
+ * @return True if they share bus, mux and channel
+ */
+bool Adafruit_BQ25798_Group::sameRoute(uint8_t a, uint8_t b) {
+  return members[a]->wire == members[b]->wire &&
+         members[a]->mux == members[b]->mux &&
+         members[a]->channel == members[b]->channel;
+}
+
+/*!
+ * @brief Poll order: by bus in add() order, direct chargers first, then by
+ * mux and channel
+ * @param a Member index
+ * @param b Member index
+ * @return True if a is polled before b
+ */
+bool Adafruit_BQ25798_Group::routeBefore(uint8_t a, uint8_t b) {
+  const member_t* ma = members[a];
+  const member_t* mb = members[b];
+
+  if (ma->wire != mb->wire) {
+    // Group by bus without depending on pointer order
+    for (uint8_t i = 0; i < num_members; i++) {
+      if (members[i]->wire == ma->wire) {
+        return true;
+      }
+      if (members[i]->wire == mb->wire) {
+        return false;
+      }
+    }
+  }
+  if (ma->mux != mb->mux) {
+    // 0xFF sorts last, but direct chargers should go first
+    return (uint8_t)(ma->mux + 1) < (uint8_t)(mb->mux + 1);
+  }
+  return ma->channel < mb->channel;
+}
+
+/*!
+ * @brief Select a mux channel unless it is known to be selected already
+ * @param mux Index into muxes
+ * @param channel Channel 0-7, or MUX_NONE to disconnect all
+ * @return True if the mux is now on that channel
+ */
+bool Adafruit_BQ25798_Group::setMux(uint8_t mux, int8_t channel) {
+  if (muxes[mux].channel == channel) {
+    return true;
+  }
+
+  Adafruit_I2CDevice dev(muxes[mux].addr, muxes[mux].wire);
+  uint8_t control = channel == MUX_NONE ? 0 : (1 << channel);
+
+  mux_switches++;
+  if (!dev.write(&control, 1)) {
+    muxes[mux].channel = MUX_UNKNOWN;
+    return false;
+  }
+
+  muxes[mux].channel = channel;
+  return true;
+}
+
+/*!
+ * @brief Read one charger, starting it first if it never answered begin()
+ * @param index Member index
+ * @return True if the charger answered
+ */
+bool Adafruit_BQ25798_Group::pollMember(uint8_t index) {
+  member_t* m = members[index];
+
+  m->polled_at = millis();
+  if (!select(index)) {
+    m->online = false;
+    return false;
+  }
+
+  // A charger that was reset once is not reset again after a glitch
+  if (!m->begun) {
+    m->begun = m->charger.begin(m->addr, m->wire, reset_registers);
+    if (!m->begun) {
+      m->online = false;
+      return false;
+    }
+  }
+
+  m->online = m->charger.getStatus(m->status) &&
+              (!read_adc || m->charger.readAllADC(m->adc));
+  return m->online;
+}
+
+/*!
+ * @brief Check a status snapshot for any fault flag
+ * @param status Decoded status
+ * @return True if a fault is reported
+ */
+bool Adafruit_BQ25798_Group::hasFault(const bq25798_status_t& status) {
+  return status.vbus_ovp || status.vbat_ovp || status.ibus_ocp ||
+         status.ibat_ocp || status.conv_ocp || status.vac2_ovp ||
+         status.vac1_ovp || status.vsys_short || status.vsys_ovp ||
+         status.otg_ovp || status.otg_uvp || status.tshut;
+}
@@ -0,0 +1,118 @@
+/*!
+ * @file Adafruit_BQ25798_Group.h
+ *
+ * Manager for several BQ25798 chargers, directly on one or more buses or
+ * behind TCA9548A I2C switches.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_GROUP_H__
+#define __ADAFRUIT_BQ25798_GROUP_H__
+
+#include "Adafruit_BQ25798.h"
+
+#define BQ25798_GROUP_MAX 8           ///< Chargers per group
+#define BQ25798_MUX_DEFAULT_ADDR 0x70 ///< TCA9548A with A2-A0 low
+#define BQ25798_NO_MUX -1             ///< Charger is not behind a mux
+
+/*!
+ * @brief Totals across the chargers of an Adafruit_BQ25798_Group, from the
+ * most recent poll of each
+ */
+typedef struct {
+  uint8_t online;       ///< Chargers that answered their last poll
+  uint8_t charging;     ///< Chargers in any charge phase
+  uint8_t power_good;   ///< Chargers with a good input source
+  uint8_t faulted;      ///< Chargers reporting any fault
+  uint8_t offline_mask; ///< Bit n set if charger n did not answer
+  uint8_t fault_mask;   ///< Bit n set if charger n reports a fault
+  int32_t ibus_mA;      ///< Total input current
+  int32_t ibat_mA;      ///< Total battery current, positive while charging
+  uint16_t vbat_min_mV; ///< Lowest battery voltage, 0 if none online
+  uint16_t vbat_max_mV; ///< Highest battery voltage, 0 if none online
+} bq25798_group_summary_t;
+
+/*!
+ * @brief Owns and polls up to BQ25798_GROUP_MAX chargers
+ *
+ * Every BQ25798 answers at 0x6B, so several on one bus sit behind I2C
+ * switches. The group polls chargers sorted by bus, switch and channel, so
+ * a full update() writes each switch channel once however the chargers
+ * were added, and switch writes that would not change anything are
+ * skipped. poll() does one channel's worth of chargers per call for
+ * spreading the work over a control loop.
+ */
+class Adafruit_BQ25798_Group {
+ public:
+  Adafruit_BQ25798_Group();
+  ~Adafruit_BQ25798_Group();
+
+  int8_t add(uint8_t i2c_addr = BQ25798_DEFAULT_ADDR, TwoWire* wire = &Wire,
+             int8_t mux_channel = BQ25798_NO_MUX,
+             uint8_t mux_addr = BQ25798_MUX_DEFAULT_ADDR);
+  uint8_t count();
+
+  bool begin(bool reset_registers = true);
+  Adafruit_BQ25798* select(uint8_t index);
+
+  bool update();
+  uint8_t poll();
+  void setReadADC(bool enable);
+
+  bool isOnline(uint8_t index);
+  bool getStatus(uint8_t index, bq25798_status_t& status);
+  bool getADC(uint8_t index, bq25798_adc_snapshot_t& snapshot);
+  uint32_t getPollTime(uint8_t index);
+  bool getSummary(bq25798_group_summary_t& summary);
+
+  uint32_t getMuxSwitches();
+
+ private:
+  /*!
+   * @brief One charger and the last readings taken from it
+   */
+  struct member_t {
+    Adafruit_BQ25798 charger;   ///< Driver instance
+    TwoWire* wire;              ///< Bus the charger (or its mux) is on
+    uint8_t addr;               ///< Charger I2C address
+    uint8_t mux;                ///< Index into muxes, or 0xFF
+    int8_t channel;             ///< Mux channel, or BQ25798_NO_MUX
+    bool begun;                 ///< begin() succeeded once
+    bool online;                ///< Last poll succeeded
+    uint32_t polled_at;         ///< millis() of the last poll
+    bq25798_status_t status;    ///< Last status
+    bq25798_adc_snapshot_t adc; ///< Last ADC readings
+  };
+
+  /*!
+   * @brief A TCA9548A and the channel it is known to have selected
+   */
+  struct mux_t {
+    TwoWire* wire;  ///< Bus the mux is on
+    uint8_t addr;   ///< Mux I2C address
+    int8_t channel; ///< Selected channel, -1 for none, -2 if unknown
+  };
+
+  bool sameRoute(uint8_t a, uint8_t b);
+  bool routeBefore(uint8_t a, uint8_t b);
+  bool setMux(uint8_t mux, int8_t channel);
+  bool pollMember(uint8_t index);
+  static bool hasFault(const bq25798_status_t& status);
+
+  member_t* members[BQ25798_GROUP_MAX]; ///< Chargers in add() order
+  uint8_t order[BQ25798_GROUP_MAX];     ///< Member indices in poll order
+  mux_t muxes[BQ25798_GROUP_MAX];       ///< Switches in use
+  uint8_t num_members;                  ///< Chargers added
+  uint8_t num_muxes;                    ///< Switches in use
+  uint8_t cursor;                       ///< Next position in order for poll()
+  bool read_adc;                        ///< Polls include readAllADC()
+  bool reset_registers;                 ///< begin() resets each charger
+  uint32_t mux_switches;                ///< Switch control writes issued
+};
+
+#endif // __ADAFRUIT_BQ25798_GROUP_H__
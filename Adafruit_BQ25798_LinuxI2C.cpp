@@ -0,0 +1,184 @@
+/*!
+ * @file Adafruit_BQ25798_LinuxI2C.cpp
+ *
+ * Linux i2c-dev register transport for the Adafruit BQ25798 battery charger
+ * library. Compiles to nothing on Arduino cores.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_LinuxI2C.h"
+
+#if !defined(ARDUINO) && defined(__linux__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+/*!
+ * @brief  Instantiates a closed i2c-dev transport
+ */
+Adafruit_BQ25798_LinuxI2C::Adafruit_BQ25798_LinuxI2C() {
+  fd = -1;
+  addr = BQ25798_DEFAULT_ADDR;
+  last_errno = 0;
+}
+
+/*!
+ * @brief  Closes the adapter
+ */
+Adafruit_BQ25798_LinuxI2C::~Adafruit_BQ25798_LinuxI2C() {
+  end();
+}
+
+/*!
+ * @brief  Opens an I2C adapter and checks that it supports combined
+ *         transfers
+ * @param  device
+ *         Adapter device node, e.g. "/dev/i2c-1"
+ * @param  i2c_addr
+ *         The 7-bit I2C address of the charger
+ * @return True if the adapter was opened, otherwise false; see getErrno()
+ */
+bool Adafruit_BQ25798_LinuxI2C::begin(const char* device, uint8_t i2c_addr) {
+  end();
+  addr = i2c_addr;
+
+  fd = open(device, O_RDWR | O_CLOEXEC);
+  if (fd < 0) {
+    last_errno = errno;
+    return false;
+  }
+
+  unsigned long funcs = 0;
+  if (ioctl(I2C_FUNCS, &funcs) < 0) {
+    last_errno = errno;
+    end();
+    return false;
+  }
+  if (!(funcs & I2C_FUNC_I2C)) {
+    // SMBus-only adapters cannot do I2C_RDWR
+    last_errno = EOPNOTSUPP;
+    end();
+    return false;
+  }
+
+  last_errno = 0;
+  return true;
+}
+
+/*!
+ * @brief  Closes the adapter if it is open
+ */
+void Adafruit_BQ25798_LinuxI2C::end() {
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+}
+
+/*!
+ * @brief Burst read consecutive registers in one combined transfer
+ * @param reg First register address
+ * @param buffer Destination buffer
+ * @param len Number of bytes to read
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_LinuxI2C::readRegisters(uint8_t reg, uint8_t* buffer,
+                                              uint8_t len) {
+  struct i2c_msg msgs[2];
+
+  msgs[0].addr = addr;
+  msgs[0].flags = 0;
+  msgs[0].len = 1;
+  msgs[0].buf = &reg;
+
+  msgs[1].addr = addr;
+  msgs[1].flags = I2C_M_RD;
+  msgs[1].len = len;
+  msgs[1].buf = buffer;
+
+  return transfer(msgs, 2);
+}
+
+/*!
+ * @brief Burst write consecutive registers in one transfer
+ * @param reg First register address
+ * @param buffer Source buffer
+ * @param len Number of bytes to write
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_LinuxI2C::writeRegisters(uint8_t reg,
+                                               const uint8_t* buffer,
+                                               uint8_t len) {
+  uint8_t frame[1 + 255];
+  struct i2c_msg msg;
+
+  frame[0] = reg;
+  memcpy(frame + 1, buffer, len);
+
+  msg.addr = addr;
+  msg.flags = 0;
+  msg.len = len + 1;
+  msg.buf = frame;
+
+  return transfer(&msg, 1);
+}
+
+/*!
+ * @brief Get the error behind the last failure
+ * @return errno of the last failed open or transfer, or 0 after a success
+ */
+int Adafruit_BQ25798_LinuxI2C::getErrno() {
+  return last_errno;
+}
+
+/*!
+ * @brief Issue an ioctl on the adapter. Tests override this to stand in
+ * for the kernel driver.
+ * @param request ioctl request code
+ * @param arg Request argument
+ * @return The ioctl result, or -1 with errno set
+ */
+int Adafruit_BQ25798_LinuxI2C::ioctl(unsigned long request, void* arg) {
+  return ::ioctl(fd, request, arg);
+}
+
+/*!
+ * @brief Run one I2C_RDWR transfer, retrying if a signal interrupts it
+ * @param msgs Messages, joined by repeated STARTs
+ * @param count Number of messages
+ * @return True if every message completed
+ */
+bool Adafruit_BQ25798_LinuxI2C::transfer(struct i2c_msg* msgs,
+                                         uint8_t count) {
+  if (fd < 0) {
+    last_errno = EBADF;
+    return false;
+  }
+
+  struct i2c_rdwr_ioctl_data data;
+  data.msgs = msgs;
+  data.nmsgs = count;
+
+  int ret;
+  do {
+    ret = ioctl(I2C_RDWR, &data);
+  } while (ret < 0 && errno == EINTR);
+
+  if (ret != count) {
+    last_errno = ret < 0 ? errno : EIO;
+    return false;
+  }
+
+  last_errno = 0;
+  return true;
+}
+
+#endif // !ARDUINO && __linux__
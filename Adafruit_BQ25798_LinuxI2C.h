@@ -0,0 +1,59 @@
+/*!
+ * @file Adafruit_BQ25798_LinuxI2C.h
+ *
+ * Linux i2c-dev register transport for the Adafruit BQ25798 battery charger
+ * library, for running the driver on single-board computers.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_LINUXI2C_H__
+#define __ADAFRUIT_BQ25798_LINUXI2C_H__
+
+#include "Adafruit_BQ25798.h"
+
+#if !defined(ARDUINO) && defined(__linux__)
+
+#include <linux/i2c.h>
+
+#define BQ25798_LINUX_DEFAULT_DEVICE "/dev/i2c-1" ///< Raspberry Pi header bus
+
+/*!
+ * @brief Adafruit_BQ25798_Bus over a Linux /dev/i2c-N adapter
+ *
+ * Every register access is one I2C_RDWR ioctl. A read is a combined
+ * write-address / repeated-start / read transfer of any length, so bursts
+ * such as readAllADC() are not split into Wire-buffer sized chunks.
+ */
+class Adafruit_BQ25798_LinuxI2C : public Adafruit_BQ25798_Bus {
+ public:
+  Adafruit_BQ25798_LinuxI2C();
+  virtual ~Adafruit_BQ25798_LinuxI2C();
+
+  bool begin(const char* device = BQ25798_LINUX_DEFAULT_DEVICE,
+             uint8_t i2c_addr = BQ25798_DEFAULT_ADDR);
+  void end();
+
+  bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t len);
+  bool writeRegisters(uint8_t reg, const uint8_t* buffer, uint8_t len);
+
+  int getErrno();
+
+ protected:
+  virtual int ioctl(unsigned long request, void* arg);
+
+ private:
+  bool transfer(struct i2c_msg* msgs, uint8_t count);
+
+  int fd;         ///< Adapter file descriptor, or -1 when closed
+  uint8_t addr;   ///< 7-bit charger address
+  int last_errno; ///< errno of the last failed call, or 0
+};
+
+#endif // !ARDUINO && __linux__
+
+#endif // __ADAFRUIT_BQ25798_LINUXI2C_H__
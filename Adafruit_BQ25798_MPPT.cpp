@@ -0,0 +1,199 @@
+/*!
+ * @file Adafruit_BQ25798_MPPT.cpp
+ *
+ * Firmware perturb-and-observe maximum power point tracker for the
+ * Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_MPPT.h"
+
+/*!
+ * @brief  Instantiates a tracker for a charger
+ * @param  charger
+ *         Charger to drive. Its begin() must have succeeded before this
+ *         tracker's begin().
+ */
+Adafruit_BQ25798_MPPT::Adafruit_BQ25798_MPPT(Adafruit_BQ25798* charger)
+    : charger(charger) {
+  step_mV = BQ25798_MPPT_DEFAULT_STEP_MV;
+  interval_ms = BQ25798_MPPT_DEFAULT_INTERVAL_MS;
+  min_mV = BQ25798_MPPT_DEFAULT_MIN_MV;
+  max_mV = BQ25798_MPPT_DEFAULT_MAX_MV;
+  vindpm_mV = 0;
+  direction = 1;
+  power_mW = 0;
+  stepped_at = 0;
+  started = false;
+}
+
+/*!
+ * @brief Take over VINDPM from the charger's own MPPT
+ *
+ * Turns the built-in MPPT off, so it no longer rewrites VINDPM, makes sure
+ * the ADC is converting, and starts tracking from the current VINDPM.
+ *
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_MPPT::begin() {
+  started = false;
+
+  if (!charger->setMPPTenable(false) || !charger->setADCEnable(true)) {
+    return false;
+  }
+
+  vindpm_mV = charger->getInputLimit_mV();
+  if (vindpm_mV < min_mV || vindpm_mV > max_mV) {
+    vindpm_mV = vindpm_mV < min_mV ? min_mV : max_mV;
+    if (!charger->setInputLimit_mV(vindpm_mV)) {
+      return false;
+    }
+  }
+
+  direction = 1;
+  power_mW = 0;
+  stepped_at = millis();
+  started = true;
+  return true;
+}
+
+/*!
+ * @brief Take one tracking step if the interval has passed; call from the
+ * main loop
+ *
+ * Reads input power, reverses direction if it fell since the last step,
+ * then moves VINDPM by one step, turning round at the ends of the range.
+ * With no input current the limit is left alone.
+ *
+ * @return True if successful or not yet due, false on a bus error or
+ * before begin()
+ */
+bool Adafruit_BQ25798_MPPT::update() {
+  if (!started) {
+    return false;
+  }
+  if (millis() - stepped_at < interval_ms) {
+    return true;
+  }
+  stepped_at = millis();
+
+  uint16_t vbus_mV;
+  int16_t ibus_mA;
+  if (!charger->readInputADC(vbus_mV, ibus_mA)) {
+    return false;
+  }
+
+  if (ibus_mA <= 0) {
+    // Dark panel or no source: nothing to track
+    power_mW = 0;
+    return true;
+  }
+
+  int32_t power = (int32_t)vbus_mV * ibus_mA / 1000;
+  if (power < power_mW) {
+    direction = -direction;
+  }
+  power_mW = power;
+
+  int32_t next = (int32_t)vindpm_mV + direction * (int32_t)step_mV;
+  if (next > max_mV) {
+    next = max_mV;
+    direction = -1;
+  } else if (next < min_mV) {
+    next = min_mV;
+    direction = 1;
+  }
+
+  if (next == vindpm_mV) {
+    return true;
+  }
+  if (!charger->setInputLimit_mV(next)) {
+    return false;
+  }
+  vindpm_mV = next;
+  return true;
+}
+
+/*!
+ * @brief Set how far VINDPM moves per step
+ * @param step Step in mV, rounded down to the 100 mV VINDPM resolution
+ * (at least 100 mV)
+ */
+void Adafruit_BQ25798_MPPT::setStep_mV(uint16_t step) {
+  step_mV = step < 100 ? 100 : step - step % 100;
+}
+
+/*!
+ * @brief Get how far VINDPM moves per step
+ * @return Step in mV
+ */
+uint16_t Adafruit_BQ25798_MPPT::getStep_mV() {
+  return step_mV;
+}
+
+/*!
+ * @brief Set the time between tracking steps
+ * @param interval_ms Interval in milliseconds. Leave the ADC enough time
+ * for a fresh conversion (see Adafruit_BQ25798::getADCCycleTime()).
+ */
+void Adafruit_BQ25798_MPPT::setInterval(uint32_t interval_ms) {
+  this->interval_ms = interval_ms;
+}
+
+/*!
+ * @brief Get the time between tracking steps
+ * @return Interval in milliseconds
+ */
+uint32_t Adafruit_BQ25798_MPPT::getInterval() {
+  return interval_ms;
+}
+
+/*!
+ * @brief Limit the input voltages the tracker tries, for example to stay
+ * above a panel's knee or below its open-circuit voltage
+ *
+ * The bounds are narrowed to the 100 mV VINDPM resolution: min_mV is
+ * rounded up and max_mV down, so every limit tried is one the chip holds.
+ *
+ * @param min_mV Lowest VINDPM in mV (3600 mV or more)
+ * @param max_mV Highest VINDPM in mV (22000 mV or less)
+ * @return True if successful, false if the range is invalid or holds no
+ * 100 mV step
+ */
+bool Adafruit_BQ25798_MPPT::setRange_mV(uint16_t min_mV, uint16_t max_mV) {
+  if (min_mV < BQ25798_MPPT_DEFAULT_MIN_MV ||
+      max_mV > BQ25798_MPPT_DEFAULT_MAX_MV) {
+    return false;
+  }
+
+  min_mV = (min_mV + 99) / 100 * 100;
+  max_mV = max_mV / 100 * 100;
+  if (min_mV > max_mV) {
+    return false;
+  }
+
+  this->min_mV = min_mV;
+  this->max_mV = max_mV;
+  return true;
+}
+
+/*!
+ * @brief Get the input voltage limit the tracker last programmed
+ * @return VINDPM in mV, 0 before begin()
+ */
+uint16_t Adafruit_BQ25798_MPPT::getInputLimit_mV() {
+  return vindpm_mV;
+}
+
+/*!
+ * @brief Get the input power measured at the last step
+ * @return Input power in mW
+ */
+int32_t Adafruit_BQ25798_MPPT::getPower_mW() {
+  return power_mW;
+}
@@ -0,0 +1,64 @@
+/*!
+ * @file Adafruit_BQ25798_MPPT.h
+ *
+ * Firmware perturb-and-observe maximum power point tracker for the
+ * Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_MPPT_H__
+#define __ADAFRUIT_BQ25798_MPPT_H__
+
+#include "Adafruit_BQ25798.h"
+
+#define BQ25798_MPPT_DEFAULT_STEP_MV 200      ///< VINDPM change per step
+#define BQ25798_MPPT_DEFAULT_INTERVAL_MS 1000 ///< Time between steps
+#define BQ25798_MPPT_DEFAULT_MIN_MV 3600      ///< Lowest VINDPM tried
+#define BQ25798_MPPT_DEFAULT_MAX_MV 22000     ///< Highest VINDPM tried
+
+/*!
+ * @brief Tracks a solar panel's maximum power point by stepping VINDPM
+ *
+ * The charger's own MPPT measures the open-circuit voltage every 30 s to
+ * 30 min and pauses charging to do it. This tracker instead reads IBUS and
+ * VBUS in one 6-byte burst per step, and moves the input voltage limit one
+ * step further in the same direction while input power rises, or turns
+ * round when it falls. At the default 1 s interval that follows passing
+ * clouds without interrupting charging. Each step costs one read and at
+ * most one write.
+ */
+class Adafruit_BQ25798_MPPT {
+ public:
+  Adafruit_BQ25798_MPPT(Adafruit_BQ25798* charger);
+
+  bool begin();
+  bool update();
+
+  void setStep_mV(uint16_t step);
+  uint16_t getStep_mV();
+  void setInterval(uint32_t interval_ms);
+  uint32_t getInterval();
+  bool setRange_mV(uint16_t min_mV, uint16_t max_mV);
+
+  uint16_t getInputLimit_mV();
+  int32_t getPower_mW();
+
+ private:
+  Adafruit_BQ25798* charger; ///< Charger being driven
+  uint16_t step_mV;          ///< VINDPM change per step
+  uint32_t interval_ms;      ///< Time between steps
+  uint16_t min_mV;           ///< Lowest VINDPM tried
+  uint16_t max_mV;           ///< Highest VINDPM tried
+  uint16_t vindpm_mV;        ///< VINDPM currently programmed
+  int8_t direction;          ///< +1 raising VINDPM, -1 lowering it
+  int32_t power_mW;          ///< Input power at the last step
+  uint32_t stepped_at;       ///< millis() of the last step
+  bool started;              ///< begin() succeeded
+};
+
+#endif // __ADAFRUIT_BQ25798_MPPT_H__
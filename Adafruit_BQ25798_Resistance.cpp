@@ -0,0 +1,183 @@
+/*!
+ * @file Adafruit_BQ25798_Resistance.cpp
+ *
+ * Battery internal resistance estimator working from current steps in the
+ * BQ25798 ADC readings, for the Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Resistance.h"
+
+/*!
+ * @brief  Instantiates an estimator
+ * @param  charger
+ *         Charger read by update(). Leave NULL to feed samples taken
+ *         elsewhere through addSample(), after setCellCount().
+ */
+Adafruit_BQ25798_Resistance::Adafruit_BQ25798_Resistance(
+    Adafruit_BQ25798* charger)
+    : charger(charger) {
+  cell_count = BQ25798_CELL_COUNT_1S;
+  min_step_mA = BQ25798_IR_DEFAULT_MIN_STEP_MA;
+  clear();
+}
+
+/*!
+ * @brief Read the cell count setting from the charger
+ * @return True if successful, false without a charger
+ */
+bool Adafruit_BQ25798_Resistance::begin() {
+  if (charger == NULL) {
+    return false;
+  }
+
+  setCellCount(charger->getCellCount());
+  return true;
+}
+
+/*!
+ * @brief Read one VBAT and IBAT sample and look for a step; call from the
+ * main loop, at least as often as BQ25798_IR_MAX_GAP_US
+ *
+ * Costs one short ADC burst.
+ *
+ * @return True if successful, false on a bus error or without a charger
+ */
+bool Adafruit_BQ25798_Resistance::update() {
+  if (charger == NULL) {
+    return false;
+  }
+
+  uint16_t vbat_mV;
+  int16_t ibat_mA;
+  if (!charger->readBatteryADC(vbat_mV, ibat_mA)) {
+    return false;
+  }
+
+  addSample(vbat_mV, ibat_mA, micros());
+  return true;
+}
+
+/*!
+ * @brief Compare a sample taken elsewhere with the previous one, and
+ * average in the resistance if the current stepped
+ * @param vbat_mV Battery voltage in mV
+ * @param ibat_mA Battery current in mA, positive while charging
+ * @param now_us micros() when the sample was taken
+ */
+void Adafruit_BQ25798_Resistance::addSample(uint16_t vbat_mV, int16_t ibat_mA,
+                                            uint32_t now_us) {
+  if (sampled && (uint32_t)(now_us - sampled_at) <= BQ25798_IR_MAX_GAP_US) {
+    int32_t di = (int32_t)ibat_mA - this->ibat_mA;
+    int32_t dv = (int32_t)vbat_mV - this->vbat_mV;
+    if (di < 0) {
+      di = -di;
+      dv = -dv;
+    }
+
+    // More current into the battery must raise VBAT
+    if (di >= min_step_mA && dv > 0 && dv * 1000 / di <= BQ25798_IR_MAX_MOHM) {
+      int32_t cell = dv * 16000 / di / (cell_count + 1);
+
+      // Running mean of the first 16 steps, then a moving average
+      if (steps[cell_count] < 0xFFFF) {
+        steps[cell_count]++;
+      }
+      int32_t window = steps[cell_count] < 16 ? steps[cell_count] : 16;
+      cell_x16[cell_count] += (cell - cell_x16[cell_count]) / window;
+    }
+  }
+
+  this->vbat_mV = vbat_mV;
+  this->ibat_mA = ibat_mA;
+  sampled_at = now_us;
+  sampled = true;
+}
+
+/*!
+ * @brief Forget every estimate and the previous sample
+ */
+void Adafruit_BQ25798_Resistance::clear() {
+  for (uint8_t i = 0; i < 4; i++) {
+    cell_x16[i] = 0;
+    steps[i] = 0;
+  }
+  vbat_mV = 0;
+  ibat_mA = 0;
+  sampled_at = 0;
+  sampled = false;
+}
+
+/*!
+ * @brief Set the cell count that new steps are averaged under, e.g. after
+ * changing Adafruit_BQ25798::setCellCount()
+ * @param cell_count Cells in series
+ */
+void Adafruit_BQ25798_Resistance::setCellCount(
+    bq25798_cell_count_t cell_count) {
+  this->cell_count = (uint8_t)cell_count & 0x03;
+  sampled = false;
+}
+
+/*!
+ * @brief Set the smallest IBAT change treated as a step. Larger steps give
+ * better resolution from the 1 mV ADC.
+ * @param step Step size in mA
+ */
+void Adafruit_BQ25798_Resistance::setMinStep_mA(uint16_t step) {
+  min_step_mA = step == 0 ? 1 : step;
+}
+
+/*!
+ * @brief Get the smallest IBAT change treated as a step
+ * @return Step size in mA
+ */
+uint16_t Adafruit_BQ25798_Resistance::getMinStep_mA() {
+  return min_step_mA;
+}
+
+/*!
+ * @brief Get the pack resistance at the current cell count setting
+ * @return Resistance in milliohms, 0 before the first step
+ */
+uint16_t Adafruit_BQ25798_Resistance::getResistance_mOhm() {
+  return (cell_x16[cell_count] * (cell_count + 1) + 8) / 16;
+}
+
+/*!
+ * @brief Get the average resistance of one cell, as measured while the
+ * charger was set for a cell count
+ * @param cell_count Cell count setting
+ * @return Resistance per cell in milliohms, 0 if no steps were seen
+ */
+uint16_t Adafruit_BQ25798_Resistance::getCellResistance_mOhm(
+    bq25798_cell_count_t cell_count) {
+  return (cell_x16[(uint8_t)cell_count & 0x03] + 8) / 16;
+}
+
+/*!
+ * @brief Get how many steps went into the average for a cell count
+ * @param cell_count Cell count setting
+ * @return Steps used, saturating at 65535
+ */
+uint16_t Adafruit_BQ25798_Resistance::getStepCount(
+    bq25798_cell_count_t cell_count) {
+  return steps[(uint8_t)cell_count & 0x03];
+}
+
+/*!
+ * @brief Remove the IR drop from a VBAT reading
+ * @param vbat_mV Battery voltage in mV
+ * @param ibat_mA Battery current in mA, positive while charging
+ * @return Estimated open-circuit voltage of the pack in mV
+ */
+uint16_t Adafruit_BQ25798_Resistance::compensate_mV(uint16_t vbat_mV,
+                                                    int16_t ibat_mA) {
+  int32_t ocv = vbat_mV - (int32_t)ibat_mA * getResistance_mOhm() / 1000;
+  return ocv < 0 ? 0 : (ocv > 0xFFFF ? 0xFFFF : ocv);
+}
@@ -0,0 +1,69 @@
+/*!
+ * @file Adafruit_BQ25798_Resistance.h
+ *
+ * Battery internal resistance estimator working from current steps in the
+ * BQ25798 ADC readings, for the Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_RESISTANCE_H__
+#define __ADAFRUIT_BQ25798_RESISTANCE_H__
+
+#include "Adafruit_BQ25798.h"
+
+#define BQ25798_IR_DEFAULT_MIN_STEP_MA 200 ///< Smallest IBAT step used
+#define BQ25798_IR_MAX_GAP_US 2000000UL    ///< Longest time across a step
+#define BQ25798_IR_MAX_MOHM 2000           ///< Largest plausible pack DCIR
+
+/*!
+ * @brief Estimates the battery's DC internal resistance from the ADC
+ *
+ * Whenever the charge current changes, for example after
+ * setChargeLimit_mA() or when a load switches, VBAT and IBAT move
+ * together, and the ratio of the two steps is the pack's DC resistance.
+ * The estimator compares each sample with the previous one and uses
+ * steps of at least the minimum step size taken close enough together
+ * that the cells' state of charge has not moved VBAT. Steps giving a
+ * negative or implausible resistance are dropped.
+ *
+ * Results are kept per cell, as a running average for each cell count
+ * setting, so a growing figure tracks pack ageing. getResistance_mOhm()
+ * can be fed to Adafruit_BQ25798_SOC::setResistance_mOhm() to correct
+ * VBAT for IR drop.
+ */
+class Adafruit_BQ25798_Resistance {
+ public:
+  Adafruit_BQ25798_Resistance(Adafruit_BQ25798* charger = NULL);
+
+  bool begin();
+  bool update();
+  void addSample(uint16_t vbat_mV, int16_t ibat_mA, uint32_t now_us);
+  void clear();
+
+  void setCellCount(bq25798_cell_count_t cell_count);
+  void setMinStep_mA(uint16_t step);
+  uint16_t getMinStep_mA();
+
+  uint16_t getResistance_mOhm();
+  uint16_t getCellResistance_mOhm(bq25798_cell_count_t cell_count);
+  uint16_t getStepCount(bq25798_cell_count_t cell_count);
+  uint16_t compensate_mV(uint16_t vbat_mV, int16_t ibat_mA);
+
+ private:
+  Adafruit_BQ25798* charger; ///< Charger read by update(), may be NULL
+  uint8_t cell_count;        ///< Current cell count setting
+  uint16_t min_step_mA;      ///< Smallest IBAT step used
+  int32_t cell_x16[4];       ///< Per-cell average, 1/16 mOhm, by setting
+  uint16_t steps[4];         ///< Steps averaged, by setting
+  uint16_t vbat_mV;          ///< VBAT at the last sample
+  int16_t ibat_mA;           ///< IBAT at the last sample
+  uint32_t sampled_at;       ///< micros() of the last sample
+  bool sampled;              ///< At least one sample taken
+};
+
+#endif // __ADAFRUIT_BQ25798_RESISTANCE_H__
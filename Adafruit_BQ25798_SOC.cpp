@@ -0,0 +1,277 @@
+/*!
+ * @file Adafruit_BQ25798_SOC.cpp
+ *
+ * State-of-charge estimator combining open-circuit voltage tables with
+ * coulomb counting, for the Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_SOC.h"
+
+/*!
+ * @brief Points per OCV table, one every 10 % from 0 % to 100 %
+ */
+#define OCV_POINTS 11
+
+/*!
+ * @brief Settled open-circuit voltage per cell in mV at 0 %, 10 %, ...
+ * 100 % state of charge, indexed by bq25798_chemistry_t
+ */
+static const uint16_t ocv_tables[][OCV_POINTS] PROGMEM = {
+    {3300, 3600, 3690, 3740, 3770, 3800, 3860, 3930, 4010, 4090, 4190},
+    {3300, 3620, 3710, 3760, 3800, 3840, 3900, 3980, 4070, 4170, 4320},
+    {2500, 3000, 3200, 3220, 3250, 3260, 3270, 3300, 3320, 3350, 3400},
+};
+
+/*!
+ * @brief  Instantiates an estimator for a charger
+ * @param  charger
+ *         Charger to read. Its begin() must have succeeded before this
+ *         estimator's begin().
+ * @param  chemistry
+ *         Cell chemistry, selecting the open-circuit voltage table
+ */
+Adafruit_BQ25798_SOC::Adafruit_BQ25798_SOC(Adafruit_BQ25798* charger,
+                                           bq25798_chemistry_t chemistry)
+    : charger(charger), chemistry(chemistry) {
+  cells = 1;
+  capacity_mAh = 0;
+  rest_ms = BQ25798_SOC_DEFAULT_REST_MS;
+  resistance_mOhm = 0;
+  rested_us = 0;
+  sampled_at = 0;
+  anchor_x100 = 0;
+  soc_x100 = 0;
+  anchored = false;
+}
+
+/*!
+ * @brief Read the cell count and take the first estimate from VBAT
+ *
+ * The ADC must already be converting (see
+ * Adafruit_BQ25798::setADCEnable()). The first estimate comes straight
+ * from the OCV table, so it is best taken with the battery lightly loaded.
+ *
+ * @param capacity_mAh Full charge capacity of the pack
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_SOC::begin(uint16_t capacity_mAh) {
+  if (!setCapacity_mAh(capacity_mAh)) {
+    return false;
+  }
+
+  cells = charger->getCellCount() + 1;
+  anchored = false;
+  rested_us = 0;
+  return update();
+}
+
+/*!
+ * @brief Read and account for one VBAT and IBAT sample; call from the main
+ * loop
+ *
+ * Costs two reads: VBAT and IBAT in a short ADC burst, then the charge
+ * status byte.
+ *
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_SOC::update() {
+  uint16_t vbat_mV;
+  int16_t ibat_mA;
+  if (!charger->readBatteryADC(vbat_mV, ibat_mA)) {
+    return false;
+  }
+  uint32_t now = micros();
+
+  bool terminated = charger->getChargeStatus() == BQ25798_CHG_STAT_DONE;
+  addSample(vbat_mV, ibat_mA, now, terminated);
+  return true;
+}
+
+/*!
+ * @brief Account for one sample taken elsewhere, e.g. by readAllADC()
+ * @param vbat_mV Battery voltage in mV
+ * @param ibat_mA Raw IBAT reading in mA, positive while charging
+ * @param now_us micros() when the sample was taken
+ * @param terminated True if the charger reports charge termination
+ */
+void Adafruit_BQ25798_SOC::addSample(uint16_t vbat_mV, int16_t ibat_mA,
+                                     uint32_t now_us, bool terminated) {
+  counter.addSample(ibat_mA, now_us, terminated);
+  int16_t current = counter.getCurrent_mA();
+
+  if (terminated) {
+    anchor(10000);
+    rested_us = 0;
+  } else if (current >= -BQ25798_SOC_REST_MA &&
+             current <= BQ25798_SOC_REST_MA) {
+    if (anchored) {
+      rested_us += (uint32_t)(now_us - sampled_at);
+    }
+    // A zero reading means the ADC has not converted yet
+    if (vbat_mV != 0 &&
+        (!anchored || rested_us >= (uint64_t)rest_ms * 1000)) {
+      anchor(tableSOC(vbat_mV, current));
+    }
+  } else {
+    rested_us = 0;
+    if (!anchored && vbat_mV != 0) {
+      // Loaded, but better than no estimate at all
+      anchor(tableSOC(vbat_mV, current));
+    }
+  }
+  sampled_at = now_us;
+
+  if (!anchored) {
+    return;
+  }
+  int32_t soc = anchor_x100 +
+                (int32_t)((int64_t)counter.getNet_uAh() * 10 / capacity_mAh);
+  soc_x100 = soc < 0 ? 0 : (soc > 10000 ? 10000 : soc);
+}
+
+/*!
+ * @brief Get the state of charge
+ * @return State of charge in percent, 0 before the first estimate
+ */
+float Adafruit_BQ25798_SOC::getSOC() {
+  return soc_x100 / 100.0f;
+}
+
+/*!
+ * @brief Get the state of charge without floating point
+ * @return State of charge in 0.01 % steps (0-10000), 0 before the first
+ * estimate
+ */
+uint16_t Adafruit_BQ25798_SOC::getSOC_x100() {
+  return soc_x100;
+}
+
+/*!
+ * @brief Set the pack's full charge capacity, e.g. as it fades with age
+ * @param capacity_mAh Capacity in mAh
+ * @return True if successful, false for zero
+ */
+bool Adafruit_BQ25798_SOC::setCapacity_mAh(uint16_t capacity_mAh) {
+  if (capacity_mAh == 0) {
+    return false;
+  }
+
+  this->capacity_mAh = capacity_mAh;
+  if (anchored) {
+    // Keep the current estimate, counting from here at the new capacity
+    anchor(soc_x100);
+  }
+  return true;
+}
+
+/*!
+ * @brief Get the pack's full charge capacity
+ * @return Capacity in mAh
+ */
+uint16_t Adafruit_BQ25798_SOC::getCapacity_mAh() {
+  return capacity_mAh;
+}
+
+/*!
+ * @brief Set how long the battery must rest before its voltage is trusted
+ * @param rest_ms Settling time in milliseconds, below
+ * BQ25798_SOC_REST_MA throughout
+ */
+void Adafruit_BQ25798_SOC::setRestTime(uint32_t rest_ms) {
+  this->rest_ms = rest_ms;
+}
+
+/*!
+ * @brief Get how long the battery must rest before its voltage is trusted
+ * @return Settling time in milliseconds
+ */
+uint32_t Adafruit_BQ25798_SOC::getRestTime() {
+  return rest_ms;
+}
+
+/*!
+ * @brief Set the pack's DC resistance, e.g. from
+ * Adafruit_BQ25798_Resistance::getResistance_mOhm(), to correct VBAT for
+ * IR drop
+ * @param resistance Resistance in milliohms, 0 for no correction
+ */
+void Adafruit_BQ25798_SOC::setResistance_mOhm(uint16_t resistance) {
+  resistance_mOhm = resistance;
+}
+
+/*!
+ * @brief Get the pack's DC resistance used to correct VBAT
+ * @return Resistance in milliohms
+ */
+uint16_t Adafruit_BQ25798_SOC::getResistance_mOhm() {
+  return resistance_mOhm;
+}
+
+/*!
+ * @brief Get the coulomb counter tracking charge since the last anchor,
+ * e.g. to restore a saved IBAT offset
+ * @return Counter owned by this estimator
+ */
+Adafruit_BQ25798_CoulombCounter* Adafruit_BQ25798_SOC::getCounter() {
+  return &counter;
+}
+
+/*!
+ * @brief Look up the state of charge for a settled cell voltage,
+ * interpolating between table points
+ * @param chemistry Cell chemistry
+ * @param cell_mV Open-circuit voltage of one cell in mV
+ * @return State of charge in 0.01 % steps (0-10000)
+ */
+uint16_t Adafruit_BQ25798_SOC::ocvToSOC_x100(bq25798_chemistry_t chemistry,
+                                             uint16_t cell_mV) {
+  if ((uint8_t)chemistry > BQ25798_CHEM_LIFEPO4) {
+    return 0;
+  }
+
+  const uint16_t* table = ocv_tables[chemistry];
+  uint16_t lo = pgm_read_word(&table[0]);
+  if (cell_mV <= lo) {
+    return 0;
+  }
+
+  for (uint8_t i = 1; i < OCV_POINTS; i++) {
+    uint16_t hi = pgm_read_word(&table[i]);
+    if (cell_mV < hi) {
+      return (i - 1) * 1000 + (uint32_t)(cell_mV - lo) * 1000 / (hi - lo);
+    }
+    lo = hi;
+  }
+  return 10000;
+}
+
+/*!
+ * @brief Look up the state of charge for a pack reading, after removing
+ * the IR drop
+ * @param vbat_mV Battery voltage in mV
+ * @param current_mA Battery current in mA, positive while charging
+ * @return State of charge in 0.01 % steps
+ */
+uint16_t Adafruit_BQ25798_SOC::tableSOC(uint16_t vbat_mV, int16_t current_mA) {
+  int32_t ocv = vbat_mV - (int32_t)current_mA * resistance_mOhm / 1000;
+  if (ocv < 0) {
+    ocv = 0;
+  }
+  return ocvToSOC_x100(chemistry, ocv / cells);
+}
+
+/*!
+ * @brief Restart counting from a known state of charge
+ * @param soc_x100 State of charge in 0.01 % steps
+ */
+void Adafruit_BQ25798_SOC::anchor(uint16_t soc_x100) {
+  anchor_x100 = soc_x100;
+  counter.clear();
+  anchored = true;
+}
@@ -0,0 +1,87 @@
+/*!
+ * @file Adafruit_BQ25798_SOC.h
+ *
+ * State-of-charge estimator combining open-circuit voltage tables with
+ * coulomb counting, for the Adafruit BQ25798 battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_SOC_H__
+#define __ADAFRUIT_BQ25798_SOC_H__
+
+#include "Adafruit_BQ25798.h"
+#include "Adafruit_BQ25798_CoulombCounter.h"
+
+#define BQ25798_SOC_REST_MA 20                ///< Largest current at rest
+#define BQ25798_SOC_DEFAULT_REST_MS 1800000UL ///< Settling time before OCV
+
+/*!
+ * @brief Cell chemistry, selecting the open-circuit voltage table
+ */
+typedef enum {
+  BQ25798_CHEM_LIION = 0x00,  ///< Li-ion / LiPo, 4.2 V per cell full
+  BQ25798_CHEM_LIHV = 0x01,   ///< High-voltage LiPo, 4.35 V per cell full
+  BQ25798_CHEM_LIFEPO4 = 0x02 ///< LiFePO4, 3.6 V per cell full
+} bq25798_chemistry_t;
+
+/*!
+ * @brief Estimates state of charge from VBAT and IBAT
+ *
+ * Battery voltage sags under load and rises while charging, so on its own
+ * it makes a jumpy fuel gauge. This estimator takes its starting point from
+ * the open-circuit voltage table of the cell chemistry, then follows
+ * charge in and out with an Adafruit_BQ25798_CoulombCounter. Once the
+ * battery has rested long enough for its voltage to settle, the estimate
+ * is pulled back onto the table, so counting errors cannot build up. A
+ * charger reporting termination sets it to 100 %. With the pack resistance
+ * set, VBAT is corrected for IR drop before every table lookup.
+ */
+class Adafruit_BQ25798_SOC {
+ public:
+  Adafruit_BQ25798_SOC(Adafruit_BQ25798* charger,
+                       bq25798_chemistry_t chemistry = BQ25798_CHEM_LIION);
+
+  bool begin(uint16_t capacity_mAh);
+  bool update();
+  void addSample(uint16_t vbat_mV, int16_t ibat_mA, uint32_t now_us,
+                 bool terminated = false);
+
+  float getSOC();
+  uint16_t getSOC_x100();
+
+  bool setCapacity_mAh(uint16_t capacity_mAh);
+  uint16_t getCapacity_mAh();
+  void setRestTime(uint32_t rest_ms);
+  uint32_t getRestTime();
+  void setResistance_mOhm(uint16_t resistance);
+  uint16_t getResistance_mOhm();
+
+  Adafruit_BQ25798_CoulombCounter* getCounter();
+
+  static uint16_t ocvToSOC_x100(bq25798_chemistry_t chemistry,
+                                uint16_t cell_mV);
+
+ private:
+  void anchor(uint16_t soc_x100);
+  uint16_t tableSOC(uint16_t vbat_mV, int16_t current_mA);
+
+  Adafruit_BQ25798* charger;               ///< Charger read by update()
+  Adafruit_BQ25798_CoulombCounter counter; ///< Charge since the anchor
+  bq25798_chemistry_t chemistry;           ///< Selects the OCV table
+  uint8_t cells;                           ///< Cells in series
+  uint16_t capacity_mAh;                   ///< Full charge capacity
+  uint32_t rest_ms;                        ///< Settling time before OCV
+  uint16_t resistance_mOhm;                ///< Pack DC resistance
+  uint64_t rested_us;                      ///< Time at rest so far
+  uint32_t sampled_at;                     ///< micros() of the last sample
+  uint16_t anchor_x100;                    ///< SOC at the last anchor
+  uint16_t soc_x100;                       ///< SOC in 0.01 % steps
+  bool anchored;                           ///< anchor_x100 is valid
+};
+
+#endif // __ADAFRUIT_BQ25798_SOC_H__
@@ -0,0 +1,220 @@
+/*!
+ * @file Adafruit_BQ25798_Sampler.h
+ *
+ * Periodic ADC sampler and lock-free ring buffer for the Adafruit BQ25798
+ * battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_SAMPLER_H__
+#define __ADAFRUIT_BQ25798_SAMPLER_H__
+
+#include "Adafruit_BQ25798.h"
+
+#if defined(ESP32)
+#define BQ25798_MEMORY_BARRIER() __sync_synchronize() ///< Dual-core fence
+#else
+/*!
+ * @brief Keep the compiler from reordering ring buffer accesses. Single-core
+ * parts only need a compiler barrier between an ISR and the main loop.
+ */
+#define BQ25798_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+#endif
+
+/*!
+ * @brief One timestamped ADC snapshot produced by Adafruit_BQ25798_Sampler
+ */
+typedef struct {
+  uint32_t timestamp;         ///< millis() when the snapshot was taken
+  bq25798_adc_snapshot_t adc; ///< Decoded ADC results
+} bq25798_sample_t;
+
+/*!
+ * @brief Fixed-size single-producer / single-consumer ring buffer
+ *
+ * push() and pop() may run in different contexts (an ISR or timer task and
+ * the main loop) without locks or heap allocation, as long as there is only
+ * one producer and one consumer.
+ *
+ * @tparam T Item type
+ * @tparam SIZE Capacity, a power of two no larger than 128
+ */
+template <typename T, uint8_t SIZE>
+class Adafruit_BQ25798_RingBuffer {
+  static_assert(SIZE > 0 && SIZE <= 128 && (SIZE & (SIZE - 1)) == 0,
+                "SIZE must be a power of two no larger than 128");
+
+ public:
+  /*!
+   * @brief Create an empty ring buffer
+   */
+  Adafruit_BQ25798_RingBuffer() : head(0), tail(0) {}
+
+  /*!
+   * @brief Add an item. Call from the producer only.
+   * @param item Item to copy into the buffer
+   * @return True if added, false if the buffer was full
+   */
+  bool push(const T& item) {
+    uint8_t h = head;
+    if ((uint8_t)(h - tail) >= SIZE) {
+      return false;
+    }
+    items[h & (SIZE - 1)] = item;
+    BQ25798_MEMORY_BARRIER();
+    head = h + 1;
+    return true;
+  }
+
+  /*!
+   * @brief Remove the oldest item. Call from the consumer only.
+   * @param item Destination for the item
+   * @return True if an item was removed, false if the buffer was empty
+   */
+  bool pop(T& item) {
+    uint8_t t = tail;
+    if (t == head) {
+      return false;
+    }
+    item = items[t & (SIZE - 1)];
+    BQ25798_MEMORY_BARRIER();
+    tail = t + 1;
+    return true;
+  }
+
+  /*!
+   * @brief Get the number of items waiting
+   * @return Number of items in the buffer
+   */
+  uint8_t available() const {
+    return (uint8_t)(head - tail);
+  }
+
+  /*!
+   * @brief Get the buffer capacity
+   * @return Maximum number of items
+   */
+  uint8_t capacity() const {
+    return SIZE;
+  }
+
+ private:
+  T items[SIZE];         ///< Item storage
+  volatile uint8_t head; ///< Free-running write index, owned by producer
+  volatile uint8_t tail; ///< Free-running read index, owned by consumer
+};
+
+/*!
+ * @brief Polls the BQ25798 ADC block at a fixed rate into a ring buffer
+ *
+ * poll() is the producer: call it as often as convenient from a timer task
+ * or the main loop and it takes one readAllADC() burst whenever the
+ * interval has elapsed. The consumer drains samples with read(). poll()
+ * uses I2C, so it must not run from a hardware ISR on cores whose Wire
+ * driver is interrupt based (AVR, SAMD).
+ *
+ * @tparam SIZE Number of buffered samples, a power of two
+ */
+template <uint8_t SIZE = 8>
+class Adafruit_BQ25798_Sampler {
+ public:
+  /*!
+   * @brief Create a sampler for a charger
+   * @param charger Initialized charger to sample
+   * @param interval Sampling interval in milliseconds
+   */
+  Adafruit_BQ25798_Sampler(Adafruit_BQ25798* charger, uint32_t interval = 100)
+      : charger(charger),
+        interval(interval),
+        last(0),
+        started(false),
+        overruns(0) {}
+
+  /*!
+   * @brief Set the sampling interval
+   * @param interval Sampling interval in milliseconds
+   */
+  void setInterval(uint32_t interval) {
+    this->interval = interval;
+  }
+
+  /*!
+   * @brief Get the sampling interval
+   * @return Sampling interval in milliseconds
+   */
+  uint32_t getInterval() {
+    return interval;
+  }
+
+  /*!
+   * @brief Take a sample if the interval has elapsed (producer side)
+   * @return True if a sample was pushed into the buffer
+   */
+  bool poll() {
+    uint32_t now = millis();
+    if (started && (now - last) < interval) {
+      return false;
+    }
+    started = true;
+    last = now;
+    return sample();
+  }
+
+  /*!
+   * @brief Take a sample right away (producer side)
+   * @return True if a sample was pushed, false on a bus error or overrun
+   */
+  bool sample() {
+    bq25798_sample_t s;
+    s.timestamp = millis();
+    if (!charger->readAllADC(s.adc)) {
+      return false;
+    }
+    if (!buffer.push(s)) {
+      overruns++;
+      return false;
+    }
+    return true;
+  }
+
+  /*!
+   * @brief Get the number of samples waiting (consumer side)
+   * @return Number of buffered samples
+   */
+  uint8_t available() {
+    return buffer.available();
+  }
+
+  /*!
+   * @brief Take the oldest sample (consumer side)
+   * @param s Destination for the sample
+   * @return True if a sample was available
+   */
+  bool read(bq25798_sample_t& s) {
+    return buffer.pop(s);
+  }
+
+  /*!
+   * @brief Get the number of samples dropped because the buffer was full
+   * @return Dropped sample count
+   */
+  uint32_t getOverruns() {
+    return overruns;
+  }
+
+ private:
+  Adafruit_BQ25798* charger;  ///< Charger being sampled
+  uint32_t interval;          ///< Sampling interval in ms
+  uint32_t last;              ///< millis() of the last sample
+  bool started;               ///< A sample has been taken
+  volatile uint32_t overruns; ///< Samples dropped on a full buffer
+
+  Adafruit_BQ25798_RingBuffer<bq25798_sample_t, SIZE> buffer; ///< Samples
+};
+
+#endif // __ADAFRUIT_BQ25798_SAMPLER_H__
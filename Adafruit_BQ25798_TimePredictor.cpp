@@ -0,0 +1,236 @@
+/*!
+ * @file Adafruit_BQ25798_TimePredictor.cpp
+ *
+ * Time-to-full and time-to-empty predictor for the Adafruit BQ25798
+ * battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_TimePredictor.h"
+
+/*!
+ * @brief ln(2) in 1/4096 steps
+ */
+#define LN2_Q12 2839
+
+/*!
+ * @brief ln(1 + i / 16) in 1/4096 steps for i = 0..16
+ */
+static const uint16_t ln_table[17] PROGMEM = {
+    0,    248,  482,  704,  914,  1114, 1304, 1486, 1661,
+    1828, 1989, 2143, 2292, 2436, 2575, 2709, 2839,
+};
+
+/*!
+ * @brief Natural log of a ratio without floating point
+ * @param num Numerator, at least den
+ * @param den Denominator, not 0
+ * @return ln(num / den) in 1/4096 steps
+ */
+static uint32_t lnRatio_q12(uint32_t num, uint32_t den) {
+  // Scale the ratio to [1, 2) in 1/4096 steps, counting the halvings
+  uint32_t ratio = (uint64_t)num * 4096 / den;
+  uint32_t ln = 0;
+  while (ratio >= 8192) {
+    ratio >>= 1;
+    ln += LN2_Q12;
+  }
+
+  // Interpolate between the 17 table points spanning [1, 2]
+  uint32_t frac = ratio - 4096;
+  uint8_t i = frac >> 8;
+  uint32_t lo = pgm_read_word(&ln_table[i]);
+  uint32_t hi = pgm_read_word(&ln_table[i + 1]);
+  return ln + lo + ((hi - lo) * (frac & 0xFF) >> 8);
+}
+
+/*!
+ * @brief  Instantiates a predictor
+ * @param  charger
+ *         Charger to read. Its begin() must have succeeded before this
+ *         predictor's begin().
+ * @param  soc
+ *         State of charge estimator, already begun. update() feeds it, so
+ *         do not also call its update().
+ */
+Adafruit_BQ25798_TimePredictor::Adafruit_BQ25798_TimePredictor(
+    Adafruit_BQ25798* charger, Adafruit_BQ25798_SOC* soc)
+    : charger(charger), soc(soc) {
+  ichg_mA = 0;
+  iterm_mA = 0;
+  cv_x100 = BQ25798_PREDICT_DEFAULT_CV_X100;
+  current_x16 = 0;
+  status = BQ25798_CHG_STAT_NOT_CHARGING;
+  to_full_min = BQ25798_TIME_UNKNOWN;
+  to_empty_min = BQ25798_TIME_UNKNOWN;
+  sampled = false;
+}
+
+/*!
+ * @brief Read the charge and termination current limits. Call again after
+ * changing either.
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_TimePredictor::begin() {
+  ichg_mA = charger->getChargeLimit_mA();
+  iterm_mA = charger->getTermination_mA();
+  return ichg_mA != 0;
+}
+
+/*!
+ * @brief Read one sample, pass it to the state of charge estimator and
+ * update the predictions; call from the main loop
+ *
+ * Costs two reads: VBAT and IBAT in a short ADC burst, then the charge
+ * status byte.
+ *
+ * @return True if successful
+ */
+bool Adafruit_BQ25798_TimePredictor::update() {
+  uint16_t vbat_mV;
+  int16_t ibat_mA;
+  if (!charger->readBatteryADC(vbat_mV, ibat_mA)) {
+    return false;
+  }
+  uint32_t now = micros();
+
+  addSample(vbat_mV, ibat_mA, now, charger->getChargeStatus());
+  return true;
+}
+
+/*!
+ * @brief Account for one sample taken elsewhere, e.g. by readAllADC() and
+ * getStatus()
+ * @param vbat_mV Battery voltage in mV
+ * @param ibat_mA Raw IBAT reading in mA, positive while charging
+ * @param now_us micros() when the sample was taken
+ * @param status Charge phase (CHG_STAT)
+ */
+void Adafruit_BQ25798_TimePredictor::addSample(uint16_t vbat_mV,
+                                               int16_t ibat_mA,
+                                               uint32_t now_us,
+                                               bq25798_chg_stat_t status) {
+  soc->addSample(vbat_mV, ibat_mA, now_us, status == BQ25798_CHG_STAT_DONE);
+  int32_t current = soc->getCounter()->getCurrent_mA();
+
+  // Moving average over about 8 samples
+  if (sampled) {
+    current_x16 += (current * 16 - current_x16) / 8;
+  } else {
+    current_x16 = current * 16;
+  }
+
+  uint16_t soc_x100 = soc->getSOC_x100();
+  if (sampled && this->status == BQ25798_CHG_STAT_FAST &&
+      status == BQ25798_CHG_STAT_TAPER) {
+    // Whatever is left at the CC to CV handover goes in during the taper
+    cv_x100 = soc_x100 > 9900 ? 100 : 10000 - soc_x100;
+  }
+  this->status = status;
+  sampled = true;
+
+  uint32_t capacity = soc->getCapacity_mAh();
+  uint32_t to_go_mAh = capacity * (10000 - soc_x100) / 10000;
+  uint32_t left_mAh = capacity * soc_x100 / 10000;
+  uint32_t cv_mAh = capacity * cv_x100 / 10000;
+  int16_t average = getAverageCurrent_mA();
+
+  to_full_min = BQ25798_TIME_UNKNOWN;
+  switch (status) {
+    case BQ25798_CHG_STAT_TRICKLE:
+    case BQ25798_CHG_STAT_PRECHARGE:
+      // Fast charge at the limit follows shortly
+      to_full_min = chargeMinutes(to_go_mAh, cv_mAh, ichg_mA);
+      break;
+    case BQ25798_CHG_STAT_FAST:
+      // Input limits can hold the charge current below ICHG
+      to_full_min =
+          chargeMinutes(to_go_mAh, cv_mAh, average > 0 ? average : ichg_mA);
+      break;
+    case BQ25798_CHG_STAT_TAPER:
+      if (average > 0) {
+        to_full_min = chargeMinutes(to_go_mAh, to_go_mAh, average);
+      }
+      break;
+    case BQ25798_CHG_STAT_TOPOFF:
+    case BQ25798_CHG_STAT_DONE:
+      to_full_min = 0;
+      break;
+    default:
+      break;
+  }
+
+  to_empty_min = BQ25798_TIME_UNKNOWN;
+  if (average < -BQ25798_PREDICT_IDLE_MA) {
+    uint32_t minutes = left_mAh * 60 / (uint32_t)(-average);
+    to_empty_min = minutes < BQ25798_TIME_UNKNOWN ? minutes
+                                                   : BQ25798_TIME_UNKNOWN - 1;
+  }
+}
+
+/*!
+ * @brief Get the predicted time until charge termination
+ * @return Minutes, 0 once full or in top-off, BQ25798_TIME_UNKNOWN when
+ * not charging
+ */
+uint16_t Adafruit_BQ25798_TimePredictor::getMinutesToFull() {
+  return to_full_min;
+}
+
+/*!
+ * @brief Get the predicted time until the battery is empty at the average
+ * discharge current
+ * @return Minutes, BQ25798_TIME_UNKNOWN when not discharging
+ */
+uint16_t Adafruit_BQ25798_TimePredictor::getMinutesToEmpty() {
+  return to_empty_min;
+}
+
+/*!
+ * @brief Get the offset-corrected battery current, averaged over recent
+ * samples
+ * @return Current in mA, positive while charging
+ */
+int16_t Adafruit_BQ25798_TimePredictor::getAverageCurrent_mA() {
+  int32_t half = current_x16 < 0 ? -8 : 8;
+  return (int16_t)((current_x16 + half) / 16);
+}
+
+/*!
+ * @brief Work out the time to put charge in, at a constant current then
+ * along an exponential taper to the termination current
+ * @param to_go_mAh Charge still to go in
+ * @param cv_mAh Charge that goes in during the taper
+ * @param cc_mA Current before the taper starts
+ * @return Minutes, BQ25798_TIME_UNKNOWN without a current
+ */
+uint16_t Adafruit_BQ25798_TimePredictor::chargeMinutes(uint32_t to_go_mAh,
+                                                       uint32_t cv_mAh,
+                                                       uint16_t cc_mA) {
+  if (cc_mA == 0) {
+    return BQ25798_TIME_UNKNOWN;
+  }
+  if (cv_mAh > to_go_mAh) {
+    cv_mAh = to_go_mAh;
+  }
+
+  // Minutes in 1/4096 steps, so no float math is linked in
+  uint64_t minutes = (uint64_t)60 * 4096 * (to_go_mAh - cv_mAh) / cc_mA;
+  if (iterm_mA != 0 && cc_mA > iterm_mA) {
+    // I(t) = cc e^(-t/tau) holds tau (cc - iterm) above termination, and
+    // reaches it after tau ln(cc / iterm)
+    minutes += (uint64_t)60 * cv_mAh * lnRatio_q12(cc_mA, iterm_mA) /
+               (cc_mA - iterm_mA);
+  } else {
+    minutes += (uint64_t)60 * 4096 * cv_mAh / cc_mA;
+  }
+
+  minutes = (minutes + 2048) / 4096;
+  return minutes < BQ25798_TIME_UNKNOWN ? (uint16_t)minutes
+                                        : BQ25798_TIME_UNKNOWN - 1;
+}
@@ -0,0 +1,66 @@
+/*!
+ * @file Adafruit_BQ25798_TimePredictor.h
+ *
+ * Time-to-full and time-to-empty predictor for the Adafruit BQ25798
+ * battery charger library.
+ *
+ * Adafruit invests time and resources providing this open source code,
+ * please support Adafruit and open-source hardware by purchasing
+ * products from Adafruit!
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __ADAFRUIT_BQ25798_TIMEPREDICTOR_H__
+#define __ADAFRUIT_BQ25798_TIMEPREDICTOR_H__
+
+#include "Adafruit_BQ25798.h"
+#include "Adafruit_BQ25798_SOC.h"
+
+#define BQ25798_TIME_UNKNOWN 0xFFFF          ///< No estimate in this direction
+#define BQ25798_PREDICT_DEFAULT_CV_X100 2000 ///< Charge taken in CV, 0.01 %
+#define BQ25798_PREDICT_IDLE_MA 10           ///< Largest current when idle
+
+/*!
+ * @brief Predicts minutes until the battery is full or empty
+ *
+ * Drives an Adafruit_BQ25798_SOC estimator and works out the charge left to
+ * go in or come out from its state of charge. Discharging, that charge is
+ * divided by the averaged battery current. Charging, the constant-current
+ * part is taken at the charge current limit (or the measured current in
+ * fast charge, which input limits may hold lower), and the constant-voltage
+ * taper is modelled as an exponential decay down to the termination
+ * current. How much charge the taper holds is learned each time the
+ * charger moves from fast charge to taper. Each sample costs O(1) work.
+ */
+class Adafruit_BQ25798_TimePredictor {
+ public:
+  Adafruit_BQ25798_TimePredictor(Adafruit_BQ25798* charger,
+                                 Adafruit_BQ25798_SOC* soc);
+
+  bool begin();
+  bool update();
+  void addSample(uint16_t vbat_mV, int16_t ibat_mA, uint32_t now_us,
+                 bq25798_chg_stat_t status);
+
+  uint16_t getMinutesToFull();
+  uint16_t getMinutesToEmpty();
+  int16_t getAverageCurrent_mA();
+
+ private:
+  uint16_t chargeMinutes(uint32_t to_go_mAh, uint32_t cv_mAh,
+                         uint16_t cc_mA);
+
+  Adafruit_BQ25798* charger; ///< Charger read by update()
+  Adafruit_BQ25798_SOC* soc; ///< State of charge estimator driven
+  uint16_t ichg_mA;          ///< Charge current limit
+  uint16_t iterm_mA;         ///< Termination current
+  uint16_t cv_x100;          ///< Share of capacity charged in CV
+  int32_t current_x16;       ///< Averaged battery current, 1/16 mA
+  bq25798_chg_stat_t status; ///< Charge phase at the last sample
+  uint16_t to_full_min;      ///< Minutes to full
+  uint16_t to_empty_min;     ///< Minutes to empty
+  bool sampled;              ///< At least one sample taken
+};
+
+#endif // __ADAFRUIT_BQ25798_TIMEPREDICTOR_H__
@@ -0,0 +1,74 @@
+/*
+ * Interrupt driven event handling for the Adafruit BQ25798 charger
+ *
+ * Connect the charger INT pin to BQ_INT_PIN. Each time INT falls, the
+ * library reads all six flag registers in one burst and the events are
+ * printed from the main loop.
+ */
+
+#include <Adafruit_BQ25798.h>
+
+#define BQ_INT_PIN 5 // Change to the pin wired to INT on your board
+
+Adafruit_BQ25798 bq;
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  Serial.println(F("Adafruit BQ25798 events test"));
+
+  if (!bq.begin()) {
+    Serial.println(F("Could not find a valid BQ25798 sensor, check wiring!"));
+    while (1)
+      ;
+  }
+
+  if (!bq.attachInterruptPin(BQ_INT_PIN)) {
+    Serial.println(F("INT pin does not support interrupts!"));
+    while (1)
+      ;
+  }
+
+  // Don't wake up for routine ADC and thermal regulation updates
+  bq.setEventMask(BQ25798_EVENT_ADC_DONE | BQ25798_EVENT_TREG |
+                  BQ25798_EVENT_IINDPM | BQ25798_EVENT_VINDPM);
+
+  Serial.println(F("Waiting for charger events..."));
+}
+
+void loop() {
+  // Only touches the bus if INT fell since the last call
+  bq.updateEvents();
+
+  uint64_t events = bq.takeEvents();
+  if (!events) {
+    return;
+  }
+
+  if (events & BQ25798_EVENT_VBUS_PRESENT) {
+    Serial.println(F("VBUS present changed"));
+  }
+  if (events & BQ25798_EVENT_PG) {
+    Serial.println(F("Power good changed"));
+  }
+  if (events & BQ25798_EVENT_CHG) {
+    Serial.println(F("Charge status changed"));
+  }
+  if (events & BQ25798_EVENT_VBAT_PRESENT) {
+    Serial.println(F("Battery present changed"));
+  }
+  if (events & BQ25798_EVENT_WD) {
+    Serial.println(F("Watchdog expired"));
+  }
+  if (events & (BQ25798_EVENT_TS_HOT | BQ25798_EVENT_TS_WARM |
+                BQ25798_EVENT_TS_COOL | BQ25798_EVENT_TS_COLD)) {
+    Serial.println(F("Battery temperature range changed"));
+  }
+  if (events & (BQ25798_EVENT_VBUS_OVP | BQ25798_EVENT_VBAT_OVP |
+                BQ25798_EVENT_IBUS_OCP | BQ25798_EVENT_IBAT_OCP |
+                BQ25798_EVENT_CONV_OCP | BQ25798_EVENT_TSHUT)) {
+    Serial.println(F("Fault!"));
+  }
+}
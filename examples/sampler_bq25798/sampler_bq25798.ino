@@ -0,0 +1,51 @@
+/*
+ * Streaming ADC telemetry from the Adafruit BQ25798 charger
+ *
+ * The sampler reads the whole ADC block in one I2C burst every 100ms and
+ * queues the results, and the loop prints whatever has been queued.
+ */
+
+#include <Adafruit_BQ25798.h>
+#include <Adafruit_BQ25798_Sampler.h>
+
+Adafruit_BQ25798 bq;
+Adafruit_BQ25798_Sampler<16> sampler(&bq, 100);
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10);
+
+  Serial.println(F("Adafruit BQ25798 sampler test"));
+
+  if (!bq.begin()) {
+    Serial.println(F("Could not find a valid BQ25798 sensor, check wiring!"));
+    while (1)
+      ;
+  }
+
+  // Continuous conversions at 12-bit resolution
+  bq.setADCResolution(BQ25798_ADC_SAMPLE_12BIT);
+  bq.setADCOneShot(false);
+  bq.setADCEnable(true);
+}
+
+void loop() {
+  // Producer: only touches the bus when a sample is due
+  sampler.poll();
+
+  // Consumer: drain everything that has been queued
+  bq25798_sample_t sample;
+  while (sampler.read(sample)) {
+    Serial.print(sample.timestamp);
+    Serial.print(F(" ms  VBAT: "));
+    Serial.print(sample.adc.vbat_mV);
+    Serial.print(F(" mV  IBAT: "));
+    Serial.print(sample.adc.ibat_mA);
+    Serial.print(F(" mA  VBUS: "));
+    Serial.print(sample.adc.vbus_mV);
+    Serial.print(F(" mV  IBUS: "));
+    Serial.print(sample.adc.ibus_mA);
+    Serial.println(F(" mA"));
+  }
+}
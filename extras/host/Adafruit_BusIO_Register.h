@@ -0,0 +1,15 @@
+/*!
+ * @file Adafruit_BusIO_Register.h
+ *
+ * Host stand-in for the Adafruit BusIO register header. The BQ25798 library
+ * only needs the I2C device it pulls in.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __HOST_ADAFRUIT_BUSIO_REGISTER_H__
+#define __HOST_ADAFRUIT_BUSIO_REGISTER_H__
+
+#include "Adafruit_I2CDevice.h"
+
+#endif // __HOST_ADAFRUIT_BUSIO_REGISTER_H__
@@ -0,0 +1,167 @@
+/*!
+ * @file Adafruit_I2CDevice.cpp
+ *
+ * Host stand-in for the Adafruit BusIO I2C device.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_I2CDevice.h"
+
+/*!
+ * @brief Create a device
+ * @param addr 7-bit address
+ * @param theWire Bus the device sits on
+ */
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire* theWire) {
+  _addr = addr;
+  _wire = theWire;
+  _begun = false;
+  _maxBufferSize = 32;
+}
+
+/*!
+ * @brief Get the device address
+ * @return 7-bit address
+ */
+uint8_t Adafruit_I2CDevice::address() {
+  return _addr;
+}
+
+/*!
+ * @brief Start the bus and optionally probe for the device
+ * @param addr_detect True to check that the device answers
+ * @return True if the device was found (or not checked)
+ */
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  _wire->begin();
+  _begun = true;
+
+  if (addr_detect) {
+    return detected();
+  }
+  return true;
+}
+
+/*!
+ * @brief Release the device
+ */
+void Adafruit_I2CDevice::end() {
+  _begun = false;
+}
+
+/*!
+ * @brief Probe for the device with an empty write
+ * @return True if the device acknowledged
+ */
+bool Adafruit_I2CDevice::detected() {
+  if (!_begun && !begin(false)) {
+    return false;
+  }
+
+  _wire->stats.transactions++;
+  return _wire->hostWrite(_addr, NULL, 0);
+}
+
+/*!
+ * @brief Read from the device, in Wire-buffer sized chunks
+ * @param buffer Destination
+ * @param len Number of bytes
+ * @param stop Unused, every chunk ends with a STOP as on AVR
+ * @return True if successful
+ */
+bool Adafruit_I2CDevice::read(uint8_t* buffer, size_t len, bool stop) {
+  (void)stop;
+
+  _wire->stats.transactions++;
+  return _read(buffer, len);
+}
+
+/*!
+ * @brief Write to the device, optionally after a prefix (register address)
+ * @param buffer Data to write
+ * @param len Number of data bytes
+ * @param stop Unused, the simulated bus does not hold the line
+ * @param prefix_buffer Bytes sent before the data, or NULL
+ * @param prefix_len Number of prefix bytes
+ * @return True if successful, false if too long for the Wire buffer or the
+ * device did not acknowledge
+ */
+bool Adafruit_I2CDevice::write(const uint8_t* buffer, size_t len, bool stop,
+                               const uint8_t* prefix_buffer,
+                               size_t prefix_len) {
+  (void)stop;
+
+  if ((len + prefix_len) > maxBufferSize()) {
+    return false;
+  }
+
+  uint8_t data[256];
+  if (prefix_len) {
+    memcpy(data, prefix_buffer, prefix_len);
+  }
+  if (len) {
+    memcpy(data + prefix_len, buffer, len);
+  }
+
+  _wire->stats.transactions++;
+  return _wire->hostWrite(_addr, data, len + prefix_len);
+}
+
+/*!
+ * @brief Write then read with a repeated START, the usual register read
+ * @param write_buffer Bytes to write (register address)
+ * @param write_len Number of bytes to write
+ * @param read_buffer Destination for the bytes read
+ * @param read_len Number of bytes to read
+ * @param stop Unused
+ * @return True if successful
+ */
+bool Adafruit_I2CDevice::write_then_read(const uint8_t* write_buffer,
+                                         size_t write_len,
+                                         uint8_t* read_buffer,
+                                         size_t read_len, bool stop) {
+  (void)stop;
+
+  if (write_len > maxBufferSize()) {
+    return false;
+  }
+
+  _wire->stats.transactions++;
+  if (!_wire->hostWrite(_addr, write_buffer, write_len)) {
+    return false;
+  }
+  return _read(read_buffer, read_len);
+}
+
+/*!
+ * @brief Change the bus clock
+ * @param desiredclk SCL frequency in Hz
+ * @return True
+ */
+bool Adafruit_I2CDevice::setSpeed(uint32_t desiredclk) {
+  _wire->setClock(desiredclk);
+  return true;
+}
+
+/*!
+ * @brief Read phases, split at the Wire buffer size like BusIO
+ * @param buffer Destination
+ * @param len Number of bytes
+ * @return True if every chunk was acknowledged
+ */
+bool Adafruit_I2CDevice::_read(uint8_t* buffer, size_t len) {
+  size_t pos = 0;
+
+  while (pos < len) {
+    size_t chunk = len - pos;
+    if (chunk > maxBufferSize()) {
+      chunk = maxBufferSize();
+    }
+    if (!_wire->hostRead(_addr, buffer + pos, chunk)) {
+      return false;
+    }
+    pos += chunk;
+  }
+  return true;
+}
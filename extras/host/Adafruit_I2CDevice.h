@@ -0,0 +1,53 @@
+/*!
+ * @file Adafruit_I2CDevice.h
+ *
+ * Host stand-in for the Adafruit BusIO I2C device, routed to the simulated
+ * TwoWire bus. Chunking and buffer limits follow BusIO on AVR, so transaction
+ * counts match what a 32 KB part would see.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __HOST_ADAFRUIT_I2CDEVICE_H__
+#define __HOST_ADAFRUIT_I2CDEVICE_H__
+
+#include "Wire.h"
+
+/*!
+ * @brief I2C device on the simulated bus
+ */
+class Adafruit_I2CDevice {
+ public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire* theWire = &Wire);
+
+  uint8_t address();
+  bool begin(bool addr_detect = true);
+  void end();
+  bool detected();
+
+  bool read(uint8_t* buffer, size_t len, bool stop = true);
+  bool write(const uint8_t* buffer, size_t len, bool stop = true,
+             const uint8_t* prefix_buffer = NULL, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t* write_buffer, size_t write_len,
+                       uint8_t* read_buffer, size_t read_len,
+                       bool stop = false);
+  bool setSpeed(uint32_t desiredclk);
+
+  /*!
+   * @brief Get the largest single bus transfer
+   * @return Buffer size in bytes
+   */
+  size_t maxBufferSize() {
+    return _maxBufferSize;
+  }
+
+ private:
+  bool _read(uint8_t* buffer, size_t len);
+
+  uint8_t _addr;         ///< 7-bit address
+  TwoWire* _wire;        ///< Bus
+  bool _begun;           ///< begin() succeeded
+  size_t _maxBufferSize; ///< Wire buffer size, as on AVR
+};
+
+#endif // __HOST_ADAFRUIT_I2CDEVICE_H__
@@ -0,0 +1,176 @@
+/*!
+ * @file Arduino.cpp
+ *
+ * Simulated clock and pin interrupts for the host build. Defining
+ * HOST_REAL_CLOCK switches millis(), micros() and delay() to the monotonic
+ * clock, for running the driver on a Linux board.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Arduino.h"
+
+#ifdef HOST_REAL_CLOCK
+#include <time.h>
+#endif
+
+static uint64_t now_us = 0;               ///< Simulated time, or real start
+static void (*isrs[HOST_NUM_PINS])(void); ///< Attached ISRs
+static uint8_t pin_levels[HOST_NUM_PINS]; ///< Pin output levels
+
+/*!
+ * @brief Read the clock
+ * @return Microseconds since the clock started
+ */
+static uint64_t nowMicros() {
+#ifdef HOST_REAL_CLOCK
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 - now_us;
+#else
+  return now_us;
+#endif
+}
+
+/*!
+ * @brief Sleep, or advance the simulated clock
+ * @param us Microseconds to wait
+ */
+static void waitMicros(uint64_t us) {
+#ifdef HOST_REAL_CLOCK
+  struct timespec ts;
+  ts.tv_sec = us / 1000000;
+  ts.tv_nsec = (long)(us % 1000000) * 1000;
+  while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) != 0) {
+  }
+#else
+  now_us += us;
+#endif
+}
+
+/*!
+ * @brief Get the time
+ * @return Milliseconds since the clock started
+ */
+uint32_t millis() {
+  return (uint32_t)(nowMicros() / 1000);
+}
+
+/*!
+ * @brief Get the time
+ * @return Microseconds since the clock started, wrapping at 32 bits
+ */
+uint32_t micros() {
+  return (uint32_t)nowMicros();
+}
+
+/*!
+ * @brief Wait, or advance the simulated clock
+ * @param ms Milliseconds to wait
+ */
+void delay(uint32_t ms) {
+  waitMicros((uint64_t)ms * 1000);
+}
+
+/*!
+ * @brief Wait, or advance the simulated clock
+ * @param us Microseconds to wait
+ */
+void delayMicroseconds(uint32_t us) {
+  waitMicros(us);
+}
+
+#ifdef HOST_REAL_CLOCK
+/*!
+ * @brief Start the real clock from zero when the program loads
+ */
+static struct HostClockStart {
+  HostClockStart() {
+    now_us = nowMicros();
+  }
+} host_clock_start;
+#else
+/*!
+ * @brief Advance the simulated clock
+ * @param us Microseconds to advance
+ */
+void hostAdvanceMicros(uint32_t us) {
+  now_us += us;
+}
+
+/*!
+ * @brief Set the simulated clock, e.g. to just before a 32-bit wrap
+ * @param us New time in microseconds
+ */
+void hostSetMicros(uint32_t us) {
+  now_us = us;
+}
+#endif
+
+/*!
+ * @brief Set a pin mode. Pull-ups idle the pin high.
+ * @param pin Pin number
+ * @param mode INPUT, OUTPUT or INPUT_PULLUP
+ */
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < HOST_NUM_PINS && mode == INPUT_PULLUP) {
+    pin_levels[pin] = HIGH;
+  }
+}
+
+/*!
+ * @brief Read a pin
+ * @param pin Pin number
+ * @return Last level written to the pin
+ */
+int digitalRead(uint8_t pin) {
+  return pin < HOST_NUM_PINS ? pin_levels[pin] : LOW;
+}
+
+/*!
+ * @brief Drive a pin
+ * @param pin Pin number
+ * @param value LOW or HIGH
+ */
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < HOST_NUM_PINS) {
+    pin_levels[pin] = value;
+  }
+}
+
+/*!
+ * @brief Attach an ISR to a pin. The edge is ignored; see hostFireInterrupt().
+ * @param irq Interrupt number from digitalPinToInterrupt()
+ * @param isr Handler
+ * @param mode Edge selection (unused)
+ */
+void attachInterrupt(int irq, void (*isr)(void), int mode) {
+  (void)mode;
+  if (irq >= 0 && irq < HOST_NUM_PINS) {
+    isrs[irq] = isr;
+  }
+}
+
+/*!
+ * @brief Detach the ISR from a pin
+ * @param irq Interrupt number from digitalPinToInterrupt()
+ */
+void detachInterrupt(int irq) {
+  if (irq >= 0 && irq < HOST_NUM_PINS) {
+    isrs[irq] = NULL;
+  }
+}
+
+/*!
+ * @brief Run the ISR attached to a pin, as if its edge had arrived
+ * @param irq Interrupt number
+ * @return True if an ISR was attached
+ */
+bool hostFireInterrupt(int irq) {
+  if (irq < 0 || irq >= HOST_NUM_PINS || !isrs[irq]) {
+    return false;
+  }
+
+  isrs[irq]();
+  return true;
+}
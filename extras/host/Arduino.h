@@ -0,0 +1,67 @@
+/*!
+ * @file Arduino.h
+ *
+ * Minimal Arduino core for building the BQ25798 library on a Linux host.
+ * Time is simulated: millis() and micros() only move when a test advances
+ * the clock or calls delay(). Build with HOST_REAL_CLOCK to use the
+ * monotonic clock instead, e.g. with Adafruit_BQ25798_LinuxI2C.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __HOST_ARDUINO_H__
+#define __HOST_ARDUINO_H__
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte; ///< Arduino byte type
+
+// Flash and RAM share one address space on the host
+#define PROGMEM                                         ///< No-op
+#define memcpy_P memcpy                                 ///< Copy from flash
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))   ///< Read flash byte
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))  ///< Read flash word
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr)) ///< Read flash dword
+
+#define LOW 0x0  ///< Pin low
+#define HIGH 0x1 ///< Pin high
+
+#define INPUT 0x0        ///< Pin mode input
+#define OUTPUT 0x1       ///< Pin mode output
+#define INPUT_PULLUP 0x2 ///< Pin mode input with pull-up
+
+#define CHANGE 1  ///< Interrupt on any edge
+#define FALLING 2 ///< Interrupt on falling edge
+#define RISING 3  ///< Interrupt on rising edge
+
+#define HOST_NUM_PINS 32    ///< Simulated digital pins
+#define NOT_AN_INTERRUPT -1 ///< digitalPinToInterrupt() for a bad pin
+
+/*!
+ * @brief Map a pin to its interrupt number; every simulated pin has one
+ */
+#define digitalPinToInterrupt(p) \
+  ((p) < HOST_NUM_PINS ? (int)(p) : NOT_AN_INTERRUPT)
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+void attachInterrupt(int irq, void (*isr)(void), int mode);
+void detachInterrupt(int irq);
+
+#ifndef HOST_REAL_CLOCK
+void hostAdvanceMicros(uint32_t us);
+void hostSetMicros(uint32_t us);
+#endif
+bool hostFireInterrupt(int irq);
+
+#endif // __HOST_ARDUINO_H__
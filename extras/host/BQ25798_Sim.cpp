@@ -0,0 +1,247 @@
+/*!
+ * @file BQ25798_Sim.cpp
+ *
+ * Simulated BQ25798 register file for the host build.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "BQ25798_Sim.h"
+
+/*!
+ * @brief Power-on reset values, 1S PROG setting
+ */
+static const uint8_t reset_values[BQ25798_SIM_REGS] = {
+    0x04, 0x01, 0xA4, 0x00, 0x64, 0x24, 0x01, 0x2C, // 0x00-0x07
+    0xC3, 0x05, 0x23, 0x00, 0xDC, 0x4C, 0x3D, 0xA2, // 0x08-0x0F
+    0xB5, 0x40, 0x00, 0x01, 0x1E, 0xAA, 0xC0, 0x7A, // 0x10-0x17
+    0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18-0x1F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x20-0x27
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x28-0x2F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x30-0x37
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x38-0x3F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x40-0x47
+    0x19,                                           // 0x48
+};
+
+/*!
+ * @brief Get the bits of a register that ignore writes
+ * @param reg Register address
+ * @return Read-only bit mask
+ */
+static uint8_t readOnlyBits(uint8_t reg) {
+  if ((reg >= 0x19 && reg <= 0x27) || (reg >= 0x31 && reg <= 0x46) ||
+      reg == 0x48) {
+    return 0xFF;
+  }
+  return 0x00;
+}
+
+/*!
+ * @brief Get the command bits of a register that clear once acted on
+ * @param reg Register address
+ * @return Self-clearing bit mask
+ */
+static uint8_t selfClearingBits(uint8_t reg) {
+  switch (reg) {
+    case 0x09: // REG_RST
+      return 0x40;
+    case 0x0F: // FORCE_ICO
+      return 0x08;
+    case 0x10: // WD_RST
+      return 0x08;
+    case 0x11: // FORCE_INDET
+      return 0x80;
+    case 0x13: // FORCE_VINDPM_DET
+      return 0x02;
+    default:
+      return 0x00;
+  }
+}
+
+/*!
+ * @brief Check whether a register clears when read
+ * @param reg Register address
+ * @return True for the flag registers 0x22-0x27
+ */
+static bool clearOnRead(uint8_t reg) {
+  return reg >= 0x22 && reg <= 0x27;
+}
+
+/*!
+ * @brief Create a simulated charger in its power-on state
+ */
+BQ25798_Sim::BQ25798_Sim() {
+  powerOn();
+}
+
+/*!
+ * @brief Power cycle: every register to its reset value, counters cleared
+ */
+void BQ25798_Sim::powerOn() {
+  memcpy(regs, reset_values, sizeof(regs));
+  pointer = 0;
+  nack = false;
+  clearCounters();
+}
+
+/*!
+ * @brief Handle a write phase: register address, then data with
+ * auto-increment
+ * @param data Bytes written
+ * @param len Number of bytes
+ * @return True to ACK
+ */
+bool BQ25798_Sim::i2cWrite(const uint8_t* data, size_t len) {
+  if (nack) {
+    return false;
+  }
+  if (len == 0) {
+    return true;
+  }
+
+  pointer = data[0];
+  for (size_t i = 1; i < len; i++) {
+    if (pointer < BQ25798_SIM_REGS) {
+      writeRegister(pointer, data[i]);
+      pointer++;
+    }
+  }
+  return true;
+}
+
+/*!
+ * @brief Handle a read phase from the address pointer with auto-increment
+ * @param data Destination for the bytes read
+ * @param len Number of bytes
+ * @return True to ACK
+ */
+bool BQ25798_Sim::i2cRead(uint8_t* data, size_t len) {
+  if (nack) {
+    return false;
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    if (pointer < BQ25798_SIM_REGS) {
+      data[i] = regs[pointer];
+      reg_reads[pointer]++;
+      if (clearOnRead(pointer)) {
+        regs[pointer] = 0;
+      }
+      pointer++;
+    } else {
+      data[i] = 0;
+    }
+  }
+  return true;
+}
+
+/*!
+ * @brief Look at a register without side effects
+ * @param reg Register address
+ * @return Register value
+ */
+uint8_t BQ25798_Sim::peek(uint8_t reg) {
+  return reg < BQ25798_SIM_REGS ? regs[reg] : 0;
+}
+
+/*!
+ * @brief Look at a big-endian register pair without side effects
+ * @param reg Address of the MSB
+ * @return Register pair value
+ */
+uint16_t BQ25798_Sim::peekWord(uint8_t reg) {
+  return ((uint16_t)peek(reg) << 8) | peek(reg + 1);
+}
+
+/*!
+ * @brief Set a register directly, ignoring access rules (e.g. status or ADC)
+ * @param reg Register address
+ * @param value New value
+ */
+void BQ25798_Sim::poke(uint8_t reg, uint8_t value) {
+  if (reg < BQ25798_SIM_REGS) {
+    regs[reg] = value;
+  }
+}
+
+/*!
+ * @brief Set a big-endian register pair directly
+ * @param reg Address of the MSB
+ * @param value New value
+ */
+void BQ25798_Sim::pokeWord(uint8_t reg, uint16_t value) {
+  poke(reg, value >> 8);
+  poke(reg + 1, value & 0xFF);
+}
+
+/*!
+ * @brief Latch event flags, as the chip does when a status bit changes
+ * @param reg Flag register (0x22-0x27)
+ * @param bits Flag bits to set
+ */
+void BQ25798_Sim::raiseFlags(uint8_t reg, uint8_t bits) {
+  if (clearOnRead(reg)) {
+    regs[reg] |= bits;
+  }
+}
+
+/*!
+ * @brief Make the chip stop acknowledging, to test bus error paths
+ * @param nack True to NACK every transfer
+ */
+void BQ25798_Sim::setNack(bool nack) {
+  this->nack = nack;
+}
+
+/*!
+ * @brief Zero the per-register and command counters
+ */
+void BQ25798_Sim::clearCounters() {
+  memset(reg_writes, 0, sizeof(reg_writes));
+  memset(reg_reads, 0, sizeof(reg_reads));
+  watchdog_resets = 0;
+  vindpm_detections = 0;
+  register_resets = 0;
+}
+
+/*!
+ * @brief Apply one byte written over I2C, including command side effects
+ * @param reg Register address
+ * @param value Byte written
+ */
+void BQ25798_Sim::writeRegister(uint8_t reg, uint8_t value) {
+  uint8_t read_only = readOnlyBits(reg);
+
+  reg_writes[reg]++;
+  regs[reg] = (regs[reg] & read_only) | (value & ~read_only);
+
+  if (reg == 0x09 && (value & 0x40)) {
+    register_resets++;
+    resetRegisters();
+  }
+  if (reg == 0x10 && (value & 0x08)) {
+    watchdog_resets++;
+  }
+  if (reg == 0x13 && (value & 0x02)) {
+    vindpm_detections++;
+  }
+  if (reg == 0x2E && (regs[reg] & 0xC0) == 0xC0) {
+    // One-shot conversion finishes at once: ADC_EN clears, ADC_DONE is set
+    regs[reg] &= ~0x80;
+    regs[0x1E] |= 0x20;
+    regs[0x24] |= 0x20;
+  }
+
+  regs[reg] &= ~selfClearingBits(reg);
+}
+
+/*!
+ * @brief REG_RST: every writable register back to its reset value
+ */
+void BQ25798_Sim::resetRegisters() {
+  for (uint8_t reg = 0; reg < BQ25798_SIM_REGS; reg++) {
+    uint8_t read_only = readOnlyBits(reg);
+    regs[reg] = (regs[reg] & read_only) | (reset_values[reg] & ~read_only);
+  }
+}
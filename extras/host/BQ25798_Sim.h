@@ -0,0 +1,55 @@
+/*!
+ * @file BQ25798_Sim.h
+ *
+ * Simulated BQ25798 register file for the host build. Registers 0x00-0x48
+ * power up with their datasheet reset values (1S PROG setting), read-only
+ * bits ignore writes, the flag registers clear on read, and the self-clearing
+ * command bits behave like the chip.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __BQ25798_SIM_H__
+#define __BQ25798_SIM_H__
+
+#include "Wire.h"
+
+#define BQ25798_SIM_REGS 0x49 ///< Registers 0x00-0x48
+
+/*!
+ * @brief Simulated BQ25798 on the host I2C bus
+ */
+class BQ25798_Sim : public HostI2CTarget {
+ public:
+  BQ25798_Sim();
+
+  void powerOn();
+
+  bool i2cWrite(const uint8_t* data, size_t len) override;
+  bool i2cRead(uint8_t* data, size_t len) override;
+
+  uint8_t peek(uint8_t reg);
+  uint16_t peekWord(uint8_t reg);
+  void poke(uint8_t reg, uint8_t value);
+  void pokeWord(uint8_t reg, uint16_t value);
+  void raiseFlags(uint8_t reg, uint8_t bits);
+
+  void setNack(bool nack);
+  void clearCounters();
+
+  uint32_t reg_writes[BQ25798_SIM_REGS]; ///< Bytes written per register
+  uint32_t reg_reads[BQ25798_SIM_REGS];  ///< Bytes read per register
+  uint32_t watchdog_resets;              ///< WD_RST commands seen
+  uint32_t vindpm_detections;            ///< FORCE_VINDPM_DET commands seen
+  uint32_t register_resets;              ///< REG_RST commands seen
+
+ private:
+  void writeRegister(uint8_t reg, uint8_t value);
+  void resetRegisters();
+
+  uint8_t regs[BQ25798_SIM_REGS]; ///< Register contents
+  uint8_t pointer;                ///< Register address pointer
+  bool nack;                      ///< Refuse all transfers
+};
+
+#endif // __BQ25798_SIM_H__
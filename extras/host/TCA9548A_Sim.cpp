@@ -0,0 +1,87 @@
+/*!
+ * @file TCA9548A_Sim.cpp
+ *
+ * Simulated TCA9548A 8-channel I2C switch for the host build.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "TCA9548A_Sim.h"
+
+/*!
+ * @brief Power on with every channel disconnected
+ */
+TCA9548A_Sim::TCA9548A_Sim() {
+  control = 0;
+  writes = 0;
+  for (uint8_t i = 0; i < TCA9548A_SIM_PORTS; i++) {
+    targets[i] = NULL;
+  }
+}
+
+/*!
+ * @brief Write the control register; the last byte written wins
+ * @param data Bytes written
+ * @param len Number of bytes
+ * @return True
+ */
+bool TCA9548A_Sim::i2cWrite(const uint8_t* data, size_t len) {
+  if (len) {
+    control = data[len - 1];
+    writes++;
+  }
+  return true;
+}
+
+/*!
+ * @brief Read the control register
+ * @param data Destination
+ * @param len Number of bytes
+ * @return True
+ */
+bool TCA9548A_Sim::i2cRead(uint8_t* data, size_t len) {
+  memset(data, control, len);
+  return true;
+}
+
+/*!
+ * @brief Find a target on an enabled channel
+ * @param addr 7-bit address
+ * @return The target, or NULL if none or more than one would answer
+ */
+HostI2CTarget* TCA9548A_Sim::downstream(uint8_t addr) {
+  HostI2CTarget* found = NULL;
+
+  for (uint8_t i = 0; i < TCA9548A_SIM_PORTS; i++) {
+    if (targets[i] && addrs[i] == addr && (control & (1 << channels[i]))) {
+      if (found) {
+        return NULL;
+      }
+      found = targets[i];
+    }
+  }
+  return found;
+}
+
+/*!
+ * @brief Put a target on a downstream channel
+ * @param channel Channel 0-7
+ * @param addr 7-bit address
+ * @param target Target to answer at that address
+ * @return True if attached, false if the channel is invalid or ports ran out
+ */
+bool TCA9548A_Sim::attach(uint8_t channel, uint8_t addr,
+                          HostI2CTarget* target) {
+  if (channel >= TCA9548A_SIM_CHANNELS) {
+    return false;
+  }
+  for (uint8_t i = 0; i < TCA9548A_SIM_PORTS; i++) {
+    if (!targets[i]) {
+      channels[i] = channel;
+      addrs[i] = addr;
+      targets[i] = target;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,40 @@
+/*!
+ * @file TCA9548A_Sim.h
+ *
+ * Simulated TCA9548A 8-channel I2C switch for the host build.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __TCA9548A_SIM_H__
+#define __TCA9548A_SIM_H__
+
+#include "Wire.h"
+
+#define TCA9548A_SIM_CHANNELS 8 ///< Downstream channels
+#define TCA9548A_SIM_PORTS 16   ///< Downstream targets across all channels
+
+/*!
+ * @brief A TCA9548A: one control register whose bits connect downstream
+ * channels to the upstream bus
+ */
+class TCA9548A_Sim : public HostI2CTarget {
+ public:
+  TCA9548A_Sim();
+
+  bool i2cWrite(const uint8_t* data, size_t len) override;
+  bool i2cRead(uint8_t* data, size_t len) override;
+  HostI2CTarget* downstream(uint8_t addr) override;
+
+  bool attach(uint8_t channel, uint8_t addr, HostI2CTarget* target);
+
+  uint8_t control; ///< Enabled channels, one bit each
+  uint32_t writes; ///< Control register writes seen
+
+ private:
+  uint8_t channels[TCA9548A_SIM_PORTS];       ///< Channel of each port
+  uint8_t addrs[TCA9548A_SIM_PORTS];          ///< Address of each port
+  HostI2CTarget* targets[TCA9548A_SIM_PORTS]; ///< Target of each port
+};
+
+#endif // __TCA9548A_SIM_H__
@@ -0,0 +1,161 @@
+/*!
+ * @file Wire.cpp
+ *
+ * Simulated I2C bus for the host build.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Wire.h"
+
+TwoWire Wire;
+
+/*!
+ * @brief Create an empty bus at 100 kHz
+ */
+TwoWire::TwoWire() {
+  for (uint8_t i = 0; i < HOST_I2C_MAX_TARGETS; i++) {
+    targets[i] = NULL;
+  }
+  clock = 100000;
+  clearStats();
+}
+
+/*!
+ * @brief Start the bus (no-op on the host)
+ */
+void TwoWire::begin() {}
+
+/*!
+ * @brief Stop the bus (no-op on the host)
+ */
+void TwoWire::end() {}
+
+/*!
+ * @brief Set the SCL frequency
+ * @param hz Frequency in Hz
+ */
+void TwoWire::setClock(uint32_t hz) {
+  clock = hz;
+}
+
+/*!
+ * @brief Get the SCL frequency
+ * @return Frequency in Hz
+ */
+uint32_t TwoWire::getClock() {
+  return clock;
+}
+
+/*!
+ * @brief Put a target on the bus
+ * @param addr 7-bit address
+ * @param target Target to answer at that address
+ * @return True if attached, false if the bus is full
+ */
+bool TwoWire::attach(uint8_t addr, HostI2CTarget* target) {
+  detach(addr);
+  for (uint8_t i = 0; i < HOST_I2C_MAX_TARGETS; i++) {
+    if (!targets[i]) {
+      addrs[i] = addr;
+      targets[i] = target;
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * @brief Remove the target at an address
+ * @param addr 7-bit address
+ */
+void TwoWire::detach(uint8_t addr) {
+  for (uint8_t i = 0; i < HOST_I2C_MAX_TARGETS; i++) {
+    if (targets[i] && addrs[i] == addr) {
+      targets[i] = NULL;
+    }
+  }
+}
+
+/*!
+ * @brief Check whether a target answers at an address
+ * @param addr 7-bit address
+ * @return True if a target is attached
+ */
+bool TwoWire::present(uint8_t addr) {
+  return find(addr) != NULL;
+}
+
+/*!
+ * @brief Run one write phase (START, address, data)
+ * @param addr 7-bit address
+ * @param data Bytes to write
+ * @param len Number of bytes
+ * @return True if the target acknowledged
+ */
+bool TwoWire::hostWrite(uint8_t addr, const uint8_t* data, size_t len) {
+  HostI2CTarget* target = find(addr);
+
+  stats.starts++;
+  if (!target || !target->i2cWrite(data, len)) {
+    stats.nacks++;
+    return false;
+  }
+  stats.bytes_written += len;
+  return true;
+}
+
+/*!
+ * @brief Run one read phase (START, address, data)
+ * @param addr 7-bit address
+ * @param data Destination for the bytes read
+ * @param len Number of bytes
+ * @return True if the target acknowledged
+ */
+bool TwoWire::hostRead(uint8_t addr, uint8_t* data, size_t len) {
+  HostI2CTarget* target = find(addr);
+
+  stats.starts++;
+  if (!target || !target->i2cRead(data, len)) {
+    stats.nacks++;
+    return false;
+  }
+  stats.bytes_read += len;
+  return true;
+}
+
+/*!
+ * @brief Zero the traffic counters
+ */
+void TwoWire::clearStats() {
+  memset(&stats, 0, sizeof(stats));
+}
+
+/*!
+ * @brief Look up the target at an address, directly or through a bus switch
+ * @param addr 7-bit address
+ * @return Target, or NULL if nothing answers or several targets would
+ */
+HostI2CTarget* TwoWire::find(uint8_t addr) {
+  HostI2CTarget* found = NULL;
+  uint8_t answers = 0;
+
+  for (uint8_t i = 0; i < HOST_I2C_MAX_TARGETS; i++) {
+    if (!targets[i]) {
+      continue;
+    }
+    HostI2CTarget* target =
+        addrs[i] == addr ? targets[i] : targets[i]->downstream(addr);
+    if (target) {
+      found = target;
+      answers++;
+    }
+  }
+
+  if (answers > 1) {
+    // Real chips would corrupt each other's data; fail the phase instead
+    stats.collisions++;
+    return NULL;
+  }
+  return found;
+}
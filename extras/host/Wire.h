@@ -0,0 +1,97 @@
+/*!
+ * @file Wire.h
+ *
+ * Simulated I2C bus for the host build. Targets attach to an address and
+ * see the raw bytes of every write and read phase, just like a real chip.
+ * The bus counts its traffic so tests can measure what each API call costs.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __HOST_WIRE_H__
+#define __HOST_WIRE_H__
+
+#include "Arduino.h"
+
+#define HOST_I2C_MAX_TARGETS 8 ///< Targets that can share one bus
+
+/*!
+ * @brief A simulated device on the host I2C bus
+ */
+class HostI2CTarget {
+ public:
+  virtual ~HostI2CTarget() {}
+
+  /*!
+   * @brief Handle a write phase addressed to this target
+   * @param data Bytes written after the address byte
+   * @param len Number of bytes
+   * @return True to ACK, false to NACK
+   */
+  virtual bool i2cWrite(const uint8_t* data, size_t len) = 0;
+
+  /*!
+   * @brief Handle a read phase addressed to this target
+   * @param data Destination for the bytes read
+   * @param len Number of bytes
+   * @return True to ACK, false to NACK
+   */
+  virtual bool i2cRead(uint8_t* data, size_t len) = 0;
+
+  /*!
+   * @brief For bus switches: the target this one currently connects to
+   * the bus at an address it does not own
+   * @param addr 7-bit address
+   * @return Downstream target, or NULL
+   */
+  virtual HostI2CTarget* downstream(uint8_t addr) {
+    (void)addr;
+    return NULL;
+  }
+};
+
+/*!
+ * @brief Traffic counters for the host I2C bus
+ */
+typedef struct {
+  uint32_t transactions;  ///< Driver-level operations (write, read, or both)
+  uint32_t starts;        ///< START or repeated START conditions
+  uint32_t bytes_written; ///< Data bytes written, excluding address bytes
+  uint32_t bytes_read;    ///< Data bytes read
+  uint32_t nacks;         ///< Phases that nobody acknowledged
+  uint32_t collisions;    ///< Phases that two targets answered at once
+} host_i2c_stats_t;
+
+/*!
+ * @brief Simulated TwoWire bus
+ */
+class TwoWire {
+ public:
+  TwoWire();
+
+  void begin();
+  void end();
+  void setClock(uint32_t hz);
+  uint32_t getClock();
+
+  bool attach(uint8_t addr, HostI2CTarget* target);
+  void detach(uint8_t addr);
+  bool present(uint8_t addr);
+
+  bool hostWrite(uint8_t addr, const uint8_t* data, size_t len);
+  bool hostRead(uint8_t addr, uint8_t* data, size_t len);
+
+  host_i2c_stats_t stats; ///< Traffic since the last clearStats()
+  void clearStats();
+
+ private:
+  HostI2CTarget* find(uint8_t addr);
+
+  uint8_t addrs[HOST_I2C_MAX_TARGETS];          ///< Attached addresses
+  HostI2CTarget* targets[HOST_I2C_MAX_TARGETS]; ///< Attached targets
+  uint32_t clock;                               ///< SCL frequency in Hz
+};
+
+extern TwoWire Wire; ///< Default bus
+
+#endif // __HOST_WIRE_H__
@@ -0,0 +1,563 @@
+/*!
+ * @file bench_bq25798.cpp
+ *
+ * I2C cost of every public Adafruit_BQ25798 method against the simulated
+ * chip: transactions, bytes on the wire (address bytes included), and the
+ * resulting bus time at 100 kHz, 400 kHz and 1 MHz. Each method is measured
+ * with the register cache off and on.
+ *
+ *   bench_bq25798                 print the table
+ *   bench_bq25798 --csv           print a baseline
+ *   bench_bq25798 --check FILE    fail if any method costs more than FILE
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Adafruit_BQ25798.h"
+#include "Adafruit_BQ25798_Async.h"
+#include "Adafruit_BQ25798_CoulombCounter.h"
+#include "Adafruit_BQ25798_MPPT.h"
+#include "Adafruit_BQ25798_Resistance.h"
+#include "Adafruit_BQ25798_SOC.h"
+#include "Adafruit_BQ25798_TimePredictor.h"
+#include "BQ25798_Sim.h"
+
+static BQ25798_Sim* bench_sim = NULL; ///< Chip behind the method under test
+
+/*!
+ * @brief Start measuring: everything before this call is setup
+ */
+static void benchStart() {
+  Wire.clearStats();
+  bench_sim->clearCounters();
+}
+
+/*!
+ * @brief One benchmarked method
+ */
+typedef struct {
+  const char* name;                  ///< Method name
+  void (*run)(Adafruit_BQ25798& bq); ///< Setup, benchStart(), then the call
+} bench_entry_t;
+
+/*!
+ * @brief Measured cost of one method
+ */
+typedef struct {
+  uint32_t transactions; ///< Driver-level I2C operations
+  uint32_t bytes;        ///< Bytes on the wire, address bytes included
+  uint32_t bits;         ///< SCL cycles including START, STOP and ACK bits
+  uint32_t resets;       ///< REG_RST commands issued
+} bench_cost_t;
+
+/*!
+ * @brief Benchmark a getter
+ */
+#define BENCH_GET(getter)               \
+  {                                     \
+    #getter, [](Adafruit_BQ25798& bq) { \
+      benchStart();                     \
+      bq.getter();                      \
+    }                                   \
+  }
+
+/*!
+ * @brief Benchmark a setter, writing back the current value
+ */
+#define BENCH_SET(setter, getter)       \
+  {                                     \
+    #setter, [](Adafruit_BQ25798& bq) { \
+      auto value = bq.getter();         \
+      benchStart();                     \
+      bq.setter(value);                 \
+    }                                   \
+  }
+
+/*!
+ * @brief Benchmark a getter and its setter
+ */
+#define BENCH_PAIR(getter, setter) BENCH_GET(getter), BENCH_SET(setter, getter)
+
+/*!
+ * @brief Benchmark a call that needs no setup
+ */
+#define BENCH_CALL(name, call)       \
+  {                                  \
+    name, [](Adafruit_BQ25798& bq) { \
+      (void)bq;                      \
+      benchStart();                  \
+      call;                          \
+    }                                \
+  }
+
+/*!
+ * @brief A typical set of limits, registers 0x01-0x07
+ */
+static const bq25798_field_t bench_fields[] = {
+    BQ25798_FIELD_VREG, BQ25798_FIELD_ICHG, BQ25798_FIELD_VINDPM,
+    BQ25798_FIELD_IINDPM};
+
+/*!
+ * @brief Reset values of bench_fields
+ */
+static const uint16_t bench_values[] = {4200, 1000, 3600, 3000};
+
+/*!
+ * @brief begin() on a fresh driver
+ * @param bq Unused, begin() needs its own instance
+ */
+static void benchBegin(Adafruit_BQ25798& bq) {
+  Adafruit_BQ25798 fresh;
+  fresh.setCacheEnable(bq.getCacheEnable());
+  benchStart();
+  fresh.begin();
+}
+
+/*!
+ * @brief Warm-start begin() on a fresh driver
+ * @param bq Unused, begin() needs its own instance
+ */
+static void benchBeginWarm(Adafruit_BQ25798& bq) {
+  Adafruit_BQ25798 fresh;
+  fresh.setCacheEnable(bq.getCacheEnable());
+  benchStart();
+  fresh.begin(BQ25798_DEFAULT_ADDR, &Wire, false);
+}
+
+/*!
+ * @brief Poll an async request until it finishes
+ * @param async Engine with a request submitted
+ */
+static void benchDrain(Adafruit_BQ25798_Async& async) {
+  while (async.poll() == BQ25798_ASYNC_BUSY) {
+  }
+}
+
+/*!
+ * @brief Every public method, grouped as in the class declaration
+ */
+static const bench_entry_t bench_entries[] = {
+    {"begin", benchBegin},
+    {"begin(warm)", benchBeginWarm},
+    BENCH_CALL("reset", bq.reset()),
+    BENCH_CALL("setCacheEnable", bq.setCacheEnable(bq.getCacheEnable())),
+    BENCH_CALL("refreshCache", bq.refreshCache()),
+    BENCH_CALL("readField", bq.readField(BQ25798_FIELD_VREG)),
+    BENCH_CALL("writeField", bq.writeField(BQ25798_FIELD_VREG, 420)),
+    BENCH_CALL("getField", bq.getField(BQ25798_FIELD_VREG)),
+    BENCH_CALL("setField", bq.setField(BQ25798_FIELD_VREG, 4200)),
+    BENCH_CALL("getFields", {
+      uint16_t values[4];
+      bq.getFields(bench_fields, values, 4);
+    }),
+    BENCH_CALL("setFields", bq.setFields(bench_fields, bench_values, 4)),
+    BENCH_CALL("beginUpdate..commit", {
+      bq.beginUpdate();
+      bq.setChargeEnable(true);
+      bq.setTerminationEnable(true);
+      bq.setWDT(BQ25798_WDT_40S);
+      bq.setOTGPFM(false);
+      bq.setIINDPMenable(true);
+      bq.commit();
+    }),
+    BENCH_PAIR(getMinSystemV, setMinSystemV),
+    BENCH_PAIR(getMinSystem_mV, setMinSystem_mV),
+    BENCH_PAIR(getChargeLimitV, setChargeLimitV),
+    BENCH_PAIR(getChargeLimit_mV, setChargeLimit_mV),
+    BENCH_PAIR(getChargeLimitA, setChargeLimitA),
+    BENCH_PAIR(getChargeLimit_mA, setChargeLimit_mA),
+    BENCH_PAIR(getInputLimitV, setInputLimitV),
+    BENCH_PAIR(getInputLimit_mV, setInputLimit_mV),
+    BENCH_PAIR(getInputLimitA, setInputLimitA),
+    BENCH_PAIR(getInputLimit_mA, setInputLimit_mA),
+    BENCH_PAIR(getVBatLowV, setVBatLowV),
+    BENCH_PAIR(getPrechargeLimitA, setPrechargeLimitA),
+    BENCH_PAIR(getPrechargeLimit_mA, setPrechargeLimit_mA),
+    BENCH_PAIR(getStopOnWDT, setStopOnWDT),
+    BENCH_PAIR(getTerminationA, setTerminationA),
+    BENCH_PAIR(getTermination_mA, setTermination_mA),
+    BENCH_PAIR(getCellCount, setCellCount),
+    BENCH_PAIR(getRechargeDeglitchTime, setRechargeDeglitchTime),
+    BENCH_PAIR(getRechargeThreshOffsetV, setRechargeThreshOffsetV),
+    BENCH_PAIR(getRechargeThreshOffset_mV, setRechargeThreshOffset_mV),
+    BENCH_PAIR(getOTGV, setOTGV),
+    BENCH_PAIR(getOTG_mV, setOTG_mV),
+    BENCH_PAIR(getPrechargeTimer, setPrechargeTimer),
+    BENCH_PAIR(getOTGLimitA, setOTGLimitA),
+    BENCH_PAIR(getOTGLimit_mA, setOTGLimit_mA),
+    BENCH_PAIR(getTopOffTimer, setTopOffTimer),
+    BENCH_PAIR(getTrickleChargeTimerEnable, setTrickleChargeTimerEnable),
+    BENCH_PAIR(getPrechargeTimerEnable, setPrechargeTimerEnable),
+    BENCH_PAIR(getFastChargeTimerEnable, setFastChargeTimerEnable),
+    BENCH_PAIR(getFastChargeTimer, setFastChargeTimer),
+    BENCH_PAIR(getTimerHalfRateEnable, setTimerHalfRateEnable),
+    BENCH_PAIR(getAutoOVPBattDischarge, setAutoOVPBattDischarge),
+    BENCH_PAIR(getForceBattDischarge, setForceBattDischarge),
+    BENCH_PAIR(getChargeEnable, setChargeEnable),
+    BENCH_PAIR(getICOEnable, setICOEnable),
+    BENCH_PAIR(getForceICO, setForceICO),
+    BENCH_PAIR(getHIZMode, setHIZMode),
+    BENCH_PAIR(getTerminationEnable, setTerminationEnable),
+    BENCH_PAIR(getBackupModeEnable, setBackupModeEnable),
+    BENCH_PAIR(getBackupModeThresh, setBackupModeThresh),
+    BENCH_PAIR(getVACOVP, setVACOVP),
+    BENCH_PAIR(getWDT, setWDT),
+    BENCH_PAIR(getForceDPinsDetection, setForceDPinsDetection),
+    BENCH_PAIR(getAutoDPinsDetection, setAutoDPinsDetection),
+    BENCH_PAIR(getHVDCP12VEnable, setHVDCP12VEnable),
+    BENCH_PAIR(getHVDCP9VEnable, setHVDCP9VEnable),
+    BENCH_PAIR(getHVDCPEnable, setHVDCPEnable),
+    BENCH_PAIR(getShipFETmode, setShipFETmode),
+    BENCH_PAIR(getShipFET10sDelay, setShipFET10sDelay),
+    BENCH_PAIR(getACenable, setACenable),
+    BENCH_PAIR(getOTGenable, setOTGenable),
+    BENCH_PAIR(getOTGPFM, setOTGPFM),
+    BENCH_PAIR(getForwardPFM, setForwardPFM),
+    BENCH_PAIR(getShipWakeupDelay, setShipWakeupDelay),
+    BENCH_PAIR(getBATFETLDOprecharge, setBATFETLDOprecharge),
+    BENCH_PAIR(getOTGOOA, setOTGOOA),
+    BENCH_PAIR(getForwardOOA, setForwardOOA),
+    BENCH_PAIR(getACDRV2enable, setACDRV2enable),
+    BENCH_PAIR(getACDRV1enable, setACDRV1enable),
+    BENCH_PAIR(getPWMFrequency, setPWMFrequency),
+    BENCH_PAIR(getStatPinEnable, setStatPinEnable),
+    BENCH_PAIR(getVSYSshortProtect, setVSYSshortProtect),
+    BENCH_PAIR(getVOTG_UVPProtect, setVOTG_UVPProtect),
+    BENCH_PAIR(getIBUS_OCPenable, setIBUS_OCPenable),
+    BENCH_PAIR(getVINDPMdetection, setVINDPMdetection),
+    BENCH_PAIR(getShipFETpresent, setShipFETpresent),
+    BENCH_PAIR(getBatDischargeSenseEnable, setBatDischargeSenseEnable),
+    BENCH_PAIR(getBatDischargeA, setBatDischargeA),
+    BENCH_PAIR(getIINDPMenable, setIINDPMenable),
+    BENCH_PAIR(getExtILIMpin, setExtILIMpin),
+    BENCH_PAIR(getBatDischargeOCPenable, setBatDischargeOCPenable),
+    BENCH_PAIR(getVINDPM_VOCpercent, setVINDPM_VOCpercent),
+    BENCH_PAIR(getVOCdelay, setVOCdelay),
+    BENCH_PAIR(getVOCrate, setVOCrate),
+    BENCH_PAIR(getMPPTenable, setMPPTenable),
+    BENCH_PAIR(getThermRegulationThresh, setThermRegulationThresh),
+    BENCH_PAIR(getThermShutdownThresh, setThermShutdownThresh),
+    BENCH_PAIR(getVBUSpulldown, setVBUSpulldown),
+    BENCH_PAIR(getVAC1pulldown, setVAC1pulldown),
+    BENCH_PAIR(getVAC2pulldown, setVAC2pulldown),
+    BENCH_PAIR(getBackupACFET1on, setBackupACFET1on),
+    BENCH_PAIR(getJEITAWarmVoltage, setJEITAWarmVoltage),
+    BENCH_PAIR(getJEITAWarmCurrent, setJEITAWarmCurrent),
+    BENCH_PAIR(getJEITACoolCurrent, setJEITACoolCurrent),
+    BENCH_PAIR(getTSCoolThresh, setTSCoolThresh),
+    BENCH_PAIR(getTSWarmThresh, setTSWarmThresh),
+    BENCH_PAIR(getOTGHotThresh, setOTGHotThresh),
+    BENCH_PAIR(getOTGColdThresh, setOTGColdThresh),
+    BENCH_PAIR(getTSIgnore, setTSIgnore),
+    BENCH_PAIR(getADCEnable, setADCEnable),
+    BENCH_PAIR(getADCOneShot, setADCOneShot),
+    BENCH_PAIR(getADCResolution, setADCResolution),
+    BENCH_PAIR(getADCAverage, setADCAverage),
+    BENCH_PAIR(getADCAverageInit, setADCAverageInit),
+    BENCH_CALL("resetWDT", bq.resetWDT()),
+    BENCH_CALL("service", bq.service()),
+    {"service(due)",
+     [](Adafruit_BQ25798& bq) {
+       bq.resetWDT();
+       hostAdvanceMicros(30000000UL);
+       benchStart();
+       bq.service();
+     }},
+    BENCH_CALL("getProfile", {
+      bq25798_profile_t profile;
+      bq.getProfile(profile);
+    }),
+    {"applyProfile",
+     [](Adafruit_BQ25798& bq) {
+       bq25798_profile_t profile;
+       bq.getProfile(profile);
+       profile.vreg_mV = 8400;
+       profile.cell_count = BQ25798_CELL_COUNT_2S;
+       profile.ts_ignore = true;
+       benchStart();
+       bq.applyProfile(profile);
+     }},
+    {"applyProfile(unchanged)",
+     [](Adafruit_BQ25798& bq) {
+       bq25798_profile_t profile;
+       bq.getProfile(profile);
+       benchStart();
+       bq.applyProfile(profile);
+     }},
+    BENCH_CALL("saveConfig", {
+      uint8_t blob[BQ25798_CONFIG_SIZE];
+      bq.saveConfig(blob);
+    }),
+    {"loadConfig",
+     [](Adafruit_BQ25798& bq) {
+       uint8_t blob[BQ25798_CONFIG_SIZE];
+       bq.setChargeLimit_mV(8400);
+       bq.setTSIgnore(true);
+       bq.saveConfig(blob);
+       bq.reset();
+       benchStart();
+       bq.loadConfig(blob);
+     }},
+    {"loadConfig(unchanged)",
+     [](Adafruit_BQ25798& bq) {
+       uint8_t blob[BQ25798_CONFIG_SIZE];
+       bq.saveConfig(blob);
+       benchStart();
+       bq.loadConfig(blob);
+     }},
+    BENCH_CALL("startADCOneShot", bq.startADCOneShot()),
+    BENCH_GET(getADCDone),
+    BENCH_PAIR(getADCDisableMask, setADCDisableMask),
+    BENCH_CALL("getADCCycleTime",
+               Adafruit_BQ25798::getADCCycleTime(
+                   0, BQ25798_ADC_SAMPLE_15BIT)),
+    BENCH_CALL("readAllADC", {
+      bq25798_adc_snapshot_t snapshot;
+      bq.readAllADC(snapshot);
+    }),
+    BENCH_CALL("readInputADC", {
+      uint16_t vbus_mV;
+      int16_t ibus_mA;
+      bq.readInputADC(vbus_mV, ibus_mA);
+    }),
+    BENCH_CALL("readBatteryADC", {
+      uint16_t vbat_mV;
+      int16_t ibat_mA;
+      bq.readBatteryADC(vbat_mV, ibat_mA);
+    }),
+    BENCH_CALL("getStatus", {
+      bq25798_status_t status;
+      bq.getStatus(status);
+    }),
+    BENCH_CALL("getChargeStatus", bq.getChargeStatus()),
+    BENCH_CALL("attachInterruptPin", bq.attachInterruptPin(2)),
+    BENCH_CALL("interruptPending", bq.interruptPending()),
+    BENCH_CALL("updateEvents", bq.updateEvents()),
+    BENCH_CALL("updateEvents(force)", bq.updateEvents(true)),
+    BENCH_CALL("takeEvents", bq.takeEvents()),
+    BENCH_PAIR(getEventMask, setEventMask),
+    BENCH_CALL("Async::requestStatus", {
+      Adafruit_BQ25798_Async async(&bq);
+      bq25798_status_t status;
+      async.requestStatus(&status);
+      benchDrain(async);
+    }),
+    BENCH_CALL("Async::requestADC", {
+      Adafruit_BQ25798_Async async(&bq);
+      bq25798_adc_snapshot_t snapshot;
+      async.requestADC(&snapshot);
+      benchDrain(async);
+    }),
+    BENCH_CALL("Async::requestADC(burst 8)", {
+      Adafruit_BQ25798_Async async(&bq);
+      bq25798_adc_snapshot_t snapshot;
+      async.setMaxBurst(8);
+      async.requestADC(&snapshot);
+      benchDrain(async);
+    }),
+    BENCH_CALL("Async::requestFields", {
+      Adafruit_BQ25798_Async async(&bq);
+      async.requestFields(bench_fields, bench_values, 4);
+      benchDrain(async);
+    }),
+    {"MPPT::update",
+     [](Adafruit_BQ25798& bq) {
+       Adafruit_BQ25798_MPPT mppt(&bq);
+       mppt.begin();
+       bench_sim->pokeWord(BQ25798_REG_IBUS_ADC, 1000);
+       hostAdvanceMicros(BQ25798_MPPT_DEFAULT_INTERVAL_MS * 1000UL);
+       benchStart();
+       mppt.update();
+     }},
+    BENCH_CALL("CoulombCounter::update", {
+      Adafruit_BQ25798_CoulombCounter counter(&bq);
+      counter.update();
+    }),
+    BENCH_CALL("Resistance::update", {
+      Adafruit_BQ25798_Resistance ir(&bq);
+      ir.update();
+    }),
+    {"SOC::update",
+     [](Adafruit_BQ25798& bq) {
+       Adafruit_BQ25798_SOC soc(&bq);
+       soc.begin(2000);
+       benchStart();
+       soc.update();
+     }},
+    {"TimePredictor::begin",
+     [](Adafruit_BQ25798& bq) {
+       Adafruit_BQ25798_SOC soc(&bq);
+       Adafruit_BQ25798_TimePredictor pred(&bq, &soc);
+       soc.begin(2000);
+       benchStart();
+       pred.begin();
+     }},
+    {"TimePredictor::update",
+     [](Adafruit_BQ25798& bq) {
+       Adafruit_BQ25798_SOC soc(&bq);
+       Adafruit_BQ25798_TimePredictor pred(&bq, &soc);
+       soc.begin(2000);
+       pred.begin();
+       benchStart();
+       pred.update();
+     }},
+};
+
+/*!
+ * @brief Number of benchmarked methods
+ */
+#define BENCH_COUNT (sizeof(bench_entries) / sizeof(bench_entries[0]))
+
+/*!
+ * @brief Run one entry against a freshly powered, begun chip
+ * @param entry Method to run
+ * @param cache Enable the register cache first
+ * @return Measured cost
+ */
+static bench_cost_t benchRun(const bench_entry_t& entry, bool cache) {
+  BQ25798_Sim sim;
+  Adafruit_BQ25798 bq;
+  bench_cost_t cost;
+
+  Wire.attach(BQ25798_DEFAULT_ADDR, &sim);
+  bench_sim = &sim;
+  bq.setCacheEnable(cache);
+  bq.begin();
+
+  entry.run(bq);
+
+  const host_i2c_stats_t& stats = Wire.stats;
+  cost.transactions = stats.transactions;
+  cost.bytes = stats.starts + stats.bytes_written + stats.bytes_read;
+  // 9 clocks per byte (8 data + ACK), plus one per START and per STOP
+  cost.bits = 9 * cost.bytes + stats.starts + stats.transactions;
+  cost.resets = sim.register_resets;
+
+  bq.detachInterruptPin();
+  Wire.detach(BQ25798_DEFAULT_ADDR);
+  return cost;
+}
+
+/*!
+ * @brief Bus time for a cost at a given SCL rate
+ * @param cost Measured cost
+ * @param hz SCL frequency
+ * @return Microseconds, rounded up
+ */
+static uint32_t benchMicros(const bench_cost_t& cost, uint32_t hz) {
+  return (uint32_t)(((uint64_t)cost.bits * 1000000 + hz - 1) / hz);
+}
+
+/*!
+ * @brief Print the human-readable table
+ */
+static void benchPrint() {
+  printf("%-30s %5s %5s %7s %7s %7s | %5s %5s %7s  %s\n", "method", "txn",
+         "bytes", "100k us", "400k us", "1M us", "c.txn", "c.byt",
+         "c.400k", "notes");
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    bench_cost_t raw = benchRun(bench_entries[i], false);
+    bench_cost_t cached = benchRun(bench_entries[i], true);
+    printf("%-30s %5u %5u %7u %7u %7u | %5u %5u %7u  %s\n",
+           bench_entries[i].name, raw.transactions, raw.bytes,
+           benchMicros(raw, 100000), benchMicros(raw, 400000),
+           benchMicros(raw, 1000000), cached.transactions, cached.bytes,
+           benchMicros(cached, 400000), raw.resets ? "REG_RST" : "");
+  }
+}
+
+/*!
+ * @brief Print a baseline for --check
+ */
+static void benchCSV() {
+  printf("method,transactions,bytes,cached_transactions,cached_bytes\n");
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    bench_cost_t raw = benchRun(bench_entries[i], false);
+    bench_cost_t cached = benchRun(bench_entries[i], true);
+    printf("%s,%u,%u,%u,%u\n", bench_entries[i].name, raw.transactions,
+           raw.bytes, cached.transactions, cached.bytes);
+  }
+}
+
+/*!
+ * @brief Compare every method against a baseline
+ * @param path Baseline written by --csv
+ * @return Number of methods that got more expensive
+ */
+static int benchCheck(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    printf("cannot open %s\n", path);
+    return 1;
+  }
+
+  char line[128];
+  int failures = 0;
+  bool seen[BENCH_COUNT] = {false};
+
+  while (fgets(line, sizeof(line), file)) {
+    char name[64];
+    bench_cost_t raw, cached;
+    if (sscanf(line, "%63[^,],%u,%u,%u,%u", name, &raw.transactions,
+               &raw.bytes, &cached.transactions, &cached.bytes) != 5) {
+      continue; // header
+    }
+
+    size_t i = 0;
+    while (i < BENCH_COUNT && strcmp(bench_entries[i].name, name) != 0) {
+      i++;
+    }
+    if (i == BENCH_COUNT) {
+      printf("note: %s is in the baseline but no longer benchmarked\n", name);
+      continue;
+    }
+    seen[i] = true;
+
+    bench_cost_t now_raw = benchRun(bench_entries[i], false);
+    bench_cost_t now_cached = benchRun(bench_entries[i], true);
+    if (now_raw.transactions > raw.transactions ||
+        now_raw.bytes > raw.bytes ||
+        now_cached.transactions > cached.transactions ||
+        now_cached.bytes > cached.bytes) {
+      printf("FAIL %s: %u txn / %u bytes (cached %u / %u), baseline %u / %u "
+             "(cached %u / %u)\n",
+             name, now_raw.transactions, now_raw.bytes,
+             now_cached.transactions, now_cached.bytes, raw.transactions,
+             raw.bytes, cached.transactions, cached.bytes);
+      failures++;
+    }
+  }
+  fclose(file);
+
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    if (!seen[i]) {
+      printf("note: %s has no baseline, regenerate with --csv\n",
+             bench_entries[i].name);
+    }
+  }
+
+  printf("%d of %u methods regressed\n", failures, (unsigned)BENCH_COUNT);
+  return failures;
+}
+
+/*!
+ * @brief Entry point
+ * @param argc Argument count
+ * @param argv Arguments, see the file comment
+ * @return 0 on success
+ */
+int main(int argc, char** argv) {
+  if (argc > 2 && strcmp(argv[1], "--check") == 0) {
+    return benchCheck(argv[2]) ? 1 : 0;
+  }
+  if (argc > 1 && strcmp(argv[1], "--csv") == 0) {
+    benchCSV();
+    return 0;
+  }
+
+  benchPrint();
+  return 0;
+}
@@ -0,0 +1,125 @@
+/*!
+ * @file host_test.h
+ *
+ * Tiny test harness for the host build. Each test file defines its cases
+ * with HOST_TEST() and ends with HOST_TEST_MAIN().
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#ifndef __HOST_TEST_H__
+#define __HOST_TEST_H__
+
+#include <stdio.h>
+
+#include "Adafruit_BQ25798.h"
+#include "BQ25798_Sim.h"
+
+#define HOST_TEST_MAX 64 ///< Test cases per file
+
+/*!
+ * @brief One registered test case
+ */
+typedef struct {
+  const char* name; ///< Case name
+  void (*fn)();     ///< Case body
+} host_test_case_t;
+
+static host_test_case_t host_tests[HOST_TEST_MAX]; ///< Registered cases
+static int host_test_count = 0;                    ///< Number of cases
+static int host_test_failures = 0;                 ///< Failed checks
+
+/*!
+ * @brief Registers a test case from a static initializer
+ */
+struct host_test_registrar {
+  /*!
+   * @brief Register a case
+   * @param name Case name
+   * @param fn Case body
+   */
+  host_test_registrar(const char* name, void (*fn)()) {
+    if (host_test_count < HOST_TEST_MAX) {
+      host_tests[host_test_count].name = name;
+      host_tests[host_test_count].fn = fn;
+      host_test_count++;
+    }
+  }
+};
+
+/*!
+ * @brief Define a test case
+ */
+#define HOST_TEST(name)                                     \
+  static void name();                                       \
+  static host_test_registrar name##_registrar(#name, name); \
+  static void name()
+
+/*!
+ * @brief Check a condition, report and count a failure if false
+ */
+#define HOST_CHECK(cond)                                                \
+  do {                                                                  \
+    if (!(cond)) {                                                      \
+      printf("  %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      host_test_failures++;                                             \
+    }                                                                   \
+  } while (0)
+
+/*!
+ * @brief Check that two integers are equal, printing both on failure
+ */
+#define HOST_CHECK_EQ(a, b)                                        \
+  do {                                                             \
+    long long _a = (long long)(a);                                 \
+    long long _b = (long long)(b);                                 \
+    if (_a != _b) {                                                \
+      printf("  %s:%d: %s == %s failed: %lld != %lld\n", __FILE__, \
+             __LINE__, #a, #b, _a, _b);                            \
+      host_test_failures++;                                        \
+    }                                                              \
+  } while (0)
+
+/*!
+ * @brief Run every registered case; the exit code is the failure count
+ */
+#define HOST_TEST_MAIN()                                                \
+  int main() {                                                          \
+    for (int i = 0; i < host_test_count; i++) {                         \
+      int before = host_test_failures;                                  \
+      host_tests[i].fn();                                               \
+      printf("%s %s\n", host_test_failures == before ? "PASS" : "FAIL", \
+             host_tests[i].name);                                       \
+    }                                                                   \
+    return host_test_failures ? 1 : 0;                                  \
+  }
+
+/*!
+ * @brief A simulated charger on a fresh bus, with a driver attached
+ */
+struct host_fixture {
+  BQ25798_Sim sim;     ///< Simulated chip
+  Adafruit_BQ25798 bq; ///< Driver under test
+  bool begun;          ///< begin() succeeded
+
+  /*!
+   * @brief Attach the simulated chip to Wire and start the driver
+   * @param cache Enable the register cache before begin()
+   */
+  host_fixture(bool cache = false) {
+    Wire.attach(BQ25798_DEFAULT_ADDR, &sim);
+    bq.setCacheEnable(cache);
+    begun = bq.begin();
+    Wire.clearStats();
+    sim.clearCounters();
+  }
+
+  /*!
+   * @brief Take the simulated chip off the bus
+   */
+  ~host_fixture() {
+    Wire.detach(BQ25798_DEFAULT_ADDR);
+  }
+};
+
+#endif // __HOST_TEST_H__
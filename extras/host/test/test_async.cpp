@@ -0,0 +1,278 @@
+/*!
+ * @file test_async.cpp
+ *
+ * Non-blocking requests: one transfer per poll(), completion callbacks, and
+ * backends that finish transfers from an interrupt.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Async.h"
+#include "host_test.h"
+
+/*!
+ * @brief Transport that, like a DMA driver, only moves data once the test
+ * says the transfer has finished
+ */
+class DeferredBus : public Adafruit_BQ25798_I2CBus {
+ public:
+  bq25798_xfer_state_t state;  ///< Progress of the last transfer
+  bool pending_read;           ///< The transfer in flight is a read
+  uint8_t reg;                 ///< Register of the transfer in flight
+  uint8_t* read_buffer;        ///< Destination of a pending read
+  const uint8_t* write_buffer; ///< Source of a pending write
+  uint8_t len;                 ///< Length of the transfer in flight
+  uint32_t started;            ///< Transfers started
+
+  /*!
+   * @brief Start with nothing in flight
+   */
+  DeferredBus()
+      : state(BQ25798_XFER_DONE),
+        pending_read(false),
+        reg(0),
+        read_buffer(NULL),
+        write_buffer(NULL),
+        len(0),
+        started(0) {}
+
+  /*!
+   * @brief Record a read for complete() to run
+   * @param reg First register address
+   * @param buffer Destination buffer
+   * @param len Number of bytes
+   * @return True
+   */
+  bool startRead(uint8_t reg, uint8_t* buffer, uint8_t len) override {
+    this->reg = reg;
+    this->len = len;
+    read_buffer = buffer;
+    pending_read = true;
+    state = BQ25798_XFER_BUSY;
+    started++;
+    return true;
+  }
+
+  /*!
+   * @brief Record a write for complete() to run
+   * @param reg First register address
+   * @param buffer Source buffer
+   * @param len Number of bytes
+   * @return True
+   */
+  bool startWrite(uint8_t reg, const uint8_t* buffer, uint8_t len) override {
+    this->reg = reg;
+    this->len = len;
+    write_buffer = buffer;
+    pending_read = false;
+    state = BQ25798_XFER_BUSY;
+    started++;
+    return true;
+  }
+
+  /*!
+   * @brief Report the progress set by the start calls and complete()
+   * @return Transfer state
+   */
+  bq25798_xfer_state_t transferState() override {
+    return state;
+  }
+
+  /*!
+   * @brief Run the pending transfer, as the completion interrupt would
+   */
+  void complete() {
+    bool ok = pending_read ? readRegisters(reg, read_buffer, len)
+                           : writeRegisters(reg, write_buffer, len);
+    state = ok ? BQ25798_XFER_DONE : BQ25798_XFER_ERROR;
+  }
+};
+
+static int callback_calls = 0;    ///< Times recordResult() ran
+static bool callback_ok = false;  ///< Last result passed to recordResult()
+static void* callback_ctx = NULL; ///< Last context passed to recordResult()
+
+/*!
+ * @brief Completion callback that records its arguments
+ * @param ok Request result
+ * @param context Submitted context
+ */
+static void recordResult(bool ok, void* context) {
+  callback_calls++;
+  callback_ok = ok;
+  callback_ctx = context;
+}
+
+HOST_TEST(submit_does_not_touch_the_bus) {
+  host_fixture f;
+  Adafruit_BQ25798_Async async(&f.bq);
+  bq25798_status_t status;
+
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_IDLE);
+  HOST_CHECK(async.requestStatus(&status));
+  HOST_CHECK(async.busy());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+
+  // One transfer per poll, then the result
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_BUSY);
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_DONE);
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK(!async.busy());
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_IDLE);
+}
+
+HOST_TEST(status_matches_blocking_read) {
+  host_fixture f;
+  Adafruit_BQ25798_Async async(&f.bq);
+  bq25798_status_t status;
+
+  f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, 0x80); // Taper charge
+  f.sim.poke(BQ25798_REG_FAULT_STATUS_0, 0x40);   // VBUS OVP
+  HOST_CHECK(async.requestStatus(&status));
+  while (async.poll() == BQ25798_ASYNC_BUSY) {
+  }
+
+  HOST_CHECK_EQ(status.chg_stat, BQ25798_CHG_STAT_TAPER);
+  HOST_CHECK(status.vbus_ovp);
+  HOST_CHECK(!status.vbat_ovp);
+}
+
+HOST_TEST(max_burst_splits_adc_read) {
+  host_fixture f;
+  Adafruit_BQ25798_Async async(&f.bq);
+  bq25798_adc_snapshot_t snapshot;
+
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3700);
+  f.sim.pokeWord(BQ25798_REG_DMINUS_ADC, 600);
+  async.setMaxBurst(9);
+  HOST_CHECK_EQ(async.getMaxBurst(), 8);
+  HOST_CHECK(async.requestADC(&snapshot));
+
+  int polls = 0;
+  while (async.poll() == BQ25798_ASYNC_BUSY) {
+    polls++;
+    HOST_CHECK(Wire.stats.bytes_read <= 8 * (uint32_t)polls);
+  }
+  HOST_CHECK_EQ(polls, 3);
+  HOST_CHECK_EQ(Wire.stats.transactions, 3);
+  HOST_CHECK_EQ(snapshot.vbat_mV, 3700);
+  HOST_CHECK_EQ(snapshot.dm_mV, 600);
+}
+
+HOST_TEST(field_writes_match_set_fields) {
+  host_fixture f;
+  Adafruit_BQ25798_Async async(&f.bq);
+  static const bq25798_field_t fields[] = {BQ25798_FIELD_VREG,
+                                           BQ25798_FIELD_IINDPM};
+  static const uint16_t values[] = {8400, 1500};
+  int token = 0;
+
+  HOST_CHECK(async.requestFields(fields, values, 2, recordResult, &token));
+  while (async.poll() == BQ25798_ASYNC_BUSY) {
+  }
+
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 8400);
+  HOST_CHECK_EQ(f.bq.getInputLimit_mA(), 1500);
+  HOST_CHECK_EQ(callback_calls, 1);
+  HOST_CHECK(callback_ok);
+  HOST_CHECK(callback_ctx == &token);
+}
+
+HOST_TEST(cached_field_write_skips_the_read) {
+  host_fixture f(true);
+  Adafruit_BQ25798_Async async(&f.bq);
+  static const bq25798_field_t fields[] = {BQ25798_FIELD_CELL};
+  static const uint16_t values[] = {BQ25798_CELL_COUNT_2S};
+
+  HOST_CHECK(async.requestFields(fields, values, 1));
+  while (async.poll() == BQ25798_ASYNC_BUSY) {
+  }
+
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(Wire.stats.bytes_read, 0);
+  HOST_CHECK_EQ(f.bq.getCellCount(), BQ25798_CELL_COUNT_2S);
+}
+
+HOST_TEST(bad_requests_are_refused) {
+  host_fixture f;
+  Adafruit_BQ25798_Async async(&f.bq);
+  bq25798_status_t status;
+  static const bq25798_field_t fields[] = {BQ25798_FIELD_VREG};
+  static const uint16_t values[] = {20000};
+
+  HOST_CHECK(!async.requestFields(fields, values, 1));
+  HOST_CHECK(!async.busy());
+
+  HOST_CHECK(async.requestStatus(&status));
+  HOST_CHECK(!async.requestStatus(&status));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST(bus_errors_finish_the_request) {
+  host_fixture f;
+  Adafruit_BQ25798_Async async(&f.bq);
+  bq25798_adc_snapshot_t snapshot;
+
+  callback_calls = 0;
+  f.sim.setNack(true);
+  HOST_CHECK(async.requestADC(&snapshot, recordResult));
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_ERROR);
+  HOST_CHECK_EQ(callback_calls, 1);
+  HOST_CHECK(!callback_ok);
+  HOST_CHECK(!async.busy());
+}
+
+HOST_TEST(deferred_transfers_wait_for_completion) {
+  BQ25798_Sim sim;
+  DeferredBus bus;
+  Adafruit_BQ25798 bq;
+  Adafruit_BQ25798_Async async(&bq);
+  bq25798_adc_snapshot_t snapshot;
+
+  Wire.attach(BQ25798_DEFAULT_ADDR, &sim);
+  HOST_CHECK(bus.begin());
+  HOST_CHECK(bq.begin(&bus));
+  sim.pokeWord(BQ25798_REG_VBUS_ADC, 5000);
+  Wire.clearStats();
+
+  HOST_CHECK(async.requestADC(&snapshot));
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_BUSY);
+  HOST_CHECK_EQ(bus.started, 1);
+
+  // Nothing moves until the completion interrupt
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_BUSY);
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_BUSY);
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+
+  bus.complete();
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_DONE);
+  HOST_CHECK_EQ(snapshot.vbus_mV, 5000);
+  HOST_CHECK_EQ(bus.started, 1);
+
+  Wire.detach(BQ25798_DEFAULT_ADDR);
+}
+
+HOST_TEST(callback_can_chain_the_next_request) {
+  host_fixture f;
+  static Adafruit_BQ25798_Async* chained = NULL;
+  static bq25798_adc_snapshot_t snapshot;
+  Adafruit_BQ25798_Async async(&f.bq);
+  bq25798_status_t status;
+
+  chained = &async;
+  HOST_CHECK(async.requestStatus(&status, [](bool ok, void*) {
+    if (ok) {
+      chained->requestADC(&snapshot);
+    }
+  }));
+
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_BUSY);
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_DONE);
+  HOST_CHECK(async.busy());
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_BUSY);
+  HOST_CHECK_EQ(async.poll(), BQ25798_ASYNC_DONE);
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+}
+
+HOST_TEST_MAIN()
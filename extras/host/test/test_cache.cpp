@@ -0,0 +1,63 @@
+/*!
+ * @file test_cache.cpp
+ *
+ * Register cache: which calls reach the bus, and staying in sync.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+HOST_TEST(cached_getters_skip_the_bus) {
+  host_fixture f(true);
+
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+  HOST_CHECK_EQ(f.bq.getCellCount(), BQ25798_CELL_COUNT_1S);
+  HOST_CHECK(f.bq.getChargeEnable());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST(cached_setters_are_a_single_write) {
+  host_fixture f(true);
+
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK(f.bq.setTerminationEnable(false));
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+  HOST_CHECK_EQ(f.sim.peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 840);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 8400);
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+}
+
+HOST_TEST(volatile_registers_still_read_the_chip) {
+  host_fixture f(true);
+
+  // ICO and input detection rewrite VINDPM behind the driver's back
+  f.sim.poke(BQ25798_REG_INPUT_VOLTAGE_LIMIT, 50);
+  HOST_CHECK_EQ(f.bq.getInputLimit_mV(), 5000);
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+}
+
+HOST_TEST(vindpm_detection_is_not_restarted) {
+  host_fixture f(true);
+
+  HOST_CHECK(f.bq.setVINDPMdetection(true));
+  HOST_CHECK_EQ(f.sim.vindpm_detections, 1);
+
+  // The chip clears the command once detection is done
+  HOST_CHECK(!f.bq.getVINDPMdetection());
+  HOST_CHECK(f.bq.setStatPinEnable(false));
+  HOST_CHECK(f.bq.setPWMFrequency(BQ25798_PWM_FREQ_750KHZ));
+  HOST_CHECK_EQ(f.sim.vindpm_detections, 1);
+}
+
+HOST_TEST(reset_refreshes_the_cache) {
+  host_fixture f(true);
+
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK(f.bq.reset());
+  Wire.clearStats();
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST_MAIN()
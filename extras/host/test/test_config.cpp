@@ -0,0 +1,121 @@
+/*!
+ * @file test_config.cpp
+ *
+ * Saved configurations: blob layout, integrity checks, and restoring with
+ * one read and at most one write.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+/*!
+ * @brief Program a few settings spread over the saved registers
+ * @param bq Charger to program
+ * @return True if every setter succeeded
+ */
+static bool configure(Adafruit_BQ25798& bq) {
+  return bq.setChargeLimit_mV(8400) &&
+         bq.setCellCount(BQ25798_CELL_COUNT_2S) &&
+         bq.setWDT(BQ25798_WDT_DISABLE) && bq.setTSIgnore(true);
+}
+
+HOST_TEST(save_is_one_burst_with_version_and_crc) {
+  host_fixture f;
+  uint8_t blob[BQ25798_CONFIG_SIZE];
+
+  HOST_CHECK(configure(f.bq));
+  Wire.clearStats();
+
+  HOST_CHECK(f.bq.saveConfig(blob));
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(blob[0], BQ25798_CONFIG_VERSION);
+  HOST_CHECK_EQ(blob[1 + BQ25798_REG_CHARGE_VOLTAGE_LIMIT], 840 >> 8);
+  HOST_CHECK_EQ(blob[2 + BQ25798_REG_CHARGE_VOLTAGE_LIMIT], 840 & 0xFF);
+}
+
+HOST_TEST(load_restores_after_reset_in_one_write) {
+  host_fixture f;
+  uint8_t blob[BQ25798_CONFIG_SIZE];
+
+  HOST_CHECK(configure(f.bq));
+  HOST_CHECK(f.bq.saveConfig(blob));
+  HOST_CHECK(f.bq.reset());
+  HOST_CHECK(!f.bq.verifyConfig(blob));
+  Wire.clearStats();
+  f.sim.clearCounters();
+
+  HOST_CHECK(f.bq.loadConfig(blob));
+  HOST_CHECK_EQ(Wire.stats.transactions, 2); // one read, one write
+  HOST_CHECK_EQ(f.sim.register_resets, 0);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 8400);
+  HOST_CHECK_EQ(f.bq.getCellCount(), BQ25798_CELL_COUNT_2S);
+  HOST_CHECK_EQ(f.bq.getWDT(), BQ25798_WDT_DISABLE);
+  HOST_CHECK(f.bq.getTSIgnore());
+  HOST_CHECK(f.bq.verifyConfig(blob));
+}
+
+HOST_TEST(load_of_matching_config_is_one_read) {
+  host_fixture f;
+  uint8_t blob[BQ25798_CONFIG_SIZE];
+
+  HOST_CHECK(configure(f.bq));
+  HOST_CHECK(f.bq.saveConfig(blob));
+  Wire.clearStats();
+
+  HOST_CHECK(f.bq.loadConfig(blob));
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(Wire.stats.bytes_read, BQ25798_CONFIG_REGS);
+}
+
+HOST_TEST(corrupt_or_foreign_blobs_are_rejected) {
+  host_fixture f;
+  uint8_t blob[BQ25798_CONFIG_SIZE];
+
+  HOST_CHECK(f.bq.saveConfig(blob));
+  Wire.clearStats();
+
+  blob[5] ^= 0x01;
+  HOST_CHECK(!f.bq.loadConfig(blob));
+  HOST_CHECK(!f.bq.verifyConfig(blob));
+  blob[5] ^= 0x01;
+  blob[0] = BQ25798_CONFIG_VERSION + 1;
+  HOST_CHECK(!f.bq.loadConfig(blob));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST(commands_and_modes_are_not_restored) {
+  host_fixture f;
+  uint8_t blob[BQ25798_CONFIG_SIZE];
+
+  HOST_CHECK(f.bq.setHIZMode(true));
+  HOST_CHECK(f.bq.saveConfig(blob));
+  HOST_CHECK_EQ(blob[1 + BQ25798_REG_CHARGER_CONTROL_0] & 0x04, 0);
+
+  // The live HIZ setting survives a load in either direction
+  HOST_CHECK(f.bq.loadConfig(blob));
+  HOST_CHECK(f.bq.getHIZMode());
+  HOST_CHECK(f.bq.setHIZMode(false));
+  HOST_CHECK(f.bq.loadConfig(blob));
+  HOST_CHECK(!f.bq.getHIZMode());
+}
+
+HOST_TEST(running_vindpm_detection_is_not_saved) {
+  host_fixture f;
+  uint8_t blob[BQ25798_CONFIG_SIZE];
+
+  // Saved while VINDPM detection is still running
+  uint8_t control_4 = f.sim.peek(BQ25798_REG_CHARGER_CONTROL_4);
+  f.sim.poke(BQ25798_REG_CHARGER_CONTROL_4, control_4 | 0x02);
+  HOST_CHECK(f.bq.saveConfig(blob));
+  HOST_CHECK_EQ(blob[1 + BQ25798_REG_CHARGER_CONTROL_4] & 0x02, 0);
+
+  HOST_CHECK(f.bq.reset());
+  HOST_CHECK(f.bq.setStatPinEnable(false));
+  f.sim.clearCounters();
+  HOST_CHECK(f.bq.loadConfig(blob));
+  HOST_CHECK(f.bq.getStatPinEnable());
+  HOST_CHECK_EQ(f.sim.vindpm_detections, 0);
+}
+
+HOST_TEST_MAIN()
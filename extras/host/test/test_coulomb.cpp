@@ -0,0 +1,114 @@
+/*!
+ * @file test_coulomb.cpp
+ *
+ * Coulomb counter: integrating IBAT into charge in and out, and learning
+ * the ADC offset while the battery is idle.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_CoulombCounter.h"
+#include "host_test.h"
+
+/*!
+ * @brief Set the simulated IBAT reading and take samples a second apart
+ * @param f Fixture with the simulated charger
+ * @param counter Counter under test
+ * @param ibat_mA Battery current to report
+ * @param seconds Samples to take
+ * @return True if every update() succeeded
+ */
+static bool run_seconds(host_fixture& f,
+                        Adafruit_BQ25798_CoulombCounter& counter,
+                        int16_t ibat_mA, uint16_t seconds) {
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)ibat_mA);
+  for (uint16_t n = 0; n < seconds; n++) {
+    hostAdvanceMicros(1000000UL);
+    if (!counter.update()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HOST_TEST(update_is_two_short_reads) {
+  host_fixture f;
+  Adafruit_BQ25798_CoulombCounter counter(&f.bq);
+  Adafruit_BQ25798_CoulombCounter detached;
+
+  HOST_CHECK(counter.update());
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+  HOST_CHECK(!detached.update());
+}
+
+HOST_TEST(counts_charge_in) {
+  host_fixture f;
+  Adafruit_BQ25798_CoulombCounter counter(&f.bq);
+
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, 1800);
+  HOST_CHECK(counter.update());
+  HOST_CHECK(run_seconds(f, counter, 1800, 3600));
+  HOST_CHECK_EQ(counter.getNet_uAh(), 1800000);
+  HOST_CHECK_EQ(counter.getChargeOut_mAh(), 0.0f);
+  HOST_CHECK(counter.getChargeIn_mAh() > 1799.9f);
+  HOST_CHECK(counter.getChargeIn_mAh() < 1800.1f);
+  HOST_CHECK_EQ(counter.getCurrent_mA(), 1800);
+}
+
+HOST_TEST(counts_charge_out) {
+  host_fixture f;
+  Adafruit_BQ25798_CoulombCounter counter(&f.bq);
+
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, 1000);
+  HOST_CHECK(counter.update());
+  HOST_CHECK(run_seconds(f, counter, 1000, 360));
+  HOST_CHECK(run_seconds(f, counter, -500, 1440));
+
+  // 360250 mA s in, including half the second of the step, 719500 out
+  HOST_CHECK_EQ(counter.getNet_uAh(), -99791);
+  HOST_CHECK(counter.getChargeOut_mAh() > 199.7f);
+  HOST_CHECK(counter.getChargeOut_mAh() < 200.0f);
+  HOST_CHECK(counter.getNet_mAh() < 0.0f);
+
+  counter.clear();
+  HOST_CHECK_EQ(counter.getNet_uAh(), 0);
+}
+
+HOST_TEST(termination_learns_the_offset) {
+  host_fixture f;
+  Adafruit_BQ25798_CoulombCounter counter(&f.bq);
+
+  f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, BQ25798_CHG_STAT_DONE << 5);
+  HOST_CHECK(run_seconds(f, counter, 12, 60));
+  HOST_CHECK_EQ(counter.getOffset_mA(), 12);
+  HOST_CHECK_EQ(counter.getNet_uAh(), 0);
+  HOST_CHECK_EQ(counter.getCurrent_mA(), 0);
+
+  // Back to discharging: the offset comes off every reading
+  f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, 0);
+  HOST_CHECK(run_seconds(f, counter, 12 - 360, 1));
+  counter.clear();
+  HOST_CHECK(run_seconds(f, counter, 12 - 360, 100));
+  HOST_CHECK_EQ(counter.getNet_uAh(), -10000);
+}
+
+HOST_TEST(rest_with_real_current_is_counted) {
+  host_fixture f;
+  Adafruit_BQ25798_CoulombCounter counter(&f.bq);
+
+  counter.setOffset_mA(-4);
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)-364);
+  HOST_CHECK(counter.update(true));
+  HOST_CHECK_EQ(counter.getOffset_mA(), -4);
+  HOST_CHECK_EQ(counter.getCurrent_mA(), -360);
+}
+
+HOST_TEST(samples_span_a_micros_wrap) {
+  Adafruit_BQ25798_CoulombCounter counter;
+
+  counter.addSample(720, 0xFFFFFFFFUL - 2499999UL);
+  counter.addSample(720, 2500000UL);
+  HOST_CHECK_EQ(counter.getNet_uAh(), 1000);
+}
+
+HOST_TEST_MAIN()
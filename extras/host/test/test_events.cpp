@@ -0,0 +1,123 @@
+/*!
+ * @file test_events.cpp
+ *
+ * INT pin events: the flag registers are read in one burst per interrupt
+ * and latched until taken, and the mask registers are written in one.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+#define TEST_INT_PIN 2 ///< Simulated pin wired to the charger INT output
+
+/*!
+ * @brief Check that exactly one burst covering the flag registers was read
+ * @param f Fixture with the simulated charger
+ * @return True if 0x22-0x27 were each read once and nothing else was
+ */
+static bool one_flag_burst(host_fixture& f) {
+  for (uint8_t reg = 0; reg < BQ25798_SIM_REGS; reg++) {
+    bool flag = reg >= BQ25798_REG_CHARGER_FLAG_0 &&
+                reg < BQ25798_REG_CHARGER_FLAG_0 + BQ25798_FLAG_BLOCK_SIZE;
+    if (f.sim.reg_reads[reg] != (flag ? 1U : 0U)) {
+      return false;
+    }
+  }
+  return Wire.stats.transactions == 1;
+}
+
+HOST_TEST(interrupt_reads_flags_in_one_burst) {
+  host_fixture f;
+
+  // Nothing pending, so no bus traffic
+  HOST_CHECK(f.bq.updateEvents());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+
+  // Attaching picks up anything flagged before the ISR was there
+  HOST_CHECK(f.bq.attachInterruptPin(TEST_INT_PIN));
+  HOST_CHECK(f.bq.interruptPending());
+  HOST_CHECK(f.bq.updateEvents());
+  HOST_CHECK(one_flag_burst(f));
+  HOST_CHECK(!f.bq.interruptPending());
+
+  f.sim.raiseFlags(BQ25798_REG_CHARGER_FLAG_1, 0x80); // CHG_FLAG
+  f.sim.raiseFlags(BQ25798_REG_FAULT_FLAG_1, 0x04);   // TSHUT_FLAG
+  HOST_CHECK(hostFireInterrupt(digitalPinToInterrupt(TEST_INT_PIN)));
+  HOST_CHECK(f.bq.interruptPending());
+  Wire.clearStats();
+  f.sim.clearCounters();
+  HOST_CHECK(f.bq.updateEvents());
+  HOST_CHECK(one_flag_burst(f));
+  HOST_CHECK_EQ(f.bq.takeEvents(), BQ25798_EVENT_CHG | BQ25798_EVENT_TSHUT);
+
+  f.bq.detachInterruptPin();
+  HOST_CHECK(!hostFireInterrupt(digitalPinToInterrupt(TEST_INT_PIN)));
+}
+
+HOST_TEST(events_latch_until_taken) {
+  host_fixture f;
+
+  f.sim.raiseFlags(BQ25798_REG_CHARGER_FLAG_0, 0x01); // VBUS_PRESENT_FLAG
+  HOST_CHECK(f.bq.updateEvents(true));
+  f.sim.raiseFlags(BQ25798_REG_CHARGER_FLAG_2, 0x20); // ADC_DONE_FLAG
+  HOST_CHECK(f.bq.updateEvents(true));
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+
+  // The chip has cleared its flags, the driver still holds both events
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_CHARGER_FLAG_0), 0);
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_CHARGER_FLAG_2), 0);
+  HOST_CHECK_EQ(f.bq.takeEvents(BQ25798_EVENT_ADC_DONE),
+                BQ25798_EVENT_ADC_DONE);
+  HOST_CHECK_EQ(f.bq.takeEvents(BQ25798_EVENT_ADC_DONE), 0);
+  HOST_CHECK_EQ(f.bq.takeEvents(), BQ25798_EVENT_VBUS_PRESENT);
+  HOST_CHECK_EQ(f.bq.takeEvents(), 0);
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+}
+
+HOST_TEST(failed_read_keeps_the_interrupt) {
+  host_fixture f;
+
+  f.sim.raiseFlags(BQ25798_REG_FAULT_FLAG_0, 0x01); // VAC1_OVP_FLAG
+  f.bq.handleInterrupt();
+  f.sim.setNack(true);
+  HOST_CHECK(!f.bq.updateEvents());
+  HOST_CHECK(f.bq.interruptPending());
+  HOST_CHECK_EQ(f.bq.takeEvents(), 0);
+
+  f.sim.setNack(false);
+  HOST_CHECK(f.bq.updateEvents());
+  HOST_CHECK(!f.bq.interruptPending());
+  HOST_CHECK_EQ(f.bq.takeEvents(), BQ25798_EVENT_VAC1_OVP);
+}
+
+HOST_TEST(mask_is_one_burst_write) {
+  host_fixture f;
+  const uint64_t mask = BQ25798_EVENT_VBUS_PRESENT | BQ25798_EVENT_CHG |
+                        BQ25798_EVENT_ADC_DONE | BQ25798_EVENT_TSHUT |
+                        BQ25798_EVENT_VSYS_SHORT;
+
+  // Undefined bits (11 and 13 here) are never written
+  HOST_CHECK(f.bq.setEventMask(mask | (1ULL << 11) | (1ULL << 13)));
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(Wire.stats.bytes_written, 1 + BQ25798_FLAG_BLOCK_SIZE);
+  for (uint8_t i = 0; i < BQ25798_FLAG_BLOCK_SIZE; i++) {
+    uint8_t reg = BQ25798_REG_CHARGER_MASK_0 + i;
+    HOST_CHECK_EQ(f.sim.reg_writes[reg], 1);
+    HOST_CHECK_EQ(f.sim.peek(reg), (uint8_t)(mask >> (8 * i)));
+  }
+
+  Wire.clearStats();
+  HOST_CHECK_EQ(f.bq.getEventMask(), mask);
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+
+  // Masked events still latch and are reported when polled
+  f.sim.raiseFlags(BQ25798_REG_CHARGER_FLAG_1, 0x80); // CHG_FLAG
+  HOST_CHECK(f.bq.updateEvents(true));
+  HOST_CHECK_EQ(f.bq.takeEvents(), BQ25798_EVENT_CHG);
+
+  HOST_CHECK(f.bq.setEventMask(0));
+  HOST_CHECK_EQ(f.bq.getEventMask(), 0);
+}
+
+HOST_TEST_MAIN()
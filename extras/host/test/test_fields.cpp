@@ -0,0 +1,103 @@
+/*!
+ * @file test_fields.cpp
+ *
+ * Field descriptor engine: scaling, range checks, and bulk transfers.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+HOST_TEST(set_field_scales_and_checks_range) {
+  host_fixture f;
+
+  HOST_CHECK(!f.bq.setChargeLimit_mV(2990));
+  HOST_CHECK(!f.bq.setChargeLimit_mV(18810));
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK_EQ(f.sim.peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 840);
+
+  HOST_CHECK(f.bq.setMinSystem_mV(6000));
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_MINIMAL_SYSTEM_VOLTAGE), 14);
+  HOST_CHECK_EQ(f.bq.getField(BQ25798_FIELD_VSYSMIN), 6000);
+  HOST_CHECK_EQ(f.bq.readField(BQ25798_FIELD_VSYSMIN), 14);
+}
+
+HOST_TEST(float_api_rounds_to_integer_path) {
+  host_fixture f;
+
+  HOST_CHECK(f.bq.setChargeLimitV(4.35f));
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4350);
+  HOST_CHECK(f.bq.getChargeLimitV() > 4.349f);
+  HOST_CHECK(f.bq.getChargeLimitV() < 4.351f);
+}
+
+HOST_TEST(write_field_rejects_oversized_code) {
+  host_fixture f;
+
+  HOST_CHECK(!f.bq.writeField(BQ25798_FIELD_CELL, 4));
+  HOST_CHECK(f.bq.writeField(BQ25798_FIELD_CELL, 3));
+  HOST_CHECK_EQ(f.bq.getCellCount(), BQ25798_CELL_COUNT_4S);
+  HOST_CHECK(!f.bq.writeField(BQ25798_FIELD_COUNT, 0));
+}
+
+HOST_TEST(set_fields_shares_register_writes) {
+  host_fixture f;
+  const bq25798_field_t fields[] = {BQ25798_FIELD_EN_HIZ,
+                                    BQ25798_FIELD_EN_TERM};
+  const uint16_t values[] = {1, 0};
+
+  HOST_CHECK(f.bq.setFields(fields, values, 2));
+  HOST_CHECK_EQ(Wire.stats.transactions, 2); // one read, one write
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_0], 1);
+  HOST_CHECK(f.bq.getHIZMode());
+  HOST_CHECK(!f.bq.getTerminationEnable());
+}
+
+HOST_TEST(set_fields_skips_untouched_registers) {
+  host_fixture f;
+  const bq25798_field_t fields[] = {BQ25798_FIELD_IINDPM,
+                                    BQ25798_FIELD_VSYSMIN};
+  const uint16_t values[] = {1500, 3750};
+
+  HOST_CHECK(f.bq.setFields(fields, values, 2));
+  HOST_CHECK_EQ(Wire.stats.transactions, 3); // one read, two write runs
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_INPUT_VOLTAGE_LIMIT], 0);
+  HOST_CHECK_EQ(f.bq.getInputLimit_mA(), 1500);
+  HOST_CHECK_EQ(f.bq.getMinSystem_mV(), 3750);
+}
+
+HOST_TEST(set_fields_checks_every_value_first) {
+  host_fixture f;
+  const bq25798_field_t fields[] = {BQ25798_FIELD_VREG, BQ25798_FIELD_ICHG};
+  const uint16_t values[] = {8400, 9000};
+
+  HOST_CHECK(!f.bq.setFields(fields, values, 2));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+}
+
+HOST_TEST(get_fields_is_one_burst) {
+  host_fixture f;
+  const bq25798_field_t fields[] = {BQ25798_FIELD_ICHG, BQ25798_FIELD_VREG,
+                                    BQ25798_FIELD_ITERM, BQ25798_FIELD_CELL};
+  uint16_t values[4];
+
+  HOST_CHECK(f.bq.getFields(fields, values, 4));
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(values[0], 1000);
+  HOST_CHECK_EQ(values[1], 4200);
+  HOST_CHECK_EQ(values[2], 200);
+  HOST_CHECK_EQ(values[3], BQ25798_CELL_COUNT_1S);
+}
+
+HOST_TEST(get_fields_rejects_wide_span) {
+  host_fixture f;
+  const bq25798_field_t fields[] = {BQ25798_FIELD_VSYSMIN,
+                                    BQ25798_FIELD_PART_INFO};
+  uint16_t values[2];
+
+  HOST_CHECK(!f.bq.getFields(fields, values, 2));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST_MAIN()
@@ -0,0 +1,206 @@
+/*!
+ * @file test_group.cpp
+ *
+ * Charger groups: routing through TCA9548A switches, batching polls per
+ * channel, and aggregated readings.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Group.h"
+#include "TCA9548A_Sim.h"
+#include "host_test.h"
+
+/*!
+ * @brief Four chargers behind one switch: two on channel 0, one each on
+ * channels 3 and 5, added out of channel order
+ */
+struct mux_fixture {
+  TCA9548A_Sim mux;             ///< Switch at the default address
+  BQ25798_Sim sims[4];          ///< Chargers, in add() order
+  Adafruit_BQ25798_Group group; ///< Group under test
+
+  /*!
+   * @brief Wire up the switch and add the chargers to the group
+   */
+  mux_fixture() {
+    static const int8_t channels[] = {3, 0, 5, 0};
+
+    Wire.attach(BQ25798_MUX_DEFAULT_ADDR, &mux);
+    for (uint8_t i = 0; i < 4; i++) {
+      // Two chargers on one channel need different addresses
+      uint8_t addr = BQ25798_DEFAULT_ADDR - (i == 3);
+      mux.attach(channels[i], addr, &sims[i]);
+      group.add(addr, &Wire, channels[i]);
+      sims[i].pokeWord(BQ25798_REG_VBAT_ADC, 3600 + 100 * i);
+      sims[i].pokeWord(BQ25798_REG_IBAT_ADC, 500);
+    }
+    Wire.clearStats();
+  }
+
+  /*!
+   * @brief Take the switch off the bus
+   */
+  ~mux_fixture() {
+    Wire.detach(BQ25798_MUX_DEFAULT_ADDR);
+  }
+};
+
+HOST_TEST(begin_reaches_each_charger_once) {
+  mux_fixture f;
+
+  HOST_CHECK_EQ(f.group.count(), 4);
+  HOST_CHECK(f.group.begin());
+  for (uint8_t i = 0; i < 4; i++) {
+    HOST_CHECK_EQ(f.sims[i].register_resets, 1);
+    HOST_CHECK(f.group.isOnline(i));
+  }
+  HOST_CHECK_EQ(Wire.stats.collisions, 0);
+}
+
+HOST_TEST(warm_begin_keeps_each_charger) {
+  mux_fixture f;
+
+  f.sims[2].pokeWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT, 840);
+  HOST_CHECK(f.group.begin(false));
+  for (uint8_t i = 0; i < 4; i++) {
+    HOST_CHECK_EQ(f.sims[i].register_resets, 0);
+  }
+  HOST_CHECK_EQ(f.group.select(2)->getChargeLimit_mV(), 8400);
+}
+
+HOST_TEST(update_switches_once_per_channel) {
+  mux_fixture f;
+  HOST_CHECK(f.group.begin());
+
+  uint32_t before = f.group.getMuxSwitches();
+  HOST_CHECK(f.group.update());
+  HOST_CHECK_EQ(f.group.getMuxSwitches() - before, 3);
+  HOST_CHECK_EQ(f.mux.writes, f.group.getMuxSwitches());
+
+  for (uint8_t i = 0; i < 4; i++) {
+    bq25798_adc_snapshot_t adc;
+    HOST_CHECK(f.group.getADC(i, adc));
+    HOST_CHECK_EQ(adc.vbat_mV, 3600 + 100 * i);
+  }
+}
+
+HOST_TEST(poll_takes_one_channel_at_a_time) {
+  mux_fixture f;
+  HOST_CHECK(f.group.begin());
+
+  HOST_CHECK_EQ(f.group.poll(), 2); // Channel 0
+  HOST_CHECK_EQ(f.mux.control, 1 << 0);
+  HOST_CHECK_EQ(f.group.poll(), 1); // Channel 3
+  HOST_CHECK_EQ(f.mux.control, 1 << 3);
+  HOST_CHECK_EQ(f.group.poll(), 1); // Channel 5
+  HOST_CHECK_EQ(f.mux.control, 1 << 5);
+  HOST_CHECK_EQ(f.group.poll(), 2); // Around again
+}
+
+HOST_TEST(select_routes_direct_calls) {
+  mux_fixture f;
+  HOST_CHECK(f.group.begin());
+
+  Adafruit_BQ25798* bq = f.group.select(2);
+  HOST_CHECK(bq != NULL);
+  HOST_CHECK(bq->setChargeLimit_mV(8400));
+  HOST_CHECK_EQ(f.sims[2].peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 840);
+  HOST_CHECK_EQ(f.sims[0].peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 420);
+  HOST_CHECK(f.group.select(4) == NULL);
+}
+
+HOST_TEST(summary_combines_online_chargers) {
+  mux_fixture f;
+  bq25798_group_summary_t summary;
+
+  HOST_CHECK(!f.group.getSummary(summary));
+  HOST_CHECK(f.group.begin());
+  f.sims[1].poke(BQ25798_REG_FAULT_STATUS_1, 0x80); // VSYS short
+  f.sims[3].setNack(true);
+  HOST_CHECK(!f.group.update());
+
+  HOST_CHECK(f.group.getSummary(summary));
+  HOST_CHECK_EQ(summary.online, 3);
+  HOST_CHECK_EQ(summary.offline_mask, 1 << 3);
+  HOST_CHECK_EQ(summary.faulted, 1);
+  HOST_CHECK_EQ(summary.fault_mask, 1 << 1);
+  HOST_CHECK_EQ(summary.ibat_mA, 1500);
+  HOST_CHECK_EQ(summary.vbat_min_mV, 3600);
+  HOST_CHECK_EQ(summary.vbat_max_mV, 3800);
+}
+
+HOST_TEST(glitching_charger_is_not_reset_again) {
+  mux_fixture f;
+  HOST_CHECK(f.group.begin());
+
+  f.sims[0].setNack(true);
+  HOST_CHECK(!f.group.update());
+  HOST_CHECK(!f.group.isOnline(0));
+
+  f.sims[0].setNack(false);
+  HOST_CHECK(f.group.update());
+  HOST_CHECK(f.group.isOnline(0));
+  HOST_CHECK_EQ(f.sims[0].register_resets, 1);
+}
+
+HOST_TEST(late_charger_is_started_on_its_turn) {
+  mux_fixture f;
+
+  f.sims[2].setNack(true);
+  HOST_CHECK(!f.group.begin());
+  HOST_CHECK(!f.group.isOnline(2));
+
+  f.sims[2].setNack(false);
+  HOST_CHECK(f.group.update());
+  HOST_CHECK_EQ(f.sims[2].register_resets, 1);
+}
+
+HOST_TEST(direct_and_second_mux_chargers_never_collide) {
+  mux_fixture f;
+  TCA9548A_Sim mux2;
+  BQ25798_Sim direct;
+  BQ25798_Sim behind2;
+
+  // A charger straight on the bus, and one on a second switch
+  Wire.attach(0x6C, &direct);
+  Wire.attach(BQ25798_MUX_DEFAULT_ADDR + 1, &mux2);
+  mux2.attach(0, BQ25798_DEFAULT_ADDR, &behind2);
+  HOST_CHECK_EQ(f.group.add(0x6C), 4);
+  HOST_CHECK_EQ(f.group.add(BQ25798_DEFAULT_ADDR, &Wire, 0,
+                            BQ25798_MUX_DEFAULT_ADDR + 1),
+                5);
+
+  HOST_CHECK(f.group.begin());
+  HOST_CHECK(f.group.update());
+  HOST_CHECK(f.group.update());
+  HOST_CHECK_EQ(Wire.stats.collisions, 0);
+  HOST_CHECK_EQ(direct.register_resets, 1);
+  HOST_CHECK_EQ(behind2.register_resets, 1);
+
+  Wire.detach(0x6C);
+  Wire.detach(BQ25798_MUX_DEFAULT_ADDR + 1);
+}
+
+HOST_TEST(chargers_on_separate_buses) {
+  TwoWire bus2;
+  BQ25798_Sim a;
+  BQ25798_Sim b;
+  Adafruit_BQ25798_Group group;
+
+  Wire.attach(BQ25798_DEFAULT_ADDR, &a);
+  bus2.attach(BQ25798_DEFAULT_ADDR, &b);
+  HOST_CHECK_EQ(group.add(), 0);
+  HOST_CHECK_EQ(group.add(BQ25798_DEFAULT_ADDR, &bus2), 1);
+  HOST_CHECK_EQ(group.add(BQ25798_DEFAULT_ADDR, &Wire, 8), -1);
+
+  HOST_CHECK(group.begin());
+  HOST_CHECK_EQ(group.poll(), 1);
+  HOST_CHECK_EQ(group.poll(), 1);
+  HOST_CHECK_EQ(group.getMuxSwitches(), 0);
+  HOST_CHECK_EQ(b.register_resets, 1);
+
+  Wire.detach(BQ25798_DEFAULT_ADDR);
+}
+
+HOST_TEST_MAIN()
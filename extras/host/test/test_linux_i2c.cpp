@@ -0,0 +1,211 @@
+/*!
+ * @file test_linux_i2c.cpp
+ *
+ * Linux i2c-dev transport: one I2C_RDWR ioctl per register burst, against
+ * a stand-in for the kernel adapter driver.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include <errno.h>
+#include <linux/i2c-dev.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Adafruit_BQ25798_LinuxI2C.h"
+#include "host_test.h"
+
+/*!
+ * @brief i2c-dev transport whose ioctls are served by a simulated chip
+ */
+class FakeLinuxI2C : public Adafruit_BQ25798_LinuxI2C {
+ public:
+  BQ25798_Sim sim;    ///< Chip on the adapter
+  uint32_t funcs;     ///< I2C_FUNCS answer
+  uint32_t transfers; ///< I2C_RDWR calls
+  uint32_t messages;  ///< Messages across all transfers
+  uint32_t max_read;  ///< Longest read message
+  uint8_t addressed;  ///< Address of the last message
+  int interrupts;     ///< EINTR failures still to return
+  bool fail;          ///< Fail every transfer with EREMOTEIO
+
+  /*!
+   * @brief Start with a full-featured adapter and clean counters
+   */
+  FakeLinuxI2C()
+      : funcs(I2C_FUNC_I2C),
+        transfers(0),
+        messages(0),
+        max_read(0),
+        addressed(0),
+        interrupts(0),
+        fail(false) {}
+
+ protected:
+  /*!
+   * @brief Answer I2C_FUNCS, and run I2C_RDWR messages against the sim
+   * @param request ioctl request code
+   * @param arg Request argument
+   * @return Messages transferred, or -1 with errno set
+   */
+  int ioctl(unsigned long request, void* arg) override {
+    if (request == I2C_FUNCS) {
+      *(unsigned long*)arg = funcs;
+      return 0;
+    }
+    if (request != I2C_RDWR) {
+      errno = ENOTTY;
+      return -1;
+    }
+    if (interrupts > 0) {
+      interrupts--;
+      errno = EINTR;
+      return -1;
+    }
+    if (fail) {
+      errno = EREMOTEIO;
+      return -1;
+    }
+
+    struct i2c_rdwr_ioctl_data* data = (struct i2c_rdwr_ioctl_data*)arg;
+    transfers++;
+    for (uint32_t i = 0; i < data->nmsgs; i++) {
+      struct i2c_msg& msg = data->msgs[i];
+      messages++;
+      addressed = msg.addr;
+      if (msg.flags & I2C_M_RD) {
+        max_read = msg.len > max_read ? msg.len : max_read;
+        sim.i2cRead(msg.buf, msg.len);
+      } else {
+        sim.i2cWrite(msg.buf, msg.len);
+      }
+    }
+    return data->nmsgs;
+  }
+};
+
+/*!
+ * @brief An empty regular file standing in for /dev/i2c-N
+ */
+struct fake_device_file {
+  char path[32]; ///< File name
+
+  /*!
+   * @brief Create the file
+   */
+  fake_device_file() {
+    strcpy(path, "/tmp/bq25798-i2c-XXXXXX");
+    close(mkstemp(path));
+  }
+
+  /*!
+   * @brief Remove the file
+   */
+  ~fake_device_file() {
+    unlink(path);
+  }
+};
+
+HOST_TEST(begin_fails_on_missing_adapter) {
+  Adafruit_BQ25798_LinuxI2C bus;
+
+  HOST_CHECK(!bus.begin("/dev/i2c-does-not-exist"));
+  HOST_CHECK_EQ(bus.getErrno(), ENOENT);
+}
+
+HOST_TEST(begin_rejects_a_file_that_is_not_an_adapter) {
+  fake_device_file file;
+  Adafruit_BQ25798_LinuxI2C bus;
+
+  // The real ioctl() refuses I2C_FUNCS on a regular file
+  HOST_CHECK(!bus.begin(file.path));
+  HOST_CHECK_EQ(bus.getErrno(), ENOTTY);
+}
+
+HOST_TEST(begin_rejects_smbus_only_adapter) {
+  fake_device_file file;
+  FakeLinuxI2C bus;
+
+  bus.funcs = I2C_FUNC_SMBUS_BYTE_DATA;
+  HOST_CHECK(!bus.begin(file.path));
+  HOST_CHECK_EQ(bus.getErrno(), EOPNOTSUPP);
+}
+
+HOST_TEST(driver_runs_over_i2c_dev) {
+  fake_device_file file;
+  FakeLinuxI2C bus;
+  Adafruit_BQ25798 bq;
+
+  HOST_CHECK(bus.begin(file.path, 0x6A));
+  HOST_CHECK(bq.begin(&bus));
+  HOST_CHECK_EQ(bus.sim.register_resets, 1);
+  HOST_CHECK_EQ(bus.addressed, 0x6A);
+
+  HOST_CHECK(bq.setChargeLimit_mV(8400));
+  HOST_CHECK_EQ(bus.sim.peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 840);
+  HOST_CHECK_EQ(bq.getChargeLimit_mV(), 8400);
+
+  // Nothing goes through the Arduino Wire stand-in
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST(bursts_are_one_ioctl) {
+  fake_device_file file;
+  FakeLinuxI2C bus;
+  Adafruit_BQ25798 bq;
+  bq25798_adc_snapshot_t snapshot;
+
+  HOST_CHECK(bus.begin(file.path));
+  HOST_CHECK(bq.begin(&bus));
+
+  bus.transfers = 0;
+  bus.messages = 0;
+  HOST_CHECK(bq.readAllADC(snapshot));
+  HOST_CHECK_EQ(bus.transfers, 1);
+  HOST_CHECK_EQ(bus.messages, 2);
+  HOST_CHECK_EQ(bus.max_read, 22); // IBUS_ADC through DMINUS_ADC
+
+  bus.transfers = 0;
+  HOST_CHECK(bq.setCacheEnable(true));
+  HOST_CHECK_EQ(bus.transfers, 1);
+  HOST_CHECK_EQ(bus.max_read, BQ25798_SHADOW_SIZE);
+
+  bus.transfers = 0;
+  bus.messages = 0;
+  HOST_CHECK(bq.setTerminationEnable(false));
+  HOST_CHECK_EQ(bus.transfers, 1);
+  HOST_CHECK_EQ(bus.messages, 1);
+}
+
+HOST_TEST(interrupted_ioctl_is_retried) {
+  fake_device_file file;
+  FakeLinuxI2C bus;
+  Adafruit_BQ25798 bq;
+
+  HOST_CHECK(bus.begin(file.path));
+  HOST_CHECK(bq.begin(&bus));
+
+  bus.interrupts = 2;
+  HOST_CHECK_EQ(bq.getChargeLimit_mV(), 4200);
+  HOST_CHECK_EQ(bus.getErrno(), 0);
+}
+
+HOST_TEST(transfer_errors_reach_the_caller) {
+  fake_device_file file;
+  FakeLinuxI2C bus;
+  Adafruit_BQ25798 bq;
+
+  HOST_CHECK(bus.begin(file.path));
+  HOST_CHECK(bq.begin(&bus));
+
+  bus.fail = true;
+  HOST_CHECK(!bq.setChargeLimit_mV(8400));
+  HOST_CHECK_EQ(bus.getErrno(), EREMOTEIO);
+
+  bus.fail = false;
+  bus.end();
+  HOST_CHECK(!bq.setChargeLimit_mV(8400));
+  HOST_CHECK_EQ(bus.getErrno(), EBADF);
+}
+
+HOST_TEST_MAIN()
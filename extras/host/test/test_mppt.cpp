@@ -0,0 +1,172 @@
+/*!
+ * @file test_mppt.cpp
+ *
+ * Firmware MPPT: climbing to a simulated panel's maximum power point and
+ * following it when the panel changes.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_MPPT.h"
+#include "host_test.h"
+
+/*!
+ * @brief A solar panel: constant current up to the knee, then falling
+ * linearly to nothing at the open-circuit voltage, so the maximum power
+ * point is the knee
+ */
+struct panel_t {
+  int32_t isc_mA;  ///< Short-circuit current
+  int32_t knee_mV; ///< Maximum power point voltage
+  int32_t voc_mV;  ///< Open-circuit voltage
+};
+
+/*!
+ * @brief Hold the simulated input at VINDPM and set IBUS from the panel
+ * @param sim Simulated charger
+ * @param panel Panel on the input
+ */
+static void panel_follow(BQ25798_Sim& sim, const panel_t& panel) {
+  int32_t v = sim.peek(BQ25798_REG_INPUT_VOLTAGE_LIMIT) * 100;
+  int32_t i = panel.isc_mA;
+
+  if (v >= panel.voc_mV) {
+    i = 0;
+  } else if (v > panel.knee_mV) {
+    i = panel.isc_mA * (panel.voc_mV - v) / (panel.voc_mV - panel.knee_mV);
+  }
+  sim.pokeWord(BQ25798_REG_VBUS_ADC, v);
+  sim.pokeWord(BQ25798_REG_IBUS_ADC, i);
+}
+
+/*!
+ * @brief Run the tracker for a number of one second steps
+ * @param f Fixture with the simulated charger
+ * @param mppt Tracker under test
+ * @param panel Panel on the input
+ * @param steps Steps to run
+ * @return True if every update() succeeded
+ */
+static bool run_steps(host_fixture& f, Adafruit_BQ25798_MPPT& mppt,
+                      const panel_t& panel, uint16_t steps) {
+  for (uint16_t n = 0; n < steps; n++) {
+    panel_follow(f.sim, panel);
+    hostAdvanceMicros(1000000UL);
+    if (!mppt.update()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HOST_TEST(begin_takes_over_from_the_chip) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+
+  HOST_CHECK(!mppt.update());
+  HOST_CHECK(f.bq.setMPPTenable(true));
+  HOST_CHECK(mppt.begin());
+  HOST_CHECK(!f.bq.getMPPTenable());
+  HOST_CHECK(f.bq.getADCEnable());
+  HOST_CHECK_EQ(mppt.getInputLimit_mV(), 3600);
+}
+
+HOST_TEST(climbs_to_the_knee_and_stays) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+  const panel_t panel = {2000, 15000, 20000};
+
+  HOST_CHECK(mppt.begin());
+  HOST_CHECK(run_steps(f, mppt, panel, 70));
+  HOST_CHECK(mppt.getInputLimit_mV() >= 14600);
+  HOST_CHECK(mppt.getInputLimit_mV() <= 15400);
+
+  // Oscillates around the peak from then on
+  for (uint8_t n = 0; n < 10; n++) {
+    HOST_CHECK(run_steps(f, mppt, panel, 1));
+    HOST_CHECK(mppt.getInputLimit_mV() >= 14600);
+    HOST_CHECK(mppt.getInputLimit_mV() <= 15400);
+  }
+  HOST_CHECK(mppt.getPower_mW() >= 27000);
+}
+
+HOST_TEST(follows_a_moving_peak) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+  const panel_t sunny = {2000, 15000, 20000};
+  const panel_t hot = {2000, 12000, 17000};
+
+  HOST_CHECK(mppt.begin());
+  HOST_CHECK(run_steps(f, mppt, sunny, 70));
+  HOST_CHECK(run_steps(f, mppt, hot, 30));
+  HOST_CHECK(mppt.getInputLimit_mV() >= 11600);
+  HOST_CHECK(mppt.getInputLimit_mV() <= 12400);
+}
+
+HOST_TEST(one_read_and_one_write_per_step) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+  const panel_t panel = {2000, 15000, 20000};
+
+  HOST_CHECK(mppt.begin());
+  panel_follow(f.sim, panel);
+  Wire.clearStats();
+
+  HOST_CHECK(mppt.update());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0); // Not due yet
+
+  hostAdvanceMicros(1000000UL);
+  HOST_CHECK(mppt.update());
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+  HOST_CHECK_EQ(Wire.stats.bytes_read, 6);
+  HOST_CHECK_EQ(mppt.getInputLimit_mV(), 3800);
+}
+
+HOST_TEST(holds_in_the_dark_and_respects_range) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+  const panel_t dark = {0, 15000, 20000};
+  const panel_t panel = {2000, 15000, 20000};
+
+  HOST_CHECK(!mppt.setRange_mV(3000, 20000));
+  HOST_CHECK(!mppt.setRange_mV(12000, 10000));
+  HOST_CHECK(mppt.setRange_mV(5000, 10000));
+  HOST_CHECK(mppt.begin());
+  HOST_CHECK_EQ(mppt.getInputLimit_mV(), 5000);
+
+  HOST_CHECK(run_steps(f, mppt, dark, 5));
+  HOST_CHECK_EQ(mppt.getInputLimit_mV(), 5000);
+
+  // The peak is above the range, so the tracker sits at the top
+  HOST_CHECK(run_steps(f, mppt, panel, 40));
+  HOST_CHECK(mppt.getInputLimit_mV() >= 9600);
+  HOST_CHECK(mppt.getInputLimit_mV() <= 10000);
+}
+
+HOST_TEST(range_is_narrowed_to_vindpm_steps) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+  const panel_t panel = {2000, 22000, 23000};
+
+  HOST_CHECK(!mppt.setRange_mV(12010, 12090));
+  HOST_CHECK(mppt.setRange_mV(3650, 20050));
+  HOST_CHECK(mppt.begin());
+  HOST_CHECK_EQ(mppt.getInputLimit_mV(), 3700);
+
+  // Climbing into the top of the range stops at a limit the chip holds
+  HOST_CHECK(run_steps(f, mppt, panel, 90));
+  HOST_CHECK(mppt.getInputLimit_mV() <= 20000);
+  HOST_CHECK_EQ(mppt.getInputLimit_mV(), f.bq.getInputLimit_mV());
+}
+
+HOST_TEST(step_rounds_to_vindpm_resolution) {
+  host_fixture f;
+  Adafruit_BQ25798_MPPT mppt(&f.bq);
+
+  mppt.setStep_mV(250);
+  HOST_CHECK_EQ(mppt.getStep_mV(), 200);
+  mppt.setStep_mV(10);
+  HOST_CHECK_EQ(mppt.getStep_mV(), 100);
+}
+
+HOST_TEST_MAIN()
@@ -0,0 +1,118 @@
+/*!
+ * @file test_predict.cpp
+ *
+ * Time-to-full and time-to-empty predictions across the charge phases.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_TimePredictor.h"
+#include "host_test.h"
+
+/*!
+ * @brief A charger with a 2000 mAh pack at 50 %, 1 A charge current and
+ * 120 mA termination, and a predictor driving its estimator
+ */
+struct predict_fixture {
+  host_fixture f;                      ///< Simulated charger
+  Adafruit_BQ25798_SOC soc;            ///< Estimator fed by the predictor
+  Adafruit_BQ25798_TimePredictor pred; ///< Predictor under test
+
+  /*!
+   * @brief Set the limits and start the estimator and predictor
+   * @param ibat_mA Battery current to report
+   * @param status Charge phase to report
+   */
+  predict_fixture(int16_t ibat_mA, bq25798_chg_stat_t status)
+      : soc(&f.bq), pred(&f.bq, &soc) {
+    f.bq.setChargeLimit_mA(1000);
+    f.bq.setTermination_mA(120);
+    f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3800);
+    f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)ibat_mA);
+    f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, status << 5);
+    soc.begin(2000);
+    pred.begin();
+    Wire.clearStats();
+  }
+};
+
+HOST_TEST(update_is_two_reads) {
+  predict_fixture p(0, BQ25798_CHG_STAT_NOT_CHARGING);
+
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), BQ25798_TIME_UNKNOWN);
+  HOST_CHECK_EQ(p.pred.getMinutesToEmpty(), BQ25798_TIME_UNKNOWN);
+}
+
+HOST_TEST(discharge_gives_time_to_empty) {
+  predict_fixture p(-500, BQ25798_CHG_STAT_NOT_CHARGING);
+
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getAverageCurrent_mA(), -500);
+  HOST_CHECK_EQ(p.pred.getMinutesToEmpty(), 120);
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), BQ25798_TIME_UNKNOWN);
+
+  // A brief load spike is averaged out
+  p.f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)-1300);
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getAverageCurrent_mA(), -600);
+  HOST_CHECK_EQ(p.pred.getMinutesToEmpty(), 100);
+}
+
+HOST_TEST(fast_charge_includes_the_taper) {
+  predict_fixture p(1000, BQ25798_CHG_STAT_FAST);
+
+  // 600 mAh at 1 A is 36 minutes, then 400 mAh tapering from 1 A to
+  // 120 mA takes another 58
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 94);
+  HOST_CHECK_EQ(p.pred.getMinutesToEmpty(), BQ25798_TIME_UNKNOWN);
+}
+
+HOST_TEST(long_taper_ratio) {
+  predict_fixture p(5000, BQ25798_CHG_STAT_FAST);
+
+  // 600 mAh at 5 A is 7.2 minutes, then tapering 400 mAh from 5 A down
+  // to 40 mA takes 23.4: ln(125) spans seven halvings
+  HOST_CHECK(p.f.bq.setTermination_mA(40));
+  HOST_CHECK(p.pred.begin());
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 31);
+}
+
+HOST_TEST(precharge_uses_the_charge_limit) {
+  predict_fixture p(100, BQ25798_CHG_STAT_PRECHARGE);
+
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 94);
+}
+
+HOST_TEST(taper_share_is_learned) {
+  predict_fixture p(600, BQ25798_CHG_STAT_FAST);
+  uint32_t now = micros();
+
+  // Held below ICHG by the input: 1000 mAh to go with 400 in the taper
+  p.pred.addSample(3800, 600, now, BQ25798_CHG_STAT_FAST);
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 140);
+
+  // Entering the taper at 50 % means half the pack goes in during CV
+  p.pred.addSample(3800, 600, now, BQ25798_CHG_STAT_TAPER);
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 201);
+  p.pred.addSample(3800, 600, now, BQ25798_CHG_STAT_FAST);
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 201);
+}
+
+HOST_TEST(done_and_topoff_are_full) {
+  predict_fixture p(0, BQ25798_CHG_STAT_TOPOFF);
+
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 0);
+
+  p.f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, BQ25798_CHG_STAT_DONE << 5);
+  HOST_CHECK(p.pred.update());
+  HOST_CHECK_EQ(p.pred.getMinutesToFull(), 0);
+  HOST_CHECK_EQ(p.soc.getSOC_x100(), 10000);
+}
+
+HOST_TEST_MAIN()
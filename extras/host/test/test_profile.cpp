@@ -0,0 +1,131 @@
+/*!
+ * @file test_profile.cpp
+ *
+ * Charge profiles: round trips, and writing only the registers that change.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+/*!
+ * @brief A 2S pack with a thermistor and slightly gentler JEITA settings
+ * @param bq Charger to read the starting point from
+ * @param profile Filled with the profile
+ * @return True if the charger's profile could be read
+ */
+static bool two_cell_profile(Adafruit_BQ25798& bq,
+                             bq25798_profile_t& profile) {
+  if (!bq.getProfile(profile)) {
+    return false;
+  }
+  profile.vsysmin_mV = 6000;
+  profile.vreg_mV = 8400;
+  profile.ichg_mA = 1500;
+  profile.iterm_mA = 120;
+  profile.cell_count = BQ25798_CELL_COUNT_2S;
+  profile.chg_timer = BQ25798_CHG_TMR_8HR;
+  profile.jeita_vset = BQ25798_JEITA_VSET_MINUS_200;
+  profile.ts_warm = BQ25798_TS_WARM_50C;
+  return true;
+}
+
+HOST_TEST(get_profile_reads_defaults_in_one_burst) {
+  host_fixture f;
+  bq25798_profile_t profile;
+
+  HOST_CHECK(f.bq.getProfile(profile));
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(profile.vreg_mV, 4200);
+  HOST_CHECK_EQ(profile.ichg_mA, 1000);
+  HOST_CHECK_EQ(profile.cell_count, BQ25798_CELL_COUNT_1S);
+  HOST_CHECK_EQ(profile.chg_timer, BQ25798_CHG_TMR_12HR);
+  HOST_CHECK_EQ(profile.jeita_vset, BQ25798_JEITA_VSET_MINUS_400);
+  HOST_CHECK_EQ(profile.jeita_isetc, BQ25798_JEITA_ISET_20_PERCENT);
+  HOST_CHECK_EQ(profile.ts_cool, BQ25798_TS_COOL_10C);
+  HOST_CHECK_EQ(profile.bhot, BQ25798_BHOT_60C);
+  HOST_CHECK(!profile.ts_ignore);
+}
+
+HOST_TEST(apply_profile_round_trips) {
+  host_fixture f;
+  bq25798_profile_t profile;
+  bq25798_profile_t readback;
+
+  HOST_CHECK(two_cell_profile(f.bq, profile));
+  HOST_CHECK(f.bq.applyProfile(profile));
+  HOST_CHECK(f.bq.getProfile(readback));
+  HOST_CHECK_EQ(readback.vsysmin_mV, 6000);
+  HOST_CHECK_EQ(readback.vreg_mV, 8400);
+  HOST_CHECK_EQ(readback.ichg_mA, 1500);
+  HOST_CHECK_EQ(readback.iterm_mA, 120);
+  HOST_CHECK_EQ(readback.vindpm_mV, profile.vindpm_mV);
+  HOST_CHECK_EQ(readback.chg_timer, BQ25798_CHG_TMR_8HR);
+  HOST_CHECK_EQ(readback.ts_cool, profile.ts_cool);
+
+  HOST_CHECK_EQ(f.sim.peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 840);
+  HOST_CHECK_EQ(f.bq.getCellCount(), BQ25798_CELL_COUNT_2S);
+  HOST_CHECK_EQ(f.bq.getJEITAWarmVoltage(), BQ25798_JEITA_VSET_MINUS_200);
+  HOST_CHECK_EQ(f.bq.getTSWarmThresh(), BQ25798_TS_WARM_50C);
+}
+
+HOST_TEST(apply_profile_writes_changed_runs_only) {
+  host_fixture f;
+  bq25798_profile_t profile;
+
+  HOST_CHECK(f.bq.getProfile(profile));
+  profile.vreg_mV = 4300; // Only the low byte of 0x01-0x02 changes
+  profile.ts_ignore = true;
+  Wire.clearStats();
+
+  HOST_CHECK(f.bq.applyProfile(profile));
+  HOST_CHECK_EQ(Wire.stats.transactions, 3); // one read, two writes
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGE_VOLTAGE_LIMIT], 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGE_VOLTAGE_LIMIT + 1], 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_NTC_CONTROL_1], 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_NTC_CONTROL_0], 0);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGE_CURRENT_LIMIT], 0);
+  HOST_CHECK(f.bq.getTSIgnore());
+}
+
+HOST_TEST(apply_profile_already_held_is_one_read) {
+  host_fixture f(true);
+  bq25798_profile_t profile;
+
+  HOST_CHECK(two_cell_profile(f.bq, profile));
+  HOST_CHECK(f.bq.applyProfile(profile));
+  Wire.clearStats();
+  f.sim.clearCounters();
+
+  HOST_CHECK(f.bq.applyProfile(profile));
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(Wire.stats.bytes_written, 1);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 8400);
+}
+
+HOST_TEST(apply_profile_checks_every_value_first) {
+  host_fixture f;
+  bq25798_profile_t profile;
+
+  HOST_CHECK(two_cell_profile(f.bq, profile));
+  profile.iterm_mA = 2000; // Above the 1000mA limit
+  Wire.clearStats();
+
+  HOST_CHECK(!f.bq.applyProfile(profile));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+}
+
+HOST_TEST(ntc_settings) {
+  host_fixture f;
+
+  HOST_CHECK_EQ(f.bq.getJEITAWarmCurrent(), BQ25798_JEITA_ISET_UNCHANGED);
+  HOST_CHECK(f.bq.setJEITACoolCurrent(BQ25798_JEITA_ISET_40_PERCENT));
+  HOST_CHECK(f.bq.setTSCoolThresh(BQ25798_TS_COOL_5C));
+  HOST_CHECK(f.bq.setOTGHotThresh(BQ25798_BHOT_DISABLE));
+  HOST_CHECK(f.bq.setOTGColdThresh(BQ25798_BCOLD_MINUS_20C));
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_NTC_CONTROL_0), 0x7C);
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_NTC_CONTROL_1), 0x1E);
+}
+
+HOST_TEST_MAIN()
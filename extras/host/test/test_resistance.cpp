@@ -0,0 +1,120 @@
+/*!
+ * @file test_resistance.cpp
+ *
+ * Internal resistance estimator: finding current steps in the sample
+ * stream, averaging per cell count, and correcting VBAT for IR drop.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Resistance.h"
+#include "Adafruit_BQ25798_SOC.h"
+#include "host_test.h"
+
+/*!
+ * @brief Set the simulated battery readings and take one sample a second
+ * after the last
+ * @param f Fixture with the simulated charger
+ * @param ir Estimator under test
+ * @param vbat_mV Battery voltage to report
+ * @param ibat_mA Battery current to report
+ * @return True if update() succeeded
+ */
+static bool sample(host_fixture& f, Adafruit_BQ25798_Resistance& ir,
+                   uint16_t vbat_mV, int16_t ibat_mA) {
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, vbat_mV);
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)ibat_mA);
+  hostAdvanceMicros(1000000UL);
+  return ir.update();
+}
+
+HOST_TEST(update_is_one_read) {
+  host_fixture f;
+  Adafruit_BQ25798_Resistance ir(&f.bq);
+  Adafruit_BQ25798_Resistance detached;
+
+  HOST_CHECK(ir.begin());
+  Wire.clearStats();
+  HOST_CHECK(ir.update());
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK(!detached.begin());
+  HOST_CHECK(!detached.update());
+}
+
+HOST_TEST(charge_current_step_gives_resistance) {
+  host_fixture f;
+  Adafruit_BQ25798_Resistance ir(&f.bq);
+
+  HOST_CHECK(f.bq.setCellCount(BQ25798_CELL_COUNT_2S));
+  HOST_CHECK(ir.begin());
+  HOST_CHECK(sample(f, ir, 7800, 1000));
+  HOST_CHECK(sample(f, ir, 7800, 1000));
+  HOST_CHECK_EQ(ir.getStepCount(BQ25798_CELL_COUNT_2S), 0);
+
+  // Raising the charge current by 1 A lifts VBAT by 120 mV
+  HOST_CHECK(sample(f, ir, 7920, 2000));
+  HOST_CHECK_EQ(ir.getStepCount(BQ25798_CELL_COUNT_2S), 1);
+  HOST_CHECK_EQ(ir.getResistance_mOhm(), 120);
+  HOST_CHECK_EQ(ir.getCellResistance_mOhm(BQ25798_CELL_COUNT_2S), 60);
+
+  // Stepping back down averages in a second reading
+  HOST_CHECK(sample(f, ir, 7820, 1000));
+  HOST_CHECK_EQ(ir.getStepCount(BQ25798_CELL_COUNT_2S), 2);
+  HOST_CHECK_EQ(ir.getResistance_mOhm(), 110);
+}
+
+HOST_TEST(unusable_steps_are_dropped) {
+  Adafruit_BQ25798_Resistance ir;
+
+  ir.addSample(3900, 1000, 0);
+  ir.addSample(3910, 1100, 1000000UL); // Too small
+  ir.addSample(3890, 2100, 2000000UL); // VBAT fell as current rose
+  ir.addSample(3990, 1100, 5000000UL); // Too long after the last sample
+  ir.addSample(1890, 100, 6000000UL);  // 2.1 ohms is not a battery
+  HOST_CHECK_EQ(ir.getStepCount(BQ25798_CELL_COUNT_1S), 0);
+
+  ir.setMinStep_mA(50);
+  HOST_CHECK_EQ(ir.getMinStep_mA(), 50);
+  ir.addSample(1895, 150, 7000000UL);
+  HOST_CHECK_EQ(ir.getStepCount(BQ25798_CELL_COUNT_1S), 1);
+  HOST_CHECK_EQ(ir.getResistance_mOhm(), 100);
+}
+
+HOST_TEST(averages_are_kept_per_cell_count) {
+  Adafruit_BQ25798_Resistance ir;
+
+  ir.setCellCount(BQ25798_CELL_COUNT_1S);
+  ir.addSample(3900, 0, 0);
+  ir.addSample(3950, 1000, 1000000UL);
+
+  // Changing the cell count keeps this sample from pairing with the last
+  ir.setCellCount(BQ25798_CELL_COUNT_3S);
+  ir.addSample(11700, 0, 2000000UL);
+  ir.addSample(11850, 1000, 3000000UL);
+
+  HOST_CHECK_EQ(ir.getCellResistance_mOhm(BQ25798_CELL_COUNT_1S), 50);
+  HOST_CHECK_EQ(ir.getCellResistance_mOhm(BQ25798_CELL_COUNT_3S), 50);
+  HOST_CHECK_EQ(ir.getResistance_mOhm(), 150);
+  HOST_CHECK_EQ(ir.getStepCount(BQ25798_CELL_COUNT_4S), 0);
+
+  HOST_CHECK_EQ(ir.compensate_mV(11850, 1000), 11700);
+  HOST_CHECK_EQ(ir.compensate_mV(11400, -2000), 11700);
+
+  ir.clear();
+  HOST_CHECK_EQ(ir.getResistance_mOhm(), 0);
+}
+
+HOST_TEST(soc_lookup_is_corrected_for_ir_drop) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq);
+
+  // 3.7 V under a 1 A load is 50 % through 100 mOhm
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3700);
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)-1000);
+  soc.setResistance_mOhm(100);
+  HOST_CHECK_EQ(soc.getResistance_mOhm(), 100);
+  HOST_CHECK(soc.begin(2000));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 5000);
+}
+
+HOST_TEST_MAIN()
@@ -0,0 +1,132 @@
+/*!
+ * @file test_sampler.cpp
+ *
+ * Streaming ADC sampler: ring buffer index wrap and full/empty limits,
+ * poll() interval gating, and overrun counting.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_Sampler.h"
+#include "host_test.h"
+
+HOST_TEST(largest_ring_buffer_survives_index_wrap) {
+  // Static, as GCC cannot see that pop() only reads items push() wrote
+  static Adafruit_BQ25798_RingBuffer<uint16_t, 128> ring;
+  uint16_t in = 0;
+  uint16_t out = 0;
+  uint16_t item = 0;
+
+  HOST_CHECK_EQ(ring.capacity(), 128);
+  HOST_CHECK(!ring.pop(item));
+
+  // Fill, then keep it full while head and tail wrap several times
+  while (ring.push(in)) {
+    in++;
+  }
+  HOST_CHECK_EQ(in, 128);
+  HOST_CHECK_EQ(ring.available(), 128);
+  for (uint16_t n = 0; n < 1000; n++) {
+    HOST_CHECK(ring.pop(item));
+    HOST_CHECK_EQ(item, out);
+    out++;
+    HOST_CHECK(ring.push(in));
+    in++;
+    HOST_CHECK(!ring.push(in));
+    HOST_CHECK_EQ(ring.available(), 128);
+  }
+
+  while (ring.pop(item)) {
+    HOST_CHECK_EQ(item, out);
+    out++;
+  }
+  HOST_CHECK_EQ(out, in);
+  HOST_CHECK_EQ(ring.available(), 0);
+}
+
+HOST_TEST(ring_buffer_limits_across_the_wrap) {
+  Adafruit_BQ25798_RingBuffer<uint8_t, 4> ring;
+  uint8_t item = 0;
+
+  // Walk both indices up to 254 so the next fill wraps head past 255
+  for (uint8_t n = 0; n < 254; n++) {
+    HOST_CHECK(ring.push(n));
+    HOST_CHECK(ring.pop(item));
+  }
+  HOST_CHECK_EQ(ring.available(), 0);
+  HOST_CHECK(!ring.pop(item));
+
+  for (uint8_t n = 0; n < 4; n++) {
+    HOST_CHECK(ring.push(10 + n));
+  }
+  HOST_CHECK_EQ(ring.available(), 4);
+  HOST_CHECK(!ring.push(99));
+
+  for (uint8_t n = 0; n < 4; n++) {
+    HOST_CHECK(ring.pop(item));
+    HOST_CHECK_EQ(item, 10 + n);
+  }
+  HOST_CHECK_EQ(ring.available(), 0);
+  HOST_CHECK(!ring.pop(item));
+}
+
+HOST_TEST(poll_waits_for_the_interval) {
+  host_fixture f;
+  Adafruit_BQ25798_Sampler<> sampler(&f.bq, 100);
+  bq25798_sample_t s = {};
+
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3700);
+  HOST_CHECK(sampler.poll()); // The first poll always samples
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  uint32_t first = millis();
+
+  HOST_CHECK(!sampler.poll());
+  hostAdvanceMicros(99000UL);
+  HOST_CHECK(!sampler.poll());
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+
+  hostAdvanceMicros(1000UL);
+  HOST_CHECK(sampler.poll());
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+  HOST_CHECK_EQ(sampler.available(), 2);
+
+  HOST_CHECK(sampler.read(s));
+  HOST_CHECK_EQ(s.timestamp, first);
+  HOST_CHECK_EQ(s.adc.vbat_mV, 3700);
+  HOST_CHECK(sampler.read(s));
+  HOST_CHECK_EQ(s.timestamp, first + 100);
+  HOST_CHECK(!sampler.read(s));
+
+  // A shorter interval applies from the last sample
+  sampler.setInterval(10);
+  HOST_CHECK_EQ(sampler.getInterval(), 10);
+  hostAdvanceMicros(10000UL);
+  HOST_CHECK(sampler.poll());
+}
+
+HOST_TEST(full_buffer_counts_overruns) {
+  host_fixture f;
+  Adafruit_BQ25798_Sampler<4> sampler(&f.bq);
+  bq25798_sample_t s = {};
+
+  for (uint8_t n = 0; n < 4; n++) {
+    HOST_CHECK(sampler.sample());
+  }
+  HOST_CHECK(!sampler.sample());
+  HOST_CHECK(!sampler.sample());
+  HOST_CHECK_EQ(sampler.getOverruns(), 2);
+  HOST_CHECK_EQ(sampler.available(), 4);
+
+  HOST_CHECK(sampler.read(s));
+  HOST_CHECK(sampler.sample());
+  HOST_CHECK_EQ(sampler.getOverruns(), 2);
+
+  // A bus error is not an overrun
+  HOST_CHECK(sampler.read(s));
+  f.sim.setNack(true);
+  HOST_CHECK(!sampler.sample());
+  HOST_CHECK_EQ(sampler.getOverruns(), 2);
+  HOST_CHECK_EQ(sampler.available(), 3);
+}
+
+HOST_TEST_MAIN()
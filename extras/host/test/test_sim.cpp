@@ -0,0 +1,152 @@
+/*!
+ * @file test_sim.cpp
+ *
+ * Simulated register file: reset values, access rules, and begin().
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+HOST_TEST(begin_finds_chip_and_resets) {
+  BQ25798_Sim sim;
+  Adafruit_BQ25798 bq;
+
+  Wire.attach(BQ25798_DEFAULT_ADDR, &sim);
+  HOST_CHECK(bq.begin());
+  HOST_CHECK_EQ(sim.register_resets, 1);
+  Wire.detach(BQ25798_DEFAULT_ADDR);
+}
+
+HOST_TEST(begin_fails_without_chip) {
+  Adafruit_BQ25798 bq;
+  HOST_CHECK(!bq.begin());
+}
+
+HOST_TEST(begin_rejects_other_part) {
+  BQ25798_Sim sim;
+  Adafruit_BQ25798 bq;
+
+  sim.poke(BQ25798_REG_PART_INFORMATION, 0x09);
+  Wire.attach(BQ25798_DEFAULT_ADDR, &sim);
+  HOST_CHECK(!bq.begin());
+  Wire.detach(BQ25798_DEFAULT_ADDR);
+}
+
+HOST_TEST(warm_begin_keeps_settings) {
+  host_fixture f;
+  Adafruit_BQ25798 restarted;
+
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK(f.bq.setCellCount(BQ25798_CELL_COUNT_2S));
+  f.sim.clearCounters();
+
+  HOST_CHECK(restarted.begin(BQ25798_DEFAULT_ADDR, &Wire, false));
+  HOST_CHECK_EQ(f.sim.register_resets, 0);
+  HOST_CHECK_EQ(restarted.getChargeLimit_mV(), 8400);
+  HOST_CHECK_EQ(restarted.getCellCount(), BQ25798_CELL_COUNT_2S);
+}
+
+HOST_TEST(warm_begin_fills_cache_with_one_burst) {
+  host_fixture f;
+  Adafruit_BQ25798 restarted;
+
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  Wire.clearStats();
+  f.sim.clearCounters();
+
+  // Presence probe, part number, then the control registers
+  restarted.setCacheEnable(true);
+  HOST_CHECK(restarted.begin(BQ25798_DEFAULT_ADDR, &Wire, false));
+  HOST_CHECK_EQ(Wire.stats.transactions, 3);
+  HOST_CHECK_EQ(Wire.stats.bytes_read, 1 + BQ25798_SHADOW_SIZE);
+  HOST_CHECK_EQ(f.sim.register_resets, 0);
+
+  Wire.clearStats();
+  HOST_CHECK_EQ(restarted.getChargeLimit_mV(), 8400);
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST(warm_begin_checks_part) {
+  BQ25798_Sim sim;
+  Adafruit_BQ25798 bq;
+
+  sim.poke(BQ25798_REG_PART_INFORMATION, 0x09);
+  Wire.attach(BQ25798_DEFAULT_ADDR, &sim);
+  HOST_CHECK(!bq.begin(BQ25798_DEFAULT_ADDR, &Wire, false));
+  Wire.detach(BQ25798_DEFAULT_ADDR);
+}
+
+HOST_TEST(reset_values) {
+  host_fixture f;
+
+  HOST_CHECK(f.begun);
+  HOST_CHECK_EQ(f.bq.getMinSystem_mV(), 3500);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mA(), 1000);
+  HOST_CHECK_EQ(f.bq.getInputLimit_mV(), 3600);
+  HOST_CHECK_EQ(f.bq.getInputLimit_mA(), 3000);
+  HOST_CHECK_EQ(f.bq.getTermination_mA(), 200);
+  HOST_CHECK_EQ(f.bq.getOTG_mV(), 5000);
+  HOST_CHECK_EQ(f.bq.getCellCount(), BQ25798_CELL_COUNT_1S);
+  HOST_CHECK_EQ(f.bq.getWDT(), BQ25798_WDT_40S);
+  HOST_CHECK_EQ(f.bq.getVINDPM_VOCpercent(), BQ25798_VOC_PCT_87_5);
+  HOST_CHECK(f.bq.getChargeEnable());
+  HOST_CHECK(!f.bq.getHIZMode());
+}
+
+HOST_TEST(reset_restores_defaults) {
+  host_fixture f;
+
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK(f.bq.setEventMask(0xFF));
+  HOST_CHECK(f.bq.reset());
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+  HOST_CHECK_EQ(f.bq.getEventMask(), 0);
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_TERMINATION_CONTROL) & 0x40, 0);
+}
+
+HOST_TEST(read_only_registers_ignore_writes) {
+  BQ25798_Sim sim;
+  const uint8_t write[] = {BQ25798_REG_PART_INFORMATION, 0x00};
+
+  HOST_CHECK(sim.i2cWrite(write, sizeof(write)));
+  HOST_CHECK_EQ(sim.peek(BQ25798_REG_PART_INFORMATION), 0x19);
+}
+
+HOST_TEST(flags_clear_on_read) {
+  host_fixture f;
+
+  f.sim.raiseFlags(BQ25798_REG_CHARGER_FLAG_1, 0x80); // CHG_FLAG
+  HOST_CHECK(f.bq.updateEvents(true));
+  HOST_CHECK_EQ(f.bq.takeEvents(), BQ25798_EVENT_CHG);
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_CHARGER_FLAG_1), 0);
+  HOST_CHECK(f.bq.updateEvents(true));
+  HOST_CHECK_EQ(f.bq.takeEvents(), 0);
+}
+
+HOST_TEST(watchdog_reset_self_clears) {
+  host_fixture f;
+
+  HOST_CHECK(f.bq.resetWDT());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_CHARGER_CONTROL_1) & 0x08, 0);
+}
+
+HOST_TEST(one_shot_adc_completes) {
+  host_fixture f;
+
+  HOST_CHECK(f.bq.startADCOneShot());
+  HOST_CHECK(f.bq.getADCDone());
+  HOST_CHECK(!f.bq.getADCEnable());
+}
+
+HOST_TEST(nack_fails_calls) {
+  host_fixture f;
+
+  f.sim.setNack(true);
+  HOST_CHECK(!f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK_EQ(Wire.stats.nacks, 1);
+}
+
+HOST_TEST_MAIN()
@@ -0,0 +1,149 @@
+/*!
+ * @file test_soc.cpp
+ *
+ * State-of-charge estimator: OCV table lookups, coulomb counting between
+ * anchors, and correction after the battery has rested.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "Adafruit_BQ25798_SOC.h"
+#include "host_test.h"
+
+/*!
+ * @brief Set the simulated battery readings and take samples a minute apart
+ * @param f Fixture with the simulated charger
+ * @param soc Estimator under test
+ * @param vbat_mV Battery voltage to report
+ * @param ibat_mA Battery current to report
+ * @param minutes Samples to take
+ * @return True if every update() succeeded
+ */
+static bool run_minutes(host_fixture& f, Adafruit_BQ25798_SOC& soc,
+                        uint16_t vbat_mV, int16_t ibat_mA, uint16_t minutes) {
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, vbat_mV);
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)ibat_mA);
+  for (uint16_t n = 0; n < minutes; n++) {
+    hostAdvanceMicros(60000000UL);
+    if (!soc.update()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HOST_TEST(ocv_tables_interpolate) {
+  HOST_CHECK_EQ(Adafruit_BQ25798_SOC::ocvToSOC_x100(BQ25798_CHEM_LIION, 3000),
+                0);
+  HOST_CHECK_EQ(Adafruit_BQ25798_SOC::ocvToSOC_x100(BQ25798_CHEM_LIION, 3785),
+                4500);
+  HOST_CHECK_EQ(Adafruit_BQ25798_SOC::ocvToSOC_x100(BQ25798_CHEM_LIION, 4190),
+                10000);
+  HOST_CHECK_EQ(Adafruit_BQ25798_SOC::ocvToSOC_x100(BQ25798_CHEM_LIHV, 4245),
+                9500);
+  HOST_CHECK_EQ(
+      Adafruit_BQ25798_SOC::ocvToSOC_x100(BQ25798_CHEM_LIFEPO4, 3100), 1500);
+  HOST_CHECK_EQ(Adafruit_BQ25798_SOC::ocvToSOC_x100((bq25798_chemistry_t)3,
+                                                    3800),
+                0);
+}
+
+HOST_TEST(begin_starts_from_ocv_per_cell) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq);
+
+  HOST_CHECK(!soc.begin(0));
+  HOST_CHECK(f.bq.setCellCount(BQ25798_CELL_COUNT_2S));
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 7600);
+  HOST_CHECK(soc.begin(2000));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 5000);
+  HOST_CHECK_EQ(soc.getSOC(), 50.0f);
+}
+
+HOST_TEST(waits_for_the_adc) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq);
+
+  HOST_CHECK(soc.begin(2000));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 0);
+  HOST_CHECK(run_minutes(f, soc, 3800, 0, 1));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 5000);
+}
+
+HOST_TEST(counts_through_load_sag) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq);
+
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3800);
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)-1000);
+  HOST_CHECK(soc.begin(2000));
+
+  // The load drags VBAT down to the 10 % point, but 6 minutes at 1 A
+  // only takes out 100 mAh
+  HOST_CHECK(run_minutes(f, soc, 3600, -1000, 6));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 4500);
+
+  // Charging pushes VBAT up. The swing to +1 A nets nothing over its
+  // minute, then 29 minutes put 483 mAh back.
+  HOST_CHECK(run_minutes(f, soc, 4100, 1000, 30));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 6916);
+}
+
+HOST_TEST(rest_pulls_back_onto_the_table) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq);
+
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3800);
+  HOST_CHECK(soc.begin(2000));
+
+  // The voltage says 60 %, but only after half an hour of rest
+  HOST_CHECK(run_minutes(f, soc, 3860, 5, 29));
+  HOST_CHECK(soc.getSOC_x100() < 5100);
+  HOST_CHECK(run_minutes(f, soc, 3860, 5, 1));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 6000);
+
+  // Any real current restarts the wait
+  soc.setRestTime(600000UL);
+  HOST_CHECK(run_minutes(f, soc, 3860, -600, 1));
+  HOST_CHECK(run_minutes(f, soc, 3800, 0, 9));
+  HOST_CHECK(soc.getSOC_x100() > 5000);
+  HOST_CHECK(run_minutes(f, soc, 3800, 0, 1));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 5000);
+}
+
+HOST_TEST(termination_means_full) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq, BQ25798_CHEM_LIFEPO4);
+
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3260);
+  HOST_CHECK(soc.begin(1000));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 5000);
+
+  f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, BQ25798_CHG_STAT_DONE << 5);
+  HOST_CHECK(run_minutes(f, soc, 3500, 0, 1));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 10000);
+
+  // Counting on from full never reads above 100 %
+  f.sim.poke(BQ25798_REG_CHARGER_STATUS_1, 0);
+  HOST_CHECK(run_minutes(f, soc, 3500, 200, 10));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 10000);
+}
+
+HOST_TEST(capacity_change_keeps_the_estimate) {
+  host_fixture f;
+  Adafruit_BQ25798_SOC soc(&f.bq);
+
+  f.sim.pokeWord(BQ25798_REG_VBAT_ADC, 3800);
+  f.sim.pokeWord(BQ25798_REG_IBAT_ADC, (uint16_t)-1000);
+  HOST_CHECK(soc.begin(2000));
+  HOST_CHECK(run_minutes(f, soc, 3800, -1000, 12));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 4000);
+
+  HOST_CHECK(!soc.setCapacity_mAh(0));
+  HOST_CHECK(soc.setCapacity_mAh(1000));
+  HOST_CHECK_EQ(soc.getCapacity_mAh(), 1000);
+  HOST_CHECK(run_minutes(f, soc, 3800, -1000, 6));
+  HOST_CHECK_EQ(soc.getSOC_x100(), 3000);
+}
+
+HOST_TEST_MAIN()
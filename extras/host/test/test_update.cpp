@@ -0,0 +1,118 @@
+/*!
+ * @file test_update.cpp
+ *
+ * Staged updates: setters between beginUpdate() and commit() cost one
+ * write per register.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+/*!
+ * @brief Eight setters, two on each of REG_CHARGER_CONTROL_0, _1, _3 and _5
+ * @param bq Charger to program
+ * @return True if every setter succeeded
+ */
+static bool stage_controls(Adafruit_BQ25798& bq) {
+  return bq.setChargeEnable(false) && bq.setTerminationEnable(false) &&
+         bq.setWDT(BQ25798_WDT_DISABLE) &&
+         bq.setVACOVP(BQ25798_VAC_OVP_12V) && bq.setOTGPFM(true) &&
+         bq.setForwardPFM(true) && bq.setIINDPMenable(false) &&
+         bq.setExtILIMpin(false);
+}
+
+HOST_TEST(commit_writes_each_register_once) {
+  host_fixture f;
+
+  f.bq.beginUpdate();
+  HOST_CHECK(stage_controls(f.bq));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(Wire.stats.transactions, 4); // one read, three writes
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_0], 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_1], 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_2], 0);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_3], 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_4], 0);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_5], 1);
+
+  HOST_CHECK(!f.bq.getChargeEnable());
+  HOST_CHECK(!f.bq.getTerminationEnable());
+  HOST_CHECK_EQ(f.bq.getWDT(), BQ25798_WDT_DISABLE);
+  HOST_CHECK_EQ(f.bq.getVACOVP(), BQ25798_VAC_OVP_12V);
+  HOST_CHECK(f.bq.getOTGPFM());
+  HOST_CHECK(!f.bq.getExtILIMpin());
+}
+
+HOST_TEST(cached_commit_is_writes_only) {
+  host_fixture f(true);
+
+  f.bq.beginUpdate();
+  HOST_CHECK(stage_controls(f.bq));
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(Wire.stats.transactions, 3);
+  HOST_CHECK(!f.bq.getChargeEnable());
+}
+
+HOST_TEST(getters_see_staged_values) {
+  host_fixture f;
+  uint8_t before = f.sim.peek(BQ25798_REG_CHARGER_CONTROL_0);
+
+  f.bq.beginUpdate();
+  HOST_CHECK(f.bq.setChargeEnable(false));
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK(!f.bq.getChargeEnable());
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 8400);
+  HOST_CHECK_EQ(f.sim.peek(BQ25798_REG_CHARGER_CONTROL_0), before);
+  HOST_CHECK_EQ(f.sim.peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 420);
+
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(f.sim.peekWord(BQ25798_REG_CHARGE_VOLTAGE_LIMIT), 840);
+}
+
+HOST_TEST(set_fields_is_staged_too) {
+  host_fixture f;
+  const bq25798_field_t fields[] = {BQ25798_FIELD_EN_HIZ,
+                                    BQ25798_FIELD_EN_TERM};
+  const uint16_t values[] = {1, 0};
+
+  f.bq.beginUpdate();
+  HOST_CHECK(f.bq.setFields(fields, values, 2));
+  HOST_CHECK(f.bq.setChargeEnable(false));
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_0], 1);
+  HOST_CHECK(f.bq.getHIZMode());
+}
+
+HOST_TEST(other_registers_write_through) {
+  host_fixture f;
+
+  f.bq.beginUpdate();
+  HOST_CHECK(f.bq.setADCEnable(true));
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+  HOST_CHECK(f.bq.getADCEnable());
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(Wire.stats.transactions, 3);
+}
+
+HOST_TEST(cancel_and_reset_drop_staged_changes) {
+  host_fixture f;
+
+  f.bq.beginUpdate();
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  f.bq.cancelUpdate();
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+
+  f.bq.beginUpdate();
+  HOST_CHECK(f.bq.setChargeLimit_mV(8400));
+  HOST_CHECK(f.bq.reset());
+  HOST_CHECK(f.bq.commit());
+  HOST_CHECK_EQ(f.bq.getChargeLimit_mV(), 4200);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGE_VOLTAGE_LIMIT], 0);
+}
+
+HOST_TEST_MAIN()
@@ -0,0 +1,109 @@
+/*!
+ * @file test_watchdog.cpp
+ *
+ * Watchdog keep-alive: service() deadlines and WD_RST riding along on
+ * writes that are happening anyway.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ */
+
+#include "host_test.h"
+
+HOST_TEST(service_waits_for_three_quarters) {
+  host_fixture f;
+
+  // begin() reset the charger, so the 40 s watchdog just restarted
+  hostAdvanceMicros(29000000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+
+  hostAdvanceMicros(1000000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+
+  hostAdvanceMicros(29000000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+}
+
+HOST_TEST(cached_service_is_one_write) {
+  host_fixture f(true);
+
+  hostAdvanceMicros(30000000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+
+  // A cached kick leaves the cache able to serve the next write
+  HOST_CHECK(f.bq.setVACOVP(BQ25798_VAC_OVP_12V));
+  HOST_CHECK_EQ(Wire.stats.transactions, 2);
+}
+
+HOST_TEST(writes_to_control_1_carry_the_kick) {
+  host_fixture f;
+
+  hostAdvanceMicros(10000000UL);
+  HOST_CHECK(f.bq.setVACOVP(BQ25798_VAC_OVP_12V));
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 0); // Not yet half way
+
+  hostAdvanceMicros(10000000UL);
+  HOST_CHECK(f.bq.setVACOVP(BQ25798_VAC_OVP_12V));
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+  HOST_CHECK_EQ(f.bq.getVACOVP(), BQ25798_VAC_OVP_12V);
+
+  // The deadline moved, so service() has nothing to do
+  hostAdvanceMicros(25000000UL);
+  Wire.clearStats();
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST(bordering_writes_grow_by_one_byte) {
+  host_fixture f(true);
+
+  hostAdvanceMicros(20000000UL);
+  HOST_CHECK(f.bq.setChargeEnable(false)); // REG_CHARGER_CONTROL_0
+  HOST_CHECK_EQ(Wire.stats.transactions, 1);
+  HOST_CHECK_EQ(Wire.stats.bytes_written, 3);
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+  HOST_CHECK_EQ(f.sim.reg_writes[BQ25798_REG_CHARGER_CONTROL_1], 1);
+  HOST_CHECK(!f.bq.getChargeEnable());
+  HOST_CHECK_EQ(f.bq.getWDT(), BQ25798_WDT_40S);
+}
+
+HOST_TEST(follows_the_watchdog_setting) {
+  host_fixture f;
+
+  HOST_CHECK(f.bq.setWDT(BQ25798_WDT_0_5S));
+  hostAdvanceMicros(300000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 0);
+  hostAdvanceMicros(100000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+
+  HOST_CHECK(f.bq.setWDT(BQ25798_WDT_DISABLE));
+  hostAdvanceMicros(200000000UL);
+  HOST_CHECK(f.bq.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+}
+
+HOST_TEST(warm_begin_kicks_on_first_service) {
+  host_fixture f;
+  Adafruit_BQ25798 restarted;
+
+  HOST_CHECK(restarted.begin(BQ25798_DEFAULT_ADDR, &Wire, false));
+  Wire.clearStats();
+
+  // Setting unknown: one read, then an immediate kick
+  HOST_CHECK(restarted.service());
+  HOST_CHECK_EQ(f.sim.watchdog_resets, 1);
+  HOST_CHECK_EQ(Wire.stats.transactions, 3);
+
+  Wire.clearStats();
+  HOST_CHECK(restarted.service());
+  HOST_CHECK_EQ(Wire.stats.transactions, 0);
+}
+
+HOST_TEST_MAIN()